@@ -1,12 +1,89 @@
+#include <arabica/trace/trace.hpp>
 #include <arabica/ui/window.hpp>
 #include <fmt/core.h>
+#include <cstdlib>
+#include <memory>
+#include <string>
 
+// usage: ./arabica.out [--turbo [multiplier]] [--smooth] [--sync-audio] [--spaced-input]
+//                      [--record movie-file] [--profile report-file] [--trace trace-file] rom-file
+//
+// `--turbo` starts in fast-forward, uncapped unless a multiplier is given. Tab toggles it at runtime.
+// The window can be resized and F11 toggles fullscreen, the screen is scaled to fit. `--smooth` rounds
+// off its diagonals with EPX. `--sync-audio` paces the emulation by the sound card rather than by the
+// host clock alone, within half a percent. Keys are applied at the start of the next frame, with
+// `--spaced-input` as far apart as they were pressed, a frame later.
+// Holding Backspace rewinds, Shift+Backspace rewinds faster. `--record` saves the keys pressed to a
+// movie on exit, `arabica-replay.out` plays it back. `--profile` writes the execution profile on exit,
+// in a build with `ARABICA_PROFILER`. `--trace` writes what the emulator logs to `trace-file` as it
+// runs, in a build with `ARABICA_LOG_LEVEL`, `arabica-trace.out` prints it.
 int main(int argc, char* argv[]) {
-  if (argc != 2) {
+  std::string rom;
+  std::string movie;
+  std::string profile;
+  std::string trace;
+  bool        is_turbo  = false;
+  bool        is_smooth = false;
+  bool        is_synced = false;
+  bool        is_spaced = false;
+  int         speed     = 0;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--turbo") {
+      is_turbo = true;
+      if (i + 1 < argc && std::atoi(argv[i + 1]) > 0) {
+        speed = std::atoi(argv[++i]);
+      }
+    } else if (arg == "--smooth") {
+      is_smooth = true;
+    } else if (arg == "--sync-audio") {
+      is_synced = true;
+    } else if (arg == "--spaced-input") {
+      is_spaced = true;
+    } else if (arg == "--record" && i + 1 < argc) {
+      movie = argv[++i];
+    } else if (arg == "--profile" && i + 1 < argc) {
+      profile = argv[++i];
+    } else if (arg == "--trace" && i + 1 < argc) {
+      trace = argv[++i];
+    } else {
+      rom = arg;
+    }
+  }
+  if (rom.empty()) {
+    fmt::print("Usage: ./arabica.out [--turbo [multiplier]] [--smooth] [--sync-audio] [--spaced-input] "
+               "[--record movie-file] [--profile report-file] [--trace trace-file] rom-file\n");
     return 1;
-    fmt::print("Usage: ./arabica.out rom-file");
   }
-  arabica::Window window("Arabica Emulator", 640, 320, argv[1]);
+  arabica::Window window("Arabica Emulator", 640, 320, rom, movie);
+  window.set_fast_forward(is_turbo, speed);
+  if (is_smooth) {
+    window.set_filter(arabica::simd::FILTER::EPX);
+  }
+  window.set_audio_sync(is_synced);
+  window.set_input_spacing(is_spaced);
+
+  arabica::Profiler profiler;
+  if (!profile.empty()) {
+    if (!arabica::Profiler::IS_COMPILED_IN) {
+      fmt::print("The profiler is compiled out, build with ARABICA_PROFILER=ON\n");
+    }
+    window.emulator.set_profiler(&profiler);
+  }
+  std::unique_ptr<arabica::trace::Writer> writer;
+  if (!trace.empty()) {
+    if (arabica::trace::LEVEL == arabica::trace::Level::OFF) {
+      fmt::print("Logging is compiled out, build with ARABICA_LOG_LEVEL\n");
+    }
+    writer = std::make_unique<arabica::trace::Writer>(trace);
+    if (!writer->is_open()) {
+      fmt::print("Failed to write {}\n", trace);
+    }
+  }
   window.execute();
+  writer.reset();
+  if (!profile.empty() && !profiler.save(profile)) {
+    fmt::print("Failed to write {}\n", profile);
+  }
   return 0;
 }
@@ -0,0 +1,44 @@
+#include <arabica/aot/program.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace arabica::aot {
+
+namespace {
+
+// function local so that registering from other translation units does not depend on their order
+std::vector<const Program*>& programs() {
+  static std::vector<const Program*> registered;
+  return registered;
+}
+
+} // namespace
+
+bool Registry::add(const Program& program) {
+  programs().push_back(&program);
+  return true;
+}
+
+void Registry::remove(const Program& program) {
+  std::vector<const Program*>& registered = programs();
+  registered.erase(std::remove(registered.begin(), registered.end(), &program), registered.end());
+}
+
+const Program* Registry::find(const Memory& memory) {
+  for (const auto* const program : programs()) {
+    if (program->rom_size > Memory::SIZE - Memory::RESERVED) {
+      continue;
+    }
+
+    bool is_same = true;
+    for (std::size_t i = 0; i < program->rom_size && is_same; ++i) {
+      is_same = memory[Memory::RESERVED + i] == program->rom[i];
+    }
+    if (is_same) {
+      return program;
+    }
+  }
+  return nullptr;
+}
+
+} // namespace arabica::aot
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <arabica/memory/memory.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace arabica {
+
+class Emulator;
+
+namespace aot {
+
+// A basic block translated ahead of time by `arabica-aot.out`, it executes `length` instructions
+// starting at `address` and leaves `cpu.pc` at the instruction that follows.
+struct Block {
+  using Function = void (*)(Emulator& emulator);
+
+  uint16_t address{0x000};
+  uint16_t length{0};
+  uint16_t size{0}; // bytes covered, from `address` on
+  Function function{nullptr};
+};
+
+// The translation of a whole rom. Generated sources define one and register it at static
+// initialization time, the emulator picks it up whenever the same rom is loaded.
+struct Program {
+  const char*    name{nullptr};
+  const uint8_t* rom{nullptr};
+  std::size_t    rom_size{0};
+  const Block*   blocks{nullptr};
+  std::size_t    block_count{0};
+};
+
+class Registry {
+public:
+  static bool add(const Program& program);
+  static void remove(const Program& program);
+
+  // the program translated from the rom currently loaded in `memory`, if any
+  static const Program* find(const Memory& memory);
+};
+
+} // namespace aot
+} // namespace arabica
@@ -0,0 +1,60 @@
+#include <arabica/aot/runtime.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace arabica::aot {
+
+Runtime::Runtime(Memory& memory)
+  : _memory(memory) {
+  _memory.attach(this);
+}
+
+Runtime::~Runtime() {
+  _memory.detach(this);
+}
+
+void Runtime::load(const Program* const program) {
+  _program = program;
+  _blocks.fill(nullptr);
+  if (_program == nullptr) {
+    return;
+  }
+  for (std::size_t i = 0; i < _program->block_count; ++i) {
+    const Block& block = _program->blocks[i];
+    if (is_intact(block)) {
+      _blocks[block.address % Memory::SIZE] = &block;
+    }
+  }
+}
+
+// Whatever follows the rom was zero when the program was translated.
+bool Runtime::is_intact(const Block& block) const {
+  if (block.size > MAX_BLOCK_SIZE || block.address < Memory::RESERVED || block.address + block.size > Memory::SIZE) {
+    return false;
+  }
+  for (uint16_t address = block.address; address < block.address + block.size; ++address) {
+    const std::size_t offset   = address - Memory::RESERVED;
+    const uint8_t     expected = offset < _program->rom_size ? _program->rom[offset] : 0x00;
+    if (std::as_const(_memory)[address] != expected) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void Runtime::on_write(const Memory::address_t address, const std::size_t size) {
+  if (_program == nullptr) {
+    return;
+  }
+
+  const int first = static_cast<int>(address) - (MAX_BLOCK_SIZE - 1);
+  const int last  = static_cast<int>(address + size);
+  for (int pc = std::max(first, 0); pc < std::min<int>(last, Memory::SIZE); ++pc) {
+    const Block* const block = _blocks[pc];
+    if (block != nullptr && block->address + block->size > address) {
+      _blocks[pc] = nullptr;
+    }
+  }
+}
+
+} // namespace arabica::aot
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <arabica/aot/program.hpp>
+#include <arabica/memory/memory.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace arabica::aot {
+
+// Looks up the ahead-of-time blocks of the loaded program by address.
+//
+// A block is only valid as long as the bytes it was translated from are in memory: blocks that do not
+// match the memory are left out on load, and the first write into a block drops it for good so that
+// the emulator interprets that code from then on.
+class Runtime : public Memory::Observer {
+public:
+  // writes are matched against the blocks starting up to this many bytes before them
+  constexpr static uint16_t MAX_BLOCK_SIZE = 64;
+
+  explicit Runtime(Memory& memory);
+  ~Runtime() override;
+
+  Runtime(const Runtime&)            = delete;
+  Runtime& operator=(const Runtime&) = delete;
+
+  void load(const Program* const program);
+
+  bool is_loaded() const {
+    return _program != nullptr;
+  }
+
+  const Block* lookup(const uint16_t pc) const {
+    return _blocks[pc % Memory::SIZE];
+  }
+
+  void on_write(const Memory::address_t address, const std::size_t size) override;
+
+private:
+  bool is_intact(const Block& block) const;
+
+  Memory&                                _memory;
+  const Program*                         _program{nullptr};
+  std::array<const Block*, Memory::SIZE> _blocks{};
+};
+
+} // namespace arabica::aot
@@ -0,0 +1,247 @@
+#include <arabica/aot/translator.hpp>
+#include <arabica/cpu/control_flow.hpp>
+#include <arabica/cpu/cpu.hpp>
+#include <fmt/core.h>
+#include <algorithm>
+#include <set>
+
+namespace arabica::aot {
+
+Translator::Translator(const std::vector<uint8_t>& rom)
+  : _rom(rom) {
+  const std::size_t size = std::min<std::size_t>(_rom.size(), Memory::SIZE - Memory::RESERVED);
+  for (std::size_t i = 0; i < size; ++i) {
+    _memory.write(Memory::RESERVED + i, _rom[i]);
+  }
+
+  const ControlFlow control_flow(_memory);
+
+  std::set<uint16_t> leaders{CPU::PC_START};
+  for (const auto pc : control_flow.addresses()) {
+    const Instruction instruction = fetch(pc);
+    if (is_terminator(instruction)) {
+      for (const auto next : ControlFlow::successors(instruction, pc)) {
+        if (control_flow.is_reachable(next)) {
+          leaders.insert(next);
+        }
+      }
+    }
+  }
+
+  std::vector<uint16_t> pending(leaders.rbegin(), leaders.rend());
+  std::set<uint16_t>    translated;
+  while (!pending.empty()) {
+    const uint16_t address = pending.back();
+    pending.pop_back();
+    if (!translated.insert(address).second) {
+      continue;
+    }
+
+    Block block;
+    block.address = address;
+    for (uint16_t pc = address;; pc += 2) {
+      ++block.length;
+      if (is_terminator(fetch(pc))) {
+        break;
+      }
+      if (!control_flow.is_reachable(pc + 2)) {
+        break;
+      }
+      if (block.length == MAX_BLOCK_LENGTH) {
+        pending.push_back(pc + 2);
+        break;
+      }
+    }
+    block.size = block.length * 2;
+    _blocks.push_back(block);
+  }
+
+  std::sort(_blocks.begin(), _blocks.end(), [](const Block& lhs, const Block& rhs) {
+    return lhs.address < rhs.address;
+  });
+}
+
+Instruction Translator::fetch(const uint16_t pc) const {
+  return decode(_memory[pc] << 8 | _memory[pc + 1]);
+}
+
+bool Translator::is_terminator(const Instruction& instruction) {
+  if (instruction.handler == HANDLER_UNKNOWN) {
+    return true;
+  }
+  switch (instruction.opcode) {
+    case OP_CODE::RET:
+    case OP_CODE::SYS_addr:
+    case OP_CODE::JP_addr:
+    case OP_CODE::CALL_addr:
+    case OP_CODE::SE_Vx_byte:
+    case OP_CODE::SNE_Vx_byte:
+    case OP_CODE::SE_Vx_Vy:
+    case OP_CODE::SNE_Vx_Vy:
+    case OP_CODE::JP_V0_addr:
+    case OP_CODE::SKP_Vx:
+    case OP_CODE::SKNP_Vx:
+    case OP_CODE::LD_Vx_K:
+    case OP_CODE::EXIT:
+    case OP_CODE::LD_B_Vx:
+    case OP_CODE::LD_I_Vx: return true;
+    default: return false;
+  }
+}
+
+std::string Translator::emit(const std::string& name) const {
+  std::string source;
+  source += fmt::format("// Generated by arabica-aot.out from {}, do not edit.\n\n", name);
+  source += "#include <arabica/aot/program.hpp>\n";
+  source += "#include <arabica/emulator/emulator.hpp>\n";
+  source += "#include <cstdint>\n";
+  source += "#include <iterator>\n";
+  source += "#include <utility>\n\n";
+  source += "namespace {\n\n";
+  source += "using arabica::CPU;\n";
+  source += "using arabica::Emulator;\n\n";
+
+  source += "constexpr uint8_t rom[] = {";
+  for (std::size_t i = 0; i < _rom.size(); ++i) {
+    source += fmt::format("{}0x{:02X},", i % 16 == 0 ? "\n  " : " ", _rom[i]);
+  }
+  source += "\n};\n\n";
+
+  for (const auto& block : _blocks) {
+    source += emit_block(block);
+  }
+
+  source += "constexpr arabica::aot::Block blocks[] = {\n";
+  for (const auto& block : _blocks) {
+    source += fmt::format("  {{0x{0:03X}, {1}, {2}, block_{0:03X}}},\n", block.address, block.length, block.size);
+  }
+  source += "};\n\n";
+
+  // the name is a file name, quoted and escaped by fmt's debug format
+  source += fmt::format("const arabica::aot::Program program{{{:?}, rom, sizeof(rom), blocks, std::size(blocks)}};\n",
+                        name);
+  source += "[[maybe_unused]] const bool is_registered = arabica::aot::Registry::add(program);\n\n";
+  source += "} // namespace\n";
+  return source;
+}
+
+std::string Translator::emit_block(const Block& block) const {
+  std::string source;
+  source += fmt::format("// 0x{:03X} - 0x{:03X}\n", block.address, block.address + block.size - 1);
+  source += fmt::format("void block_{:03X}(Emulator& emulator) {{\n", block.address);
+  source += "  [[maybe_unused]] CPU&     cpu = emulator.cpu;\n";
+  source += "  [[maybe_unused]] uint8_t* V   = cpu.registers;\n";
+
+  uint16_t pc = block.address;
+  for (int i = 0; i < block.length; ++i, pc += 2) {
+    const Instruction instruction = fetch(pc);
+    source += fmt::format("  // 0x{:03X}: {:04X} {}\n", pc, instruction.word, op_code_name(instruction.opcode));
+    source += translate(instruction, pc);
+  }
+  if (!is_terminator(fetch(pc - 2))) {
+    source += fmt::format("  cpu.pc = 0x{:03X};\n", pc);
+  }
+  source += "}\n\n";
+  return source;
+}
+
+// One or more statements with the same effect as the handler in `Emulator`, the program counter
+// is only written by the last instruction of a block.
+std::string Translator::translate(const Instruction& instruction, const uint16_t pc) {
+  const uint8_t  x    = instruction.x;
+  const uint8_t  y    = instruction.y;
+  const uint16_t next = pc + 2;
+  const uint16_t skip = pc + 4;
+
+  const auto dispatch = [&] {
+    return fmt::format("  cpu.pc = 0x{:03X};\n  emulator.dispatch(arabica::decode(0x{:04X}));\n", pc, instruction.word);
+  };
+  const auto skip_if = [&](const std::string& condition) {
+    return fmt::format("  cpu.pc = {} ? 0x{:03X} : 0x{:03X};\n", condition, skip, next);
+  };
+
+  if (instruction.handler == HANDLER_UNKNOWN) {
+    return fmt::format("  cpu.pc = 0x{:03X};\n", pc);
+  }
+
+  switch (instruction.opcode) {
+    case OP_CODE::CLS: return "  emulator.display.reset();\n  emulator.display.is_refresh = true;\n";
+    case OP_CODE::RET:
+      return fmt::format("  if (!cpu.stack.empty()) {{\n"
+                         "    cpu.pc = cpu.stack.top();\n"
+                         "    cpu.stack.pop();\n"
+                         "  }} else {{\n"
+                         "    cpu.pc = 0x{:03X};\n"
+                         "  }}\n",
+                         pc);
+    case OP_CODE::SYS_addr:
+    case OP_CODE::JP_addr: return fmt::format("  cpu.pc = 0x{:03X};\n", instruction.nnn);
+    case OP_CODE::CALL_addr:
+      return fmt::format("  cpu.stack.push(0x{:03X});\n  cpu.pc = 0x{:03X};\n", next, instruction.nnn);
+    case OP_CODE::SE_Vx_byte: return skip_if(fmt::format("V[0x{:X}] == 0x{:02X}", x, instruction.kk));
+    case OP_CODE::SNE_Vx_byte: return skip_if(fmt::format("V[0x{:X}] != 0x{:02X}", x, instruction.kk));
+    case OP_CODE::SE_Vx_Vy: return skip_if(fmt::format("V[0x{:X}] == V[0x{:X}]", x, y));
+    case OP_CODE::SNE_Vx_Vy: return skip_if(fmt::format("V[0x{:X}] != V[0x{:X}]", x, y));
+    case OP_CODE::SKP_Vx: return skip_if(fmt::format("emulator.keypad.is_keypressed(V[0x{:X}])", x));
+    case OP_CODE::SKNP_Vx: return skip_if(fmt::format("!emulator.keypad.is_keypressed(V[0x{:X}])", x));
+    case OP_CODE::LD_Vx_byte: return fmt::format("  V[0x{:X}] = 0x{:02X};\n", x, instruction.kk);
+    case OP_CODE::ADD_Vx_byte: return fmt::format("  V[0x{0:X}] = V[0x{0:X}] + 0x{1:02X};\n", x, instruction.kk);
+    case OP_CODE::LD_Vx_Vy: return fmt::format("  V[0x{:X}] = V[0x{:X}];\n", x, y);
+    case OP_CODE::OR_Vx_Vy: return fmt::format("  V[0x{:X}] |= V[0x{:X}];\n", x, y);
+    case OP_CODE::AND_Vx_Vy: return fmt::format("  V[0x{:X}] &= V[0x{:X}];\n", x, y);
+    case OP_CODE::XOR_Vx_Vy: return fmt::format("  V[0x{:X}] ^= V[0x{:X}];\n", x, y);
+    case OP_CODE::ADD_Vx_Vy:
+      return fmt::format("  {{\n"
+                         "    const uint16_t sum = V[0x{0:X}] + V[0x{1:X}];\n"
+                         "    V[0xF] = sum > 255;\n"
+                         "    V[0x{0:X}] = sum & 0xFF;\n"
+                         "  }}\n",
+                         x, y);
+    case OP_CODE::SUB_Vx_Vy:
+      return fmt::format("  V[0xF] = V[0x{0:X}] > V[0x{1:X}];\n  V[0x{0:X}] = V[0x{0:X}] - V[0x{1:X}];\n", x, y);
+    case OP_CODE::SHR_Vx: return fmt::format("  V[0xF] = V[0x{0:X}] & 1;\n  V[0x{0:X}] = V[0x{0:X}] >> 1;\n", x);
+    case OP_CODE::SUBN_Vx_Vy:
+      return fmt::format("  V[0xF] = V[0x{1:X}] > V[0x{0:X}];\n  V[0x{0:X}] = V[0x{1:X}] - V[0x{0:X}];\n", x, y);
+    case OP_CODE::SHL_Vx: return fmt::format("  V[0xF] = (V[0x{0:X}] >> 7) & 1;\n  V[0x{0:X}] = V[0x{0:X}] << 1;\n", x);
+    case OP_CODE::LD_I_addr: return fmt::format("  cpu.reg_I = 0x{:03X};\n", instruction.nnn);
+    case OP_CODE::JP_V0_addr: return fmt::format("  cpu.pc = 0x{:03X} + V[0x0];\n", instruction.nnn);
+    case OP_CODE::LD_Vx_DT: return fmt::format("  V[0x{:X}] = emulator.delay.get();\n", x);
+    case OP_CODE::LD_Vx_K:
+      return fmt::format("  if (const auto keycode = emulator.keypad.get_last_keypressed_code(); keycode != -1) {{\n"
+                         "    V[0x{:X}] = keycode;\n"
+                         "    cpu.pc = 0x{:03X};\n"
+                         "  }} else {{\n"
+                         "    cpu.pc = 0x{:03X};\n"
+                         "  }}\n",
+                         x, next, pc);
+    case OP_CODE::LD_DT_Vx: return fmt::format("  emulator.delay.set(V[0x{:X}]);\n", x);
+    case OP_CODE::ADD_I_Vx: return fmt::format("  cpu.reg_I = cpu.reg_I + V[0x{:X}];\n", x);
+    case OP_CODE::LD_F_Vx: return fmt::format("  cpu.reg_I = V[0x{:X}] * 0x5;\n", x);
+    case OP_CODE::LD_B_Vx:
+      return fmt::format("  emulator.memory[cpu.reg_I + 0] = (V[0x{0:X}] % 1000) / 100;\n"
+                         "  emulator.memory[cpu.reg_I + 1] = (V[0x{0:X}] % 100) / 10;\n"
+                         "  emulator.memory[cpu.reg_I + 2] = (V[0x{0:X}] % 10);\n"
+                         "  cpu.pc = 0x{1:03X};\n",
+                         x, next);
+    case OP_CODE::LD_I_Vx: {
+      std::string source;
+      for (int i = 0; i <= x; ++i) {
+        source += fmt::format("  emulator.memory[cpu.reg_I + {0}] = V[0x{0:X}];\n", i);
+      }
+      return source + fmt::format("  cpu.pc = 0x{:03X};\n", next);
+    }
+    case OP_CODE::LD_Vx_I: {
+      std::string source;
+      for (int i = 0; i <= x; ++i) {
+        source += fmt::format("  V[0x{0:X}] = std::as_const(emulator.memory)[cpu.reg_I + {0}];\n", i);
+      }
+      return source;
+    }
+    case OP_CODE::RND_Vx_byte:
+    case OP_CODE::DRW_Vx_Vy_nibble:
+    case OP_CODE::LD_ST_Vx:
+    default: return dispatch();
+  }
+}
+
+} // namespace arabica::aot
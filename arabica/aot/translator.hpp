@@ -0,0 +1,48 @@
+#pragma once
+
+#include <arabica/aot/program.hpp>
+#include <arabica/aot/runtime.hpp>
+#include <arabica/cpu/instruction.hpp>
+#include <arabica/memory/memory.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace arabica::aot {
+
+// Static recompiler from a rom to C++ source, one function per basic block.
+//
+// Blocks start at the entry point and at every static branch target, i.e. the targets of jumps and
+// calls, both outcomes of skips and the return address of calls. A block ends with the first
+// instruction that changes the control flow or writes memory (Fx33, Fx55), so a block never runs
+// code it has overwritten itself. `Bnnn` and `00EE` jump to wherever the registers say, the
+// emulator interprets from there on until it reaches the start of a block again.
+//
+// The generated code works on the emulator objects directly, the few instructions with
+// side effects outside of them (RND, DRW, LD ST) go through `Emulator::dispatch`.
+class Translator {
+public:
+  constexpr static uint16_t MAX_BLOCK_LENGTH = Runtime::MAX_BLOCK_SIZE / 2;
+
+  explicit Translator(const std::vector<uint8_t>& rom);
+
+  // `function` is left empty, the blocks only describe what `emit` generates
+  const std::vector<Block>& blocks() const {
+    return _blocks;
+  }
+
+  std::string emit(const std::string& name) const;
+
+private:
+  static bool        is_terminator(const Instruction& instruction);
+  static std::string translate(const Instruction& instruction, const uint16_t pc);
+
+  std::string emit_block(const Block& block) const;
+  Instruction fetch(const uint16_t pc) const;
+
+  std::vector<uint8_t> _rom;
+  Memory               _memory;
+  std::vector<Block>   _blocks;
+};
+
+} // namespace arabica::aot
@@ -0,0 +1,51 @@
+#include <arabica/cpu/control_flow.hpp>
+#include <algorithm>
+
+namespace arabica {
+
+ControlFlow::ControlFlow(const Memory& memory, const uint16_t entry) {
+  std::vector<uint16_t> pending{entry};
+  while (!pending.empty()) {
+    const uint16_t pc = pending.back();
+    pending.pop_back();
+    if (pc < Memory::RESERVED || pc + 1 >= Memory::SIZE || _reachable[pc]) {
+      continue;
+    }
+
+    _reachable[pc] = true;
+    _addresses.push_back(pc);
+
+    const Instruction instruction = decode(memory[pc] << 8 | memory[pc + 1]);
+    for (const auto next : successors(instruction, pc)) {
+      if (next != 0) {
+        pending.push_back(next);
+      }
+    }
+  }
+  std::sort(_addresses.begin(), _addresses.end());
+}
+
+std::array<uint16_t, 2> ControlFlow::successors(const Instruction& instruction, const uint16_t pc) {
+  switch (instruction.opcode) {
+    case OP_CODE::JP_addr: return {instruction.nnn, 0};
+    case OP_CODE::CALL_addr: return {instruction.nnn, static_cast<uint16_t>(pc + 2)};
+    case OP_CODE::SE_Vx_byte:
+    case OP_CODE::SNE_Vx_byte:
+    case OP_CODE::SE_Vx_Vy:
+    case OP_CODE::SNE_Vx_Vy:
+    case OP_CODE::SKP_Vx:
+    case OP_CODE::SKNP_Vx: return {static_cast<uint16_t>(pc + 2), static_cast<uint16_t>(pc + 4)};
+    case OP_CODE::RET:
+    case OP_CODE::JP_V0_addr:
+    case OP_CODE::SYS_addr:
+    case OP_CODE::EXIT: return {0, 0};
+    default: {
+      if (instruction.handler == HANDLER_UNKNOWN) {
+        return {0, 0};
+      }
+      return {static_cast<uint16_t>(pc + 2), 0};
+    }
+  }
+}
+
+} // namespace arabica
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <arabica/cpu/cpu.hpp>
+#include <arabica/cpu/instruction.hpp>
+#include <arabica/memory/memory.hpp>
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+namespace arabica {
+
+// Static control flow of a program, found by following every branch from the entry point.
+//
+// Only targets known at decode time are followed, i.e. `Bnnn` and `00EE` end a path (the return
+// address of a call is followed from the `2nnn` itself), so whatever is only reached through
+// them is not part of the result.
+class ControlFlow {
+public:
+  explicit ControlFlow(const Memory& memory, const uint16_t entry = CPU::PC_START);
+
+  bool is_reachable(const uint16_t address) const {
+    return address < Memory::SIZE && _reachable[address];
+  }
+
+  // reachable instruction addresses in ascending order
+  const std::vector<uint16_t>& addresses() const {
+    return _addresses;
+  }
+
+  // addresses the instruction at `pc` can continue at, `0` marks an unused slot
+  static std::array<uint16_t, 2> successors(const Instruction& instruction, const uint16_t pc);
+
+private:
+  std::bitset<Memory::SIZE> _reachable;
+  std::vector<uint16_t>     _addresses;
+};
+
+} // namespace arabica
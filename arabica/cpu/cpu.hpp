@@ -1,10 +1,9 @@
 #pragma once
 
 #include <arabica/cpu/op_code.hpp>
+#include <arabica/cpu/stack.hpp>
 #include <arabica/memory/memory.hpp>
-#include <SDL2/SDL.h>
 #include <cstdint>
-#include <stack>
 
 namespace arabica {
 
@@ -13,7 +12,8 @@ public:
   constexpr static uint16_t REGISTER_COUNT  = 16;
   constexpr static uint16_t PC_START        = 0x0200;
   constexpr static uint8_t  DEFAULT_RATE_HZ = 60;
-  constexpr static Uint32   DEFAULT_CPU_HZ  = 500;
+  constexpr static uint32_t DEFAULT_CPU_HZ  = 500;
+  constexpr static uint8_t  RPL_COUNT       = 8; // SUPER-CHIP flags saved by Fx75, the HP-48 kept them in RPL
 
   CPU(Memory& mem)
     : memory(mem) {
@@ -31,16 +31,17 @@ public:
     memory = mem;
   }
 
-  Uint32               clock_speed{DEFAULT_CPU_HZ};
-  uint8_t              registers[REGISTER_COUNT] = {0};
-  uint16_t             reg_I{0x0000};
-  uint8_t              reg_delay{DEFAULT_RATE_HZ};
-  uint8_t              reg_sound{DEFAULT_RATE_HZ};
-  uint16_t             pc{PC_START};
-  std::stack<uint16_t> stack;
-  uint16_t             instruction{0x0000};
-  OP_CODE              opcode{OP_CODE::CLS};
-  Memory&              memory;
+  uint32_t clock_speed{DEFAULT_CPU_HZ};
+  uint8_t  registers[REGISTER_COUNT] = {0};
+  uint8_t  rpl[RPL_COUNT]             = {0};
+  uint16_t reg_I{0x0000};
+  uint8_t  reg_delay{DEFAULT_RATE_HZ};
+  uint8_t  reg_sound{DEFAULT_RATE_HZ};
+  uint16_t pc{PC_START};
+  Stack    stack;
+  uint16_t instruction{0x0000};
+  OP_CODE  opcode{OP_CODE::CLS};
+  Memory&  memory;
 };
 
 } // namespace arabica
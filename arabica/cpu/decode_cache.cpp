@@ -0,0 +1,57 @@
+#include <arabica/cpu/decode_cache.hpp>
+#include <utility>
+
+namespace arabica {
+
+static_assert(IDLE_SPAN <= FUSION_SPAN, "writes have to drop every idle loop they touch");
+
+DecodeCache::DecodeCache(Memory& mem)
+  : _memory(mem) {
+  _memory.attach(this);
+}
+
+DecodeCache::~DecodeCache() {
+  _memory.detach(this);
+}
+
+void DecodeCache::on_write(const Memory::address_t address, const std::size_t size) {
+  if (size >= Memory::SIZE) {
+    flush();
+    return;
+  }
+
+  // every entry starting up to `FUSION_SPAN - 1` bytes before the first written byte may cover it
+  for (std::size_t i = 0; i < size + FUSION_SPAN - 1; ++i) {
+    _entries[(address - (FUSION_SPAN - 1) + i) & ADDRESS_MASK].generation = 0;
+  }
+}
+
+// Bumping the generation drops every entry at once instead of touching all of them.
+void DecodeCache::flush() {
+  if (++_generation == 0) {
+    for (auto& entry : _entries) {
+      entry.generation = 0;
+    }
+    _generation = 1;
+  }
+}
+
+void DecodeCache::set_fusion(const bool is_enable) {
+  _is_enable_fusion = is_enable;
+  flush();
+}
+
+uint16_t DecodeCache::word(const uint16_t address) const {
+  const Memory& memory = std::as_const(_memory);
+  return memory[address & ADDRESS_MASK] << 8 | memory[(address + 1) & ADDRESS_MASK];
+}
+
+void DecodeCache::refill(Entry& entry, const uint16_t pc) {
+  entry.instruction      = decode(word(pc));
+  entry.superinstruction = _is_enable_fusion ? fuse(entry.instruction.word, word(pc + 2), word(pc + 4))
+                                             : Superinstruction{};
+  entry.idle             = idle_of(pc, entry.instruction.word, word(pc + 2), word(pc + 4));
+  entry.generation       = _generation;
+}
+
+} // namespace arabica
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <arabica/cpu/fusion.hpp>
+#include <arabica/cpu/idle.hpp>
+#include <arabica/cpu/instruction.hpp>
+#include <arabica/memory/memory.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace arabica {
+
+// Pre-decoded instructions keyed by the address they are fetched from.
+//
+// An entry at `pc` is built from the bytes at `pc` and `pc + 1`, it is dropped as soon as either
+// of them is written, so self-modifying programs always execute what is currently in memory.
+// When fusion is enabled, an entry also holds the superinstruction starting at `pc`, which depends
+// on the following `FUSION_SPAN` bytes, and it always tells whether `pc` starts an idle loop.
+class DecodeCache : public Memory::Observer {
+public:
+  constexpr static uint16_t ADDRESS_MASK = Memory::SIZE - 1;
+
+  struct Entry {
+    Instruction      instruction;
+    Superinstruction superinstruction;
+    IDLE             idle{IDLE::NONE};
+    uint32_t         generation{0};
+  };
+
+  explicit DecodeCache(Memory& mem);
+  ~DecodeCache() override;
+
+  DecodeCache(const DecodeCache&)            = delete;
+  DecodeCache& operator=(const DecodeCache&) = delete;
+
+  const Entry& lookup(const uint16_t pc) {
+    Entry& entry = _entries[pc & ADDRESS_MASK];
+    if (entry.generation != _generation) {
+      refill(entry, pc & ADDRESS_MASK);
+    }
+    return entry;
+  }
+
+  const Instruction& fetch(const uint16_t pc) {
+    return lookup(pc).instruction;
+  }
+
+  void on_write(const Memory::address_t address, const std::size_t size) override;
+  void flush();
+  void set_fusion(const bool is_enable);
+
+private:
+  uint16_t word(const uint16_t address) const;
+  void     refill(Entry& entry, const uint16_t pc);
+
+  Memory&                         _memory;
+  uint32_t                        _generation{1};
+  bool                            _is_enable_fusion{true};
+  std::array<Entry, Memory::SIZE> _entries{};
+};
+
+} // namespace arabica
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <arabica/cpu/instruction.hpp>
+#include <fmt/core.h>
+#include <string>
+
+namespace arabica {
+
+// The instruction in the notation of the spec, e.g. `ADD V[1], 0x01` or `DRW V[0], V[1], 5`; a word
+// that is no instruction is shown as data, `DW 0xF0FF`.
+inline std::string disassemble(const Instruction& instruction) {
+  if (instruction.handler == HANDLER_UNKNOWN) {
+    return fmt::format("DW 0x{:04X}", instruction.word);
+  }
+  const uint8_t  x   = instruction.x;
+  const uint8_t  y   = instruction.y;
+  const uint8_t  kk  = instruction.kk;
+  const uint16_t nnn = instruction.nnn;
+  switch (instruction.opcode) {
+    case OP_CODE::CLS: return "CLS";
+    case OP_CODE::RET: return "RET";
+    case OP_CODE::SYS_addr: return fmt::format("SYS 0x{:03X}", nnn);
+    case OP_CODE::JP_addr: return fmt::format("JP 0x{:03X}", nnn);
+    case OP_CODE::CALL_addr: return fmt::format("CALL 0x{:03X}", nnn);
+    case OP_CODE::SE_Vx_byte: return fmt::format("SE V[{}], 0x{:02X}", x, kk);
+    case OP_CODE::SNE_Vx_byte: return fmt::format("SNE V[{}], 0x{:02X}", x, kk);
+    case OP_CODE::SE_Vx_Vy: return fmt::format("SE V[{}], V[{}]", x, y);
+    case OP_CODE::LD_Vx_byte: return fmt::format("LD V[{}], 0x{:02X}", x, kk);
+    case OP_CODE::ADD_Vx_byte: return fmt::format("ADD V[{}], 0x{:02X}", x, kk);
+    case OP_CODE::LD_Vx_Vy: return fmt::format("LD V[{}], V[{}]", x, y);
+    case OP_CODE::OR_Vx_Vy: return fmt::format("OR V[{}], V[{}]", x, y);
+    case OP_CODE::AND_Vx_Vy: return fmt::format("AND V[{}], V[{}]", x, y);
+    case OP_CODE::XOR_Vx_Vy: return fmt::format("XOR V[{}], V[{}]", x, y);
+    case OP_CODE::ADD_Vx_Vy: return fmt::format("ADD V[{}], V[{}]", x, y);
+    case OP_CODE::SUB_Vx_Vy: return fmt::format("SUB V[{}], V[{}]", x, y);
+    case OP_CODE::SHR_Vx: return fmt::format("SHR V[{}]", x);
+    case OP_CODE::SUBN_Vx_Vy: return fmt::format("SUBN V[{}], V[{}]", x, y);
+    case OP_CODE::SHL_Vx: return fmt::format("SHL V[{}]", x);
+    case OP_CODE::SNE_Vx_Vy: return fmt::format("SNE V[{}], V[{}]", x, y);
+    case OP_CODE::LD_I_addr: return fmt::format("LD I, 0x{:03X}", nnn);
+    case OP_CODE::JP_V0_addr: return fmt::format("JP V[0], 0x{:03X}", nnn);
+    case OP_CODE::RND_Vx_byte: return fmt::format("RND V[{}], 0x{:02X}", x, kk);
+    case OP_CODE::DRW_Vx_Vy_nibble: return fmt::format("DRW V[{}], V[{}], {}", x, y, instruction.n);
+    case OP_CODE::SKP_Vx: return fmt::format("SKP V[{}]", x);
+    case OP_CODE::SKNP_Vx: return fmt::format("SKNP V[{}]", x);
+    case OP_CODE::LD_Vx_DT: return fmt::format("LD V[{}], DT", x);
+    case OP_CODE::LD_Vx_K: return fmt::format("LD V[{}], K", x);
+    case OP_CODE::LD_DT_Vx: return fmt::format("LD DT, V[{}]", x);
+    case OP_CODE::LD_ST_Vx: return fmt::format("LD ST, V[{}]", x);
+    case OP_CODE::ADD_I_Vx: return fmt::format("ADD I, V[{}]", x);
+    case OP_CODE::LD_F_Vx: return fmt::format("LD F, V[{}]", x);
+    case OP_CODE::LD_B_Vx: return fmt::format("LD B, V[{}]", x);
+    case OP_CODE::LD_I_Vx: return fmt::format("LD [I], V[{}]", x);
+    case OP_CODE::LD_Vx_I: return fmt::format("LD V[{}], [I]", x);
+    case OP_CODE::SCD_nibble: return fmt::format("SCD {}", instruction.n);
+    case OP_CODE::SCR: return "SCR";
+    case OP_CODE::SCL: return "SCL";
+    case OP_CODE::EXIT: return "EXIT";
+    case OP_CODE::LOW: return "LOW";
+    case OP_CODE::HIGH: return "HIGH";
+    case OP_CODE::LD_HF_Vx: return fmt::format("LD HF, V[{}]", x);
+    case OP_CODE::LD_R_Vx: return fmt::format("LD R, V[{}]", x);
+    case OP_CODE::LD_Vx_R: return fmt::format("LD V[{}], R", x);
+  }
+  return fmt::format("DW 0x{:04X}", instruction.word);
+}
+
+} // namespace arabica
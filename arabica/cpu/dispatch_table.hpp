@@ -0,0 +1,49 @@
+#pragma once
+
+#include <arabica/cpu/op_code.hpp>
+#include <array>
+#include <cstdint>
+
+namespace arabica {
+
+// The handler index of each op code, in the order of `ARABICA_OP_CODE_LIST`.
+// Words which do not encode a known instruction resolve to `HANDLER_UNKNOWN`.
+#define ARABICA_OP_CODE_ENTRY(op_code, handler) OP_CODE::op_code,
+constexpr OP_CODE HANDLED_OP_CODES[] = {ARABICA_OP_CODE_LIST(ARABICA_OP_CODE_ENTRY)};
+#undef ARABICA_OP_CODE_ENTRY
+
+constexpr uint8_t HANDLER_COUNT   = sizeof(HANDLED_OP_CODES) / sizeof(HANDLED_OP_CODES[0]);
+constexpr uint8_t HANDLER_UNKNOWN = HANDLER_COUNT;
+
+// The operands x and y never take part in selecting a handler, so the prefix nibble and the low byte
+// are enough to tell every 16-bit word apart, which keeps the table at 4 KB.
+constexpr uint16_t dispatch_key(const uint16_t word) {
+  return ((word & 0xF000) >> 4) | (word & 0x00FF);
+}
+
+constexpr uint8_t handler_of(const OP_CODE opcode) {
+  for (uint8_t i = 0; i < HANDLER_COUNT; ++i) {
+    if (HANDLED_OP_CODES[i] == opcode) {
+      return i;
+    }
+  }
+  return HANDLER_UNKNOWN;
+}
+
+constexpr std::array<uint8_t, 0x1000> make_dispatch_table() {
+  std::array<uint8_t, 0x1000> table{};
+  for (uint32_t key = 0; key < table.size(); ++key) {
+    const uint16_t word = ((key & 0xF00) << 4) | (key & 0x0FF);
+    table[key]          = handler_of(decode_opcode(word));
+  }
+  return table;
+}
+
+constexpr std::array<uint8_t, 0x1000> DISPATCH_TABLE = make_dispatch_table();
+
+static_assert(DISPATCH_TABLE[dispatch_key(0x00E0)] == handler_of(OP_CODE::CLS));
+static_assert(DISPATCH_TABLE[dispatch_key(0x8AB4)] == handler_of(OP_CODE::ADD_Vx_Vy));
+static_assert(DISPATCH_TABLE[dispatch_key(0xE3A1)] == handler_of(OP_CODE::SKNP_Vx));
+static_assert(DISPATCH_TABLE[dispatch_key(0xF2FF)] == HANDLER_UNKNOWN);
+
+} // namespace arabica
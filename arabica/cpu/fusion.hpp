@@ -0,0 +1,71 @@
+#pragma once
+
+#include <arabica/cpu/op_code.hpp>
+#include <cstdint>
+
+namespace arabica {
+
+// Instruction sequences which are common enough in Chip-8 programs to be executed as one
+// superinstruction. Each of them leaves the machine exactly as the single steps would.
+enum class FUSION : uint8_t {
+  NONE,
+  LD_I_DRW,  // Annn, Dxyn         draw the sprite at nnn
+  LD_Vx_DT,  // 6xkk, Fx15         load a constant into Vx and the delay timer
+  ADD_SE_JP, // 7xkk, 3xkk, 1nnn   counter loop
+  DT_SE_JP,  // Fx07, 3xkk, 1nnn   delay timer poll
+};
+
+struct Superinstruction {
+  FUSION   kind{FUSION::NONE};
+  uint8_t  length{0}; // number of fused instructions
+  uint8_t  x{0x0};
+  uint8_t  y{0x0};
+  uint8_t  n{0x0};
+  uint8_t  kk{0x00};
+  uint8_t  compare{0x00};
+  uint16_t nnn{0x000};
+};
+
+// The longest fused sequence covers this many bytes starting at its first instruction.
+constexpr uint16_t FUSION_SPAN = 3 * 2;
+
+constexpr Superinstruction fuse(const uint16_t first, const uint16_t second, const uint16_t third) {
+  const OP_CODE op_first  = decode_opcode(first);
+  const OP_CODE op_second = decode_opcode(second);
+  const OP_CODE op_third  = decode_opcode(third);
+  const uint8_t x         = (first & 0x0F00) >> 8;
+  const bool    same_x    = x == ((second & 0x0F00) >> 8);
+
+  Superinstruction superinstruction;
+  if (op_first == OP_CODE::LD_I_addr && op_second == OP_CODE::DRW_Vx_Vy_nibble) {
+    superinstruction.kind   = FUSION::LD_I_DRW;
+    superinstruction.length = 2;
+    superinstruction.nnn    = first & 0x0FFF;
+    superinstruction.x      = (second & 0x0F00) >> 8;
+    superinstruction.y      = (second & 0x00F0) >> 4;
+    superinstruction.n      = second & 0x000F;
+  } else if (op_first == OP_CODE::LD_Vx_byte && op_second == OP_CODE::LD_DT_Vx && same_x) {
+    superinstruction.kind   = FUSION::LD_Vx_DT;
+    superinstruction.length = 2;
+    superinstruction.x      = x;
+    superinstruction.kk     = first & 0x00FF;
+  } else if (op_first == OP_CODE::ADD_Vx_byte && op_second == OP_CODE::SE_Vx_byte && same_x &&
+             op_third == OP_CODE::JP_addr) {
+    superinstruction.kind    = FUSION::ADD_SE_JP;
+    superinstruction.length  = 3;
+    superinstruction.x       = x;
+    superinstruction.kk      = first & 0x00FF;
+    superinstruction.compare = second & 0x00FF;
+    superinstruction.nnn     = third & 0x0FFF;
+  } else if (op_first == OP_CODE::LD_Vx_DT && op_second == OP_CODE::SE_Vx_byte && same_x &&
+             op_third == OP_CODE::JP_addr) {
+    superinstruction.kind    = FUSION::DT_SE_JP;
+    superinstruction.length  = 3;
+    superinstruction.x       = x;
+    superinstruction.compare = second & 0x00FF;
+    superinstruction.nnn     = third & 0x0FFF;
+  }
+  return superinstruction;
+}
+
+} // namespace arabica
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <arabica/cpu/op_code.hpp>
+#include <cstdint>
+
+namespace arabica {
+
+// Loops a program spins in while it waits for something outside of the CPU. Nothing but the end of
+// the frame (timer tick) or a key press gets it out of them, so the rest of the frame can be skipped.
+enum class IDLE : uint8_t {
+  NONE,
+  JP_SELF,    // 1nnn with nnn = pc, or 00FD         spin forever, the timers keep running
+  DELAY_POLL, // Fx07, 3xkk, 1nnn with nnn = pc      wait for the delay timer to reach kk
+  KEY_WAIT,   // Fx0A                                wait for a key press
+};
+
+// The longest idle loop covers this many bytes starting at `pc`.
+constexpr uint16_t IDLE_SPAN = 3 * 2;
+
+constexpr IDLE idle_of(const uint16_t pc, const uint16_t first, const uint16_t second, const uint16_t third) {
+  const OP_CODE op_first = decode_opcode(first);
+  const uint8_t x        = (first & 0x0F00) >> 8;
+
+  if ((op_first == OP_CODE::JP_addr && (first & 0x0FFF) == pc) || op_first == OP_CODE::EXIT) {
+    return IDLE::JP_SELF;
+  }
+  if (op_first == OP_CODE::LD_Vx_K) {
+    return IDLE::KEY_WAIT;
+  }
+  if (op_first == OP_CODE::LD_Vx_DT && decode_opcode(second) == OP_CODE::SE_Vx_byte && x == ((second & 0x0F00) >> 8) &&
+      decode_opcode(third) == OP_CODE::JP_addr && (third & 0x0FFF) == pc) {
+    return IDLE::DELAY_POLL;
+  }
+  return IDLE::NONE;
+}
+
+} // namespace arabica
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <arabica/cpu/dispatch_table.hpp>
+#include <arabica/cpu/op_code.hpp>
+#include <cstdint>
+
+namespace arabica {
+
+// A fully decoded instruction, every operand field is extracted once at decode time
+// so that the execution step only has to look them up.
+//
+// +------+------+------+------+
+// | 15-12| 11-8 |  7-4 |  3-0 |
+// +------+------+------+------+
+// |prefix|  x   |  y   |  n   |
+// |      |      |     kk      |
+// |      |         nnn        |
+// +------+------+------+------+
+struct Instruction {
+  OP_CODE  opcode{OP_CODE::CLS};
+  uint8_t  handler{HANDLER_UNKNOWN};
+  uint16_t word{0x0000};
+  uint16_t nnn{0x000};
+  uint8_t  x{0x0};
+  uint8_t  y{0x0};
+  uint8_t  n{0x0};
+  uint8_t  kk{0x00};
+};
+
+constexpr Instruction decode(const uint16_t word) {
+  Instruction instruction;
+  instruction.opcode  = decode_opcode(word);
+  instruction.handler = DISPATCH_TABLE[dispatch_key(word)];
+  instruction.word    = word;
+  instruction.nnn     = word & 0x0FFF;
+  instruction.x       = (word & 0x0F00) >> 8;
+  instruction.y       = (word & 0x00F0) >> 4;
+  instruction.n       = word & 0x000F;
+  instruction.kk      = word & 0x00FF;
+  return instruction;
+}
+
+} // namespace arabica
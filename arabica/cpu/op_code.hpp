@@ -4,10 +4,16 @@
 
 namespace arabica {
 
-// spec: http://devernay.free.fr/hacks/chip8/C8TECH10.HTM
+// spec: http://devernay.free.fr/hacks/chip8/C8TECH10.HTM, SUPER-CHIP in section 3.2
 enum class OP_CODE : uint16_t {
   CLS              = 0x00E0, // 00E0
   RET              = 0x00EE, // 00EE
+  SCD_nibble       = 0x00C0, // 00Cn, SUPER-CHIP
+  SCR              = 0x00FB, // 00FB, SUPER-CHIP
+  SCL              = 0x00FC, // 00FC, SUPER-CHIP
+  EXIT             = 0x00FD, // 00FD, SUPER-CHIP
+  LOW              = 0x00FE, // 00FE, SUPER-CHIP
+  HIGH             = 0x00FF, // 00FF, SUPER-CHIP
   SYS_addr         = 0x0000, // 0nnn
   JP_addr          = 0x1000, // 1nnn
   CALL_addr        = 0x2000, // 2nnn
@@ -29,7 +35,7 @@ enum class OP_CODE : uint16_t {
   LD_I_addr        = 0xA000, // Annn
   JP_V0_addr       = 0xB000, // Bnnn
   RND_Vx_byte      = 0xC000, // Cxkk
-  DRW_Vx_Vy_nibble = 0xD000, // Dxyn
+  DRW_Vx_Vy_nibble = 0xD000, // Dxyn, Dxy0 draws a 16x16 sprite on SUPER-CHIP
   SKP_Vx           = 0xE09E, // Ex9E
   SKNP_Vx          = 0xE0A1, // ExA1
   LD_Vx_DT         = 0xF007, // Fx07
@@ -41,6 +47,128 @@ enum class OP_CODE : uint16_t {
   LD_B_Vx          = 0xF033, // Fx33
   LD_I_Vx          = 0xF055, // Fx55
   LD_Vx_I          = 0xF065, // Fx65
+  LD_HF_Vx         = 0xF030, // Fx30, SUPER-CHIP
+  LD_R_Vx          = 0xF075, // Fx75, SUPER-CHIP
+  LD_Vx_R          = 0xF085, // Fx85, SUPER-CHIP
 };
 
+constexpr OP_CODE decode_opcode(const uint16_t word) {
+  const uint16_t prefix = word & 0xF000;
+
+  switch (prefix) {
+    case 0x0000: {
+      if ((word & 0x00F0) == 0x00C0) {
+        return OP_CODE::SCD_nibble;
+      }
+      switch (word & 0x00FF) {
+        case 0xE0: return OP_CODE::CLS;
+        case 0xEE: return OP_CODE::RET;
+        case 0xFB: return OP_CODE::SCR;
+        case 0xFC: return OP_CODE::SCL;
+        case 0xFD: return OP_CODE::EXIT;
+        case 0xFE: return OP_CODE::LOW;
+        case 0xFF: return OP_CODE::HIGH;
+        default: return OP_CODE::SYS_addr;
+      }
+    }
+    case 0x8000: {
+      switch (word & 0x000F) {
+        case 0x0: return OP_CODE::LD_Vx_Vy;
+        case 0x1: return OP_CODE::OR_Vx_Vy;
+        case 0x2: return OP_CODE::AND_Vx_Vy;
+        case 0x3: return OP_CODE::XOR_Vx_Vy;
+        case 0x4: return OP_CODE::ADD_Vx_Vy;
+        case 0x5: return OP_CODE::SUB_Vx_Vy;
+        case 0x6: return OP_CODE::SHR_Vx;
+        case 0x7: return OP_CODE::SUBN_Vx_Vy;
+        case 0xE: return OP_CODE::SHL_Vx;
+        default: return OP_CODE::LD_Vx_Vy;
+      }
+    }
+    case 0xE000: {
+      switch (word & 0x00FF) {
+        case 0x9E: return OP_CODE::SKP_Vx;
+        case 0xA1: return OP_CODE::SKNP_Vx;
+        default: return static_cast<OP_CODE>(prefix);
+      }
+    }
+    case 0xF000: {
+      switch (word & 0x00FF) {
+        case 0x07: return OP_CODE::LD_Vx_DT;
+        case 0x0A: return OP_CODE::LD_Vx_K;
+        case 0x15: return OP_CODE::LD_DT_Vx;
+        case 0x18: return OP_CODE::LD_ST_Vx;
+        case 0x1E: return OP_CODE::ADD_I_Vx;
+        case 0x29: return OP_CODE::LD_F_Vx;
+        case 0x33: return OP_CODE::LD_B_Vx;
+        case 0x55: return OP_CODE::LD_I_Vx;
+        case 0x65: return OP_CODE::LD_Vx_I;
+        case 0x30: return OP_CODE::LD_HF_Vx;
+        case 0x75: return OP_CODE::LD_R_Vx;
+        case 0x85: return OP_CODE::LD_Vx_R;
+        default: return static_cast<OP_CODE>(prefix);
+      }
+    }
+    default: return static_cast<OP_CODE>(prefix);
+  }
+}
+
+// Every op code paired with the `Emulator` member function executing it.
+// The position in this list is the handler index used by the dispatch tables.
+#define ARABICA_OP_CODE_LIST(X)         \
+  X(CLS, cls)                           \
+  X(RET, ret)                           \
+  X(SYS_addr, sys_addr)                 \
+  X(JP_addr, jp_addr)                   \
+  X(CALL_addr, call_addr)               \
+  X(SE_Vx_byte, se_vx_byte)             \
+  X(SNE_Vx_byte, sne_vx_byte)           \
+  X(SE_Vx_Vy, se_vx_vy)                 \
+  X(LD_Vx_byte, ld_vx_byte)             \
+  X(ADD_Vx_byte, add_vx_byte)           \
+  X(LD_Vx_Vy, ld_vx_vy)                 \
+  X(OR_Vx_Vy, or_vx_vy)                 \
+  X(AND_Vx_Vy, and_vx_vy)               \
+  X(XOR_Vx_Vy, xor_vx_vy)               \
+  X(ADD_Vx_Vy, add_vx_vy)               \
+  X(SUB_Vx_Vy, sub_vx_vy)               \
+  X(SHR_Vx, shr_vx)                     \
+  X(SUBN_Vx_Vy, subn_vx_vy)             \
+  X(SHL_Vx, shl_vx)                     \
+  X(SNE_Vx_Vy, sne_vx_vy)               \
+  X(LD_I_addr, ld_i_addr)               \
+  X(JP_V0_addr, jp_v0_addr)             \
+  X(RND_Vx_byte, rnd_vx_byte)           \
+  X(DRW_Vx_Vy_nibble, drw_vx_vy_nibble) \
+  X(SKP_Vx, skp_vx)                     \
+  X(SKNP_Vx, sknp_vx)                   \
+  X(LD_Vx_DT, ld_vx_dt)                 \
+  X(LD_Vx_K, ld_vx_k)                   \
+  X(LD_DT_Vx, ld_dt_vx)                 \
+  X(LD_ST_Vx, ld_st_vx)                 \
+  X(ADD_I_Vx, add_i_vx)                 \
+  X(LD_F_Vx, ld_f_vx)                   \
+  X(LD_B_Vx, ld_b_vx)                   \
+  X(LD_I_Vx, ld_i_vx)                   \
+  X(LD_Vx_I, ld_vx_i)                   \
+  X(SCD_nibble, scd_nibble)             \
+  X(SCR, scr)                           \
+  X(SCL, scl)                           \
+  X(EXIT, exit)                         \
+  X(LOW, low)                           \
+  X(HIGH, high)                         \
+  X(LD_HF_Vx, ld_hf_vx)                 \
+  X(LD_R_Vx, ld_r_vx)                   \
+  X(LD_Vx_R, ld_vx_r)
+
+constexpr const char* op_code_name(const OP_CODE opcode) {
+  switch (opcode) {
+#define ARABICA_OP_CODE_NAME(op_code, handler) \
+  case OP_CODE::op_code: return #op_code;
+    ARABICA_OP_CODE_LIST(ARABICA_OP_CODE_NAME)
+#undef ARABICA_OP_CODE_NAME
+    default: return "UNKNOWN";
+  }
+}
+
 } // namespace arabica
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace arabica {
+
+// The call stack with the `std::stack` interface the emulator was written against, but a fixed
+// capacity, so that it is plain data and the whole machine state can be copied byte by byte.
+//
+// Chip-8 interpreters keep 16 return addresses. A deeper call overwrites the innermost one rather
+// than growing the stack, the same as `simd::Lockstep` does. A size beyond `DEPTH`, which only a
+// corrupt saved state could hold, is taken as `DEPTH`, so the entries are never indexed out of bounds.
+class Stack {
+public:
+  constexpr static uint8_t DEPTH = 16;
+
+  void push(const uint16_t address) {
+    _size               = _size < DEPTH ? _size + 1 : DEPTH;
+    _entries[_size - 1] = address;
+  }
+
+  void pop() {
+    if (_size > 0) {
+      _size = (_size < DEPTH ? _size : DEPTH) - 1;
+    }
+  }
+
+  // 0 on an empty stack rather than a read before the entries
+  uint16_t top() const {
+    return _size == 0 ? 0 : _entries[(_size < DEPTH ? _size : DEPTH) - 1];
+  }
+
+  std::size_t size() const {
+    return _size;
+  }
+
+  bool empty() const {
+    return _size == 0;
+  }
+
+private:
+  uint16_t _entries[DEPTH] = {0};
+  uint16_t _size{0}; // as wide as the entries, so there are no padding bytes
+};
+
+} // namespace arabica
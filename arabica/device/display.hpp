@@ -1,87 +1,321 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <vector>
 
 namespace arabica {
 
+// The Chip-8 screen, held as packed 64-bit words: one per row at 64x32 and, in the SUPER-CHIP
+// high resolution of 128x64, two per row. Drawing a sprite row is a rotate, an AND for the collision
+// and an XOR, scrolling moves whole words. Pixels are only made when a frame is presented, and only
+// for the rectangles changed since the last one, see `dirty_rects`: at native resolution by `render`
+// for a renderer that scales them itself, or scaled on the CPU by `simd::expand`.
 class Display {
 public:
-  ~Display() {
-    if (pixels != nullptr) {
-      delete[] pixels;
-    }
-  }
-
-  void init(const int w, const int h, const int s) {
-    scale             = s;
-    window_width      = w;
-    window_height     = h;
-    resolution        = w * h;
-    chip8_width       = w / s;
-    chip8_height      = h / s;
-    pixels            = new uint32_t[resolution];
-    horizontal_offset = 0;
-    vertical_offset   = 0;
+  constexpr static int      PLANE_WIDTH  = 64;
+  constexpr static int      PLANE_HEIGHT = 32;
+  constexpr static int      HIRES_WIDTH  = 128;
+  constexpr static int      HIRES_HEIGHT = 64;
+  constexpr static int      MAX_WORDS    = HIRES_WIDTH / 64;         // words per row at most
+  constexpr static int      PLANE_WORDS  = HIRES_HEIGHT * MAX_WORDS; // words of the largest screen
+  constexpr static uint32_t COLOR_ON     = 0xFF0000FF;
+
+  // A part of the screen, in Chip-8 pixels.
+  struct Rect {
+    int x{0};
+    int y{0};
+    int width{0};
+    int height{0};
+  };
+
+  // Runs of dirty columns closer than this are sent as one rectangle, a sprite byte with holes in it
+  // stays in one piece.
+  constexpr static int MERGE_GAP = 8;
+
+  // a blank screen in low resolution, all of it dirty
+  void init() {
+    is_hires = false;
     reset();
+    std::memset(dirty, 0xFF, sizeof(uint64_t) * used_words());
   }
 
-  void set(const int x, const int y, const uint32_t color) {
-    if (x >= 0 && x < window_width && y >= 0 && y < window_height) {
-      pixels[y * window_width + x] = color;
+  void reset() {
+    for (int i = 0; i < PLANE_WORDS; ++i) {
+      dirty[i] |= plane[i];
     }
+    std::memset(plane, 0, sizeof(plane));
+  }
+
+  int width() const {
+    return is_hires ? HIRES_WIDTH : PLANE_WIDTH;
+  }
+
+  int height() const {
+    return is_hires ? HIRES_HEIGHT : PLANE_HEIGHT;
+  }
+
+  int words() const {
+    return is_hires ? MAX_WORDS : 1;
   }
 
-  uint32_t get(const int x, const int y) const {
-    if (x >= 0 && x < window_width && y >= 0 && y < window_height) {
-      return pixels[y * window_width + x];
+  // the words of `plane` the current resolution uses, the others stay blank and clean
+  int used_words() const {
+    return height() * words();
+  }
+
+  // SUPER-CHIP 00FE and 00FF. Switching the resolution clears the screen, as Octo does, and repaints
+  // all of it; asking for the current one does nothing.
+  void set_hires(const bool is_enable) {
+    if (is_hires == is_enable) {
+      return;
     }
-    return 0;
+    is_hires = is_enable;
+    std::memset(plane, 0, sizeof(plane));
+    std::memset(dirty, 0, sizeof(dirty));
+    std::memset(dirty, 0xFF, sizeof(uint64_t) * used_words());
   }
 
-  void reset() {
-    for (int i = 0; i < resolution; ++i) {
-      pixels[i] = 0;
-    }
-  }
-
-  int update(const int reg_vx, const int reg_vy, const std::vector<uint8_t>& sprite_data) {
-    bool collision = false;
-    for (int y = 0; y < sprite_data.size(); ++y) {
-      const uint8_t sprite_row = sprite_data[y];
-      for (int x = 0; x < 8; ++x) {
-        if (const uint8_t pixel = (sprite_row >> (7 - x)) & 0x01; pixel == 1) {
-          const int device_x = (reg_vx + x) % chip8_width;
-          const int device_y = (reg_vy + y) % chip8_height;
-          const int window_x = device_x * scale + horizontal_offset;
-          const int window_y = device_y * scale + vertical_offset;
-
-          for (int dy = 0; dy < scale; ++dy) {
-            for (int dx = 0; dx < scale; ++dx) {
-              const auto window_dx = window_x + dx;
-              const auto window_dy = window_y + dy;
-              const auto pre_pixel = get(window_dx, window_dy);
-              if (pre_pixel != 0) {
-                collision = true;
-              }
-              set(window_dx, window_dy, pre_pixel ^ 0xFF0000FF);
-            }
-          }
+  // Replaces the screen with `rows`, laid out like `plane` for the resolution `hires`. Only a
+  // different screen is repainted.
+  void set_plane(const uint64_t (&rows)[PLANE_WORDS], const bool hires) {
+    if (hires != is_hires) {
+      set_hires(hires);
+    } else if (std::memcmp(plane, rows, sizeof(plane)) == 0) {
+      return;
+    }
+    for (int i = 0; i < PLANE_WORDS; ++i) {
+      dirty[i] |= plane[i] ^ rows[i];
+    }
+    std::memcpy(plane, rows, sizeof(plane));
+    is_refresh = true;
+  }
+
+  // Takes the screen of `other` and adds its changes to the ones not presented yet.
+  void merge(const Display& other) {
+    is_hires = other.is_hires;
+    std::memcpy(plane, other.plane, sizeof(plane));
+    for (int i = 0; i < PLANE_WORDS; ++i) {
+      dirty[i] |= other.dirty[i];
+    }
+  }
+
+  bool is_on(const int x, const int y) const {
+    const int column = x % width();
+    return (plane[y % height() * words() + column / 64] >> (63 - column % 64)) & 1;
+  }
+
+  // XORs the `rows` bytes of `sprite` in at (`reg_vx`, `reg_vy`), wrapping around both edges, and
+  // returns 1 if it erased any pixel.
+  int update(const int reg_vx, const int reg_vy, const uint8_t* const sprite, const int rows) {
+    return is_hires ? draw<8, MAX_WORDS>(reg_vx, reg_vy, sprite, rows) : draw<8, 1>(reg_vx, reg_vy, sprite, rows);
+  }
+
+  // SUPER-CHIP Dxy0: a 16x16 sprite, two bytes per row, drawn like `update`.
+  int update_large(const int reg_vx, const int reg_vy, const uint8_t* const sprite) {
+    return is_hires ? draw<16, MAX_WORDS>(reg_vx, reg_vy, sprite, 16) : draw<16, 1>(reg_vx, reg_vy, sprite, 16);
+  }
+
+  // SUPER-CHIP 00Cn: every row moves down by `rows`, blank rows come in at the top. The rows are
+  // whole runs of words, moved from the bottom up so that each is read before it is overwritten.
+  void scroll_down(const int rows) {
+    const int shift = rows * words();
+    for (int i = height() * words() - 1; i >= 0; --i) {
+      const uint64_t row = i >= shift ? plane[i - shift] : 0;
+      dirty[i] |= plane[i] ^ row;
+      plane[i] = row;
+    }
+  }
+
+  // SUPER-CHIP 00FB: every row moves right by `pixels`, less than 64, and what leaves the screen is lost.
+  void scroll_right(const int pixels) {
+    const int words = this->words();
+    for (int y = 0; y < height(); ++y) {
+      uint64_t* const row   = plane + y * words;
+      uint64_t* const flags = dirty + y * words;
+      for (int word = words - 1; word >= 0; --word) {
+        const uint64_t shifted = row[word] >> pixels | (word > 0 ? row[word - 1] << (64 - pixels) : 0);
+        flags[word] |= row[word] ^ shifted;
+        row[word] = shifted;
+      }
+    }
+  }
+
+  // SUPER-CHIP 00FC: the same to the left.
+  void scroll_left(const int pixels) {
+    const int words = this->words();
+    for (int y = 0; y < height(); ++y) {
+      uint64_t* const row   = plane + y * words;
+      uint64_t* const flags = dirty + y * words;
+      for (int word = 0; word < words; ++word) {
+        const uint64_t shifted = row[word] << pixels | (word + 1 < words ? row[word + 1] >> (64 - pixels) : 0);
+        flags[word] |= row[word] ^ shifted;
+        row[word] = shifted;
+      }
+    }
+  }
+
+  bool is_dirty() const {
+    for (int i = 0; i < used_words(); ++i) {
+      if (dirty[i] != 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // the frame has been presented, nothing is dirty any more
+  void clean() {
+    std::memset(dirty, 0, sizeof(uint64_t) * used_words());
+    is_refresh = false;
+  }
+
+  // Replaces `rects` with rectangles covering every dirty pixel: one per run of dirty rows and, within
+  // it, per run of the columns dirty in any of them.
+  void dirty_rects(std::vector<Rect>& rects) const {
+    if (is_hires) {
+      dirty_rects<MAX_WORDS>(rects);
+    } else {
+      dirty_rects<1>(rects);
+    }
+  }
+
+  // Writes the `rect` part of the screen at one ARGB pixel per Chip-8 pixel, e.g. into a locked
+  // streaming texture: `pixels` is where the rectangle starts and `pitch` the bytes between its lines.
+  void render(void* const pixels, const int pitch, const Rect& rect) const {
+    if (is_hires) {
+      render<MAX_WORDS>(pixels, pitch, rect);
+    } else {
+      render<1>(pixels, pitch, rect);
+    }
+  }
+
+  // FNV-1a over the Chip-8 pixels of the current resolution, the same whatever the display is scaled to
+  uint64_t hash() const {
+    uint64_t hash = 0xCBF29CE484222325;
+    for (int y = 0; y < height(); ++y) {
+      for (int x = 0; x < width(); ++x) {
+        hash = (hash ^ (is_on(x, y) ? 1 : 0)) * 0x100000001B3;
+      }
+    }
+    return hash;
+  }
+
+  // The Chip-8 screen at one bit per pixel, `words()` words per row and the leftmost pixel in the top
+  // bit of the first one: in low resolution the first 32 words are its rows, as they always were.
+  uint64_t plane[PLANE_WORDS] = {0};
+  // the pixels changed since the last `clean`, laid out like `plane`
+  uint64_t dirty[PLANE_WORDS] = {0};
+
+  bool is_refresh{false};
+  bool is_hires{false};
+
+private:
+  // Each sprite row, `WIDTH` pixels from the top bit on, is split at the word boundary it crosses;
+  // with one word per row both halves land in it, which is a rotate. The resolution is a template
+  // argument so that the low one keeps its constant masks.
+  template<int WIDTH, int WORDS>
+  int draw(const int reg_vx, const int reg_vy, const uint8_t* const sprite, const int rows) {
+    const unsigned x         = reg_vx % (WORDS * PLANE_WIDTH);
+    const unsigned shift     = x % 64;
+    const int      first     = x / 64;
+    const int      second    = (first + 1) % WORDS;
+    uint64_t       collision = 0;
+    for (int row = 0; row < rows; ++row) {
+      const uint64_t  bits  = WIDTH == 8 ? static_cast<uint64_t>(sprite[row]) << 56
+                                         : static_cast<uint64_t>(sprite[2 * row] << 8 | sprite[2 * row + 1]) << 48;
+      const int       index = (reg_vy + row) % (WORDS * PLANE_HEIGHT) * WORDS;
+      uint64_t* const line  = plane + index;
+      uint64_t* const flags = dirty + index;
+      if constexpr (WORDS == 1) {
+        const uint64_t pixels = shift == 0 ? bits : bits >> shift | bits << (64 - shift);
+        collision |= line[0] & pixels;
+        line[0] ^= pixels;
+        flags[0] |= pixels;
+        continue;
+      }
+      const uint64_t head = bits >> shift;
+      const uint64_t tail = shift == 0 ? 0 : bits << (64 - shift);
+      collision |= line[first] & head;
+      line[first] ^= head;
+      flags[first] |= head;
+      collision |= line[second] & tail;
+      line[second] ^= tail;
+      flags[second] |= tail;
+    }
+    return collision != 0 ? 1 : 0;
+  }
+
+  template<int WORDS>
+  void render(void* const pixels, const int pitch, const Rect& rect) const {
+    for (int y = 0; y < rect.height; ++y) {
+      uint32_t* const       line = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(pixels) + y * pitch);
+      const uint64_t* const row  = plane + (rect.y + y) * WORDS;
+      if constexpr (WORDS == 1) {
+        const uint64_t bits = row[0] << rect.x;
+        for (int x = 0; x < rect.width; ++x) {
+          line[x] = (bits >> (63 - x)) & 1 ? COLOR_ON : 0;
+        }
+        continue;
+      }
+      for (int x = 0; x < rect.width;) {
+        // the pixels left in the word the next one is in, its top bit first
+        const unsigned column = rect.x + x;
+        const uint64_t bits   = row[column / 64] << (column % 64);
+        const int      end    = std::min<int>(rect.width, x + 64 - column % 64);
+        for (int bit = 63; x < end; ++x, --bit) {
+          line[x] = (bits >> bit) & 1 ? COLOR_ON : 0;
+        }
+      }
+    }
+  }
+
+  template<int WORDS>
+  void dirty_rects(std::vector<Rect>& rects) const {
+    constexpr int width  = WORDS * PLANE_WIDTH;
+    constexpr int height = WORDS * PLANE_HEIGHT;
+    rects.clear();
+    for (int y = 0; y < height;) {
+      if (!is_row_dirty<WORDS>(y)) {
+        ++y;
+        continue;
+      }
+      const int top                = y;
+      uint64_t  columns[MAX_WORDS] = {0};
+      for (; y < height && is_row_dirty<WORDS>(y); ++y) {
+        for (int word = 0; word < WORDS; ++word) {
+          columns[word] |= dirty[y * WORDS + word];
         }
       }
+      for (int x = 0; x < width;) {
+        if (!is_column(columns, x)) {
+          ++x;
+          continue;
+        }
+        const int left = x;
+        int       gap  = 0;
+        for (; x < width && gap < MERGE_GAP; ++x) {
+          gap = is_column(columns, x) ? 0 : gap + 1;
+        }
+        rects.push_back(Rect{left, top, x - gap - left, y - top});
+      }
     }
-    return collision ? 1 : 0;
   }
 
-  uint32_t* pixels{nullptr};
-  int       chip8_width{0};
-  int       chip8_height{0};
-  int       scale{1};
-  int       window_width{0};
-  int       window_height{0};
-  int       resolution{0};
-  bool      is_refresh{false};
-  int       horizontal_offset{0};
-  int       vertical_offset{0};
+  template<int WORDS>
+  bool is_row_dirty(const int y) const {
+    for (int word = 0; word < WORDS; ++word) {
+      if (dirty[y * WORDS + word] != 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  static bool is_column(const uint64_t (&columns)[MAX_WORDS], const int x) {
+    return (columns[x / 64] >> (63 - x % 64)) & 1;
+  }
 };
 
-} // namespace arabica
\ No newline at end of file
+} // namespace arabica
@@ -1,9 +1,18 @@
 #pragma once
 
-#include <SDL2/SDL.h>
+#include <array>
+#include <cstdint>
 
 namespace arabica {
 
+// A key going down or up at an exact point of the emulation, see `Emulator::execute` and `Movie`.
+struct KeyEvent {
+  uint32_t frame{0};       // frames since the start of the recording
+  uint16_t instruction{0}; // instructions into the frame
+  uint8_t  key{0};
+  uint8_t  is_pressed{0};
+};
+
 class Keypad {
 public:
   void on_keydown(const uint8_t keycode) {
@@ -15,8 +24,22 @@ public:
     keypressed_status[keycode] = false;
   }
 
+  void apply(const KeyEvent& event) {
+    if (event.is_pressed != 0) {
+      on_keydown(event.key & 0xF);
+    } else {
+      on_keyup(event.key & 0xF);
+    }
+  }
+
+  // sets the key without counting it as a key press, e.g. when a saved state is restored
+  void set(const uint8_t keycode, const bool is_pressed) {
+    keypressed_status[keycode & 0xF] = is_pressed;
+  }
+
+  // only the low nibble names a key, Ex9E and ExA1 may well hold more in Vx
   bool is_keypressed(const uint8_t keycode) const {
-    return keypressed_status[keycode];
+    return keypressed_status[keycode & 0xF];
   }
 
   int get_last_keypressed_code() const {
@@ -0,0 +1,22 @@
+#include <arabica/device/random.hpp>
+#include <fstream>
+#include <iterator>
+
+namespace arabica {
+
+bool Random::save(const std::string& path) const {
+  std::ofstream file(path, std::ios::binary);
+  file.write(reinterpret_cast<const char*>(_stream.data()), _stream.size());
+  return static_cast<bool>(file);
+}
+
+bool Random::load(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  replay(std::vector<uint8_t>{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()});
+  return true;
+}
+
+} // namespace arabica
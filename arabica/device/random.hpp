@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace arabica {
+
+// xoshiro128**: four words of state, a handful of shifts and rotates per number, and the same
+// sequence on every platform for a given seed.
+struct Xoshiro128 {
+  uint32_t state[4];
+
+  // spreads a 64-bit seed over the state with splitmix64, the state is never all zeros
+  void seed(uint64_t seed) {
+    for (int i = 0; i < 4; i += 2) {
+      seed += 0x9E3779B97F4A7C15;
+      uint64_t z   = seed;
+      z            = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+      z            = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+      z            = z ^ (z >> 31);
+      state[i]     = static_cast<uint32_t>(z);
+      state[i + 1] = static_cast<uint32_t>(z >> 32);
+    }
+  }
+
+  uint32_t next() {
+    const uint32_t result = rotl(state[1] * 5, 7) * 9;
+    const uint32_t t      = state[1] << 9;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3]  = rotl(state[3], 11);
+    return result;
+  }
+
+  // the high bits are the best mixed ones
+  uint8_t next_byte() {
+    return static_cast<uint8_t>(next() >> 24);
+  }
+
+  static uint32_t rotl(const uint32_t x, const int k) {
+    return (x << k) | (x >> (32 - k));
+  }
+};
+
+// Source of the RND instruction. The generator is part of the machine state, so a run is
+// reproduced from its seed; on top of that the bytes handed out can be recorded, and a recorded
+// stream replayed instead of the generator, e.g. to reproduce a run of another build.
+//
+// The stream and the position in it are not part of the machine state: restoring a state while
+// recording or replaying leaves them where they are, so such a run only reproduces when it goes
+// straight through, without rewinds or loaded states.
+class Random {
+public:
+  enum class MODE { GENERATE, RECORD, REPLAY };
+
+  constexpr static uint64_t DEFAULT_SEED = 0x0A7AB1CA;
+
+  Random() {
+    seed(DEFAULT_SEED);
+  }
+
+  void seed(const uint64_t seed) {
+    generator.seed(seed);
+  }
+
+  uint8_t next_byte() {
+    if (_mode == MODE::REPLAY && _position < _stream.size()) {
+      return _stream[_position++];
+    }
+    const uint8_t byte = generator.next_byte();
+    if (_mode == MODE::RECORD) {
+      _stream.push_back(byte);
+    }
+    return byte;
+  }
+
+  // Keeps every byte handed out from now on in `stream()`.
+  void record() {
+    _mode = MODE::RECORD;
+    _stream.clear();
+  }
+
+  // Hands out the bytes of `stream` in order, then goes on with the generator once they run out.
+  void replay(std::vector<uint8_t> stream) {
+    _mode     = MODE::REPLAY;
+    _stream   = std::move(stream);
+    _position = 0;
+  }
+
+  void generate() {
+    _mode = MODE::GENERATE;
+    _stream.clear();
+    _position = 0;
+  }
+
+  // the recorded stream as a file of raw bytes, and back as a stream to replay
+  bool save(const std::string& path) const;
+  bool load(const std::string& path);
+
+  MODE mode() const {
+    return _mode;
+  }
+
+  const std::vector<uint8_t>& stream() const {
+    return _stream;
+  }
+
+  // bytes of a replayed stream not handed out yet
+  std::size_t remaining() const {
+    return _mode == MODE::REPLAY ? _stream.size() - _position : 0;
+  }
+
+  Xoshiro128 generator;
+
+private:
+  MODE                 _mode{MODE::GENERATE};
+  std::vector<uint8_t> _stream;
+  std::size_t          _position{0};
+};
+
+} // namespace arabica
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <arabica/device/display.hpp>
+
+namespace arabica {
+
+// Where the emulator sends its output. The core only knows these interfaces, the front end
+// (e.g. the SDL window) implements them.
+class AudioSink {
+public:
+  virtual ~AudioSink() = default;
+
+  virtual void start_beep() = 0;
+  virtual void stop_beep()  = 0;
+};
+
+class VideoSink {
+public:
+  virtual ~VideoSink() = default;
+
+  // called at the end of every emulated frame which changed the display
+  virtual void on_frame(const Display& display) = 0;
+};
+
+} // namespace arabica
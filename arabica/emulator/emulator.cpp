@@ -1,560 +1,957 @@
 #include <arabica/emulator/emulator.hpp>
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
-#include <vector>
+#include <cstring>
+#include <utility>
 
 namespace arabica {
 
-bool Emulator::init() {
-  return sound.init();
+// A program translated ahead of time from the same rom is picked up, see `aot::Registry`.
+bool Emulator::load(const std::string& rom) {
+  if (!memory.load(rom)) {
+    return false;
+  }
+  aot.load(aot::Registry::find(memory));
+  return true;
 }
 
-bool Emulator::load(const std::string& rom) {
-  return memory.load(rom);
+bool Emulator::load(const std::vector<uint8_t>& rom) {
+  if (!memory.load(rom)) {
+    return false;
+  }
+  aot.load(aot::Registry::find(memory));
+  return true;
+}
+
+bool Emulator::load(const aot::Program& program) {
+  if (program.rom_size > Memory::SIZE - Memory::RESERVED) {
+    return false;
+  }
+  for (std::size_t i = 0; i < program.rom_size; ++i) {
+    memory.write(Memory::RESERVED + i, program.rom[i]);
+  }
+  aot.load(&program);
+  return true;
 }
 
 void Emulator::execute() {
-  is_enable_log = false;
+  execute(nullptr, 0);
+}
 
-  log_info("PC = {:x}\n", cpu.pc);
+void Emulator::execute(const KeyEvent* const events, const std::size_t count) {
+  trace::log<trace::Event::FRAME>(cycle, cpu.pc);
 
   // 500 Hz / 60 FPS = 500 (Instructions / Second) / 60 (Frames / Second) = 500 / 60 (Instructions / Frame)
   const int instructions_pre_frames = cpu.clock_speed / fps;
-  for (int i = 0; i < instructions_pre_frames; ++i) {
-    single_step();
+  idle_cycles                       = 0;
+
+  // every engine stops exactly at the end of its budget, so splitting the frame changes nothing else
+  int executed = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    const int at = std::min<int>(events[i].instruction, instructions_pre_frames);
+    if (at > executed) {
+      run(at - executed);
+      executed = at;
+    }
+    keypad.apply(events[i]);
   }
+  run(instructions_pre_frames - executed);
+  idle_percentage = instructions_pre_frames > 0 ? 100.0f * idle_cycles / instructions_pre_frames : 0.0f;
 
-  log_info("The current cycle is {}\n", cycle);
+  trace::log<trace::Event::FRAME_IDLE>(cycle, idle_cycles, instructions_pre_frames);
   cycle++;
 
   delay.tick();
   sound.tick();
+
+  if (display.is_refresh && video_sink != nullptr) {
+    video_sink->on_frame(display);
+    display.clean();
+  }
+}
+
+MachineState Emulator::snapshot() const {
+  MachineState state;
+  snapshot(state);
+  return state;
+}
+
+void Emulator::snapshot(MachineState& state) const {
+  std::memcpy(state.registers, cpu.registers, sizeof(state.registers));
+  std::memcpy(state.rpl, cpu.rpl, sizeof(state.rpl));
+  state.reg_I     = cpu.reg_I;
+  state.pc        = cpu.pc;
+  state.stack     = cpu.stack;
+  state.reg_delay = cpu.reg_delay;
+  state.reg_sound = cpu.reg_sound;
+  state.sound     = sound.frequency;
+  state.cycle     = cycle;
+  state.delay     = delay.get();
+  state.last_key  = static_cast<uint8_t>(keypad.get_last_keypressed_code());
+  for (uint8_t key = 0; key < 16; ++key) {
+    state.keys[key] = keypad.is_keypressed(key);
+  }
+  state.hires = display.is_hires;
+  std::memset(state.reserved, 0, sizeof(state.reserved));
+  std::memcpy(state.random, random.generator.state, sizeof(state.random));
+  std::memcpy(state.display, display.plane, sizeof(state.display));
+  std::memcpy(state.memory, memory.data(), sizeof(state.memory));
+}
+
+void Emulator::restore(const MachineState& state) {
+  std::memcpy(cpu.registers, state.registers, sizeof(cpu.registers));
+  std::memcpy(cpu.rpl, state.rpl, sizeof(cpu.rpl));
+  cpu.reg_I     = state.reg_I;
+  cpu.pc        = state.pc;
+  cpu.stack     = state.stack;
+  cpu.reg_delay = state.reg_delay;
+  cpu.reg_sound = state.reg_sound;
+  cycle         = state.cycle;
+  delay.set(state.delay);
+  keypad.last_keypressed_code = state.last_key == 0xFF ? -1 : state.last_key;
+  for (uint8_t key = 0; key < 16; ++key) {
+    keypad.set(key, state.keys[key]);
+  }
+  if (sound.frequency != state.sound) {
+    sound.frequency = state.sound;
+    if (sound.frequency > 0) {
+      sound.start_beep();
+    } else {
+      sound.stop_beep();
+    }
+  }
+  std::memcpy(random.generator.state, state.random, sizeof(random.generator.state));
+  display.set_plane(state.display, state.hires);
+  memory.assign(state.memory);
 }
 
 void Emulator::single_step() {
-  cpu.instruction = memory[cpu.pc] << 8 | memory[cpu.pc + 1];
-  uint16_t prefix = cpu.instruction & 0xF000;
-  cpu.opcode      = static_cast<OP_CODE>(prefix);
-
-  log_info("cpu.instruction is {0:x}\n", cpu.instruction);
-
-  switch (prefix) {
-    case 0x0: {
-      switch (cpu.instruction & 0x00FF) {
-        case 0xE0: cpu.opcode = OP_CODE::CLS; break;
-        case 0xEE: cpu.opcode = OP_CODE::RET; break;
-        default: break;
-      }
-    } break;
-    case 0x8000: {
-      switch (cpu.instruction & 0x000F) {
-        case 0x0: cpu.opcode = OP_CODE::LD_Vx_Vy; break;
-        case 0x1: cpu.opcode = OP_CODE::OR_Vx_Vy; break;
-        case 0x2: cpu.opcode = OP_CODE::AND_Vx_Vy; break;
-        case 0x3: cpu.opcode = OP_CODE::XOR_Vx_Vy; break;
-        case 0x4: cpu.opcode = OP_CODE::ADD_Vx_Vy; break;
-        case 0x5: cpu.opcode = OP_CODE::SUB_Vx_Vy; break;
-        case 0x6: cpu.opcode = OP_CODE::SHR_Vx; break;
-        case 0x7: cpu.opcode = OP_CODE::SUBN_Vx_Vy; break;
-        case 0xE: cpu.opcode = OP_CODE::SHL_Vx; break;
-        default: break;
+  dispatch(fetch().instruction);
+}
+
+void Emulator::run(const int instructions) {
+#if defined(ARABICA_PROFILE)
+  if (profiler != nullptr) {
+    run_profiled(instructions);
+    return;
+  }
+#endif
+  if (aot.is_loaded()) {
+    run_aot(instructions);
+    return;
+  }
+
+#if defined(ARABICA_JIT)
+  // native blocks first, whatever they leave behind is interpreted one instruction at a time
+  for (int remaining = instructions; remaining > 0;) {
+    if (const int executed = jit.execute(remaining); executed > 0) {
+      remaining -= executed;
+      continue;
+    }
+
+    const auto& entry = fetch();
+    if (entry.idle != IDLE::NONE) {
+      remaining -= skip_idle(entry, remaining);
+    } else if (is_fusible(entry.superinstruction, remaining)) {
+      fused(entry.superinstruction);
+      remaining -= entry.superinstruction.length;
+    } else {
+      dispatch(entry.instruction);
+      --remaining;
+    }
+  }
+#elif defined(ARABICA_DISPATCH_THREADED)
+  // Threaded code: every handler jumps straight to the handler of the next instruction, so that each
+  // of them owns an indirect branch for the predictor instead of sharing the one of a dispatch loop.
+  #define ARABICA_LABEL_ENTRY(op_code, handler) &&label_##handler,
+  static void* const labels[] = {ARABICA_OP_CODE_LIST(ARABICA_LABEL_ENTRY) &&label_unknown};
+  #undef ARABICA_LABEL_ENTRY
+
+  int                       remaining = instructions;
+  const DecodeCache::Entry* entry     = nullptr;
+
+  #define ARABICA_DISPATCH_NEXT()                         \
+    if (remaining <= 0) {                                 \
+      return;                                             \
+    }                                                     \
+    entry = &fetch();                                     \
+    if (entry->idle != IDLE::NONE) {                      \
+      goto label_idle;                                    \
+    }                                                     \
+    if (is_fusible(entry->superinstruction, remaining)) { \
+      goto label_fused;                                   \
+    }                                                     \
+    --remaining;                                          \
+    goto* labels[entry->instruction.handler]
+
+  #define ARABICA_LABEL_HANDLER(op_code, handler)  \
+    label_##handler : handler(entry->instruction); \
+    ARABICA_DISPATCH_NEXT();
+
+  ARABICA_DISPATCH_NEXT();
+  ARABICA_OP_CODE_LIST(ARABICA_LABEL_HANDLER)
+  label_unknown : unknown(entry->instruction);
+  ARABICA_DISPATCH_NEXT();
+  label_fused : fused(entry->superinstruction);
+  remaining -= entry->superinstruction.length;
+  ARABICA_DISPATCH_NEXT();
+  label_idle : remaining -= skip_idle(*entry, remaining);
+  ARABICA_DISPATCH_NEXT();
+
+  #undef ARABICA_LABEL_HANDLER
+  #undef ARABICA_DISPATCH_NEXT
+#else
+  for (int remaining = instructions; remaining > 0;) {
+    const auto& entry = fetch();
+    if (entry.idle != IDLE::NONE) {
+      remaining -= skip_idle(entry, remaining);
+    } else if (is_fusible(entry.superinstruction, remaining)) {
+      fused(entry.superinstruction);
+      remaining -= entry.superinstruction.length;
+    } else {
+      dispatch(entry.instruction);
+      --remaining;
+    }
+  }
+#endif
+}
+
+#if defined(ARABICA_PROFILE)
+// One instruction at a time, timed on its own.
+void Emulator::run_profiled(const int instructions) {
+  const uint64_t overhead = profiler->overhead();
+  for (int remaining = instructions; remaining > 0; --remaining) {
+    const uint16_t pc    = cpu.pc;
+    const auto&    entry = fetch();
+    const auto     start = std::chrono::steady_clock::now();
+    dispatch(entry.instruction);
+    const uint64_t elapsed = std::chrono::nanoseconds(std::chrono::steady_clock::now() - start).count();
+    profiler->record(pc, entry.instruction, elapsed > overhead ? elapsed - overhead : 0);
+  }
+}
+#endif
+
+// Blocks translated ahead of time wherever the loaded program has one, the interpreter everywhere else.
+void Emulator::run_aot(const int instructions) {
+  for (int remaining = instructions; remaining > 0;) {
+    const auto& entry = fetch();
+    if (entry.idle != IDLE::NONE) {
+      remaining -= skip_idle(entry, remaining);
+    } else if (const auto* const block = aot.lookup(cpu.pc); block != nullptr && block->length <= remaining) {
+      block->function(*this);
+      remaining -= block->length;
+    } else {
+      dispatch(entry.instruction);
+      --remaining;
+    }
+  }
+}
+
+// Idle loops are only left on a timer tick or a key press, which happen between two `run`, so whatever
+// is left of `budget` is accounted for without executing it. Returns the number of instructions
+// accounted for, at least the one at `cpu.pc` is executed when the loop is about to be left.
+int Emulator::skip_idle(const DecodeCache::Entry& entry, const int budget) {
+  switch (entry.idle) {
+    case IDLE::KEY_WAIT: {
+      if (keypad.get_last_keypressed_code() != -1) {
+        dispatch(entry.instruction);
+        return 1;
       }
     } break;
-    case 0xE000: {
-      switch (cpu.instruction & 0x00FF) {
-        case 0x9E: cpu.opcode = OP_CODE::SKP_Vx; break;
-        case 0xA1: cpu.opcode = OP_CODE::SKNP_Vx; break;
-        default: break;
+    case IDLE::DELAY_POLL: {
+      // only whole iterations are skipped, Vx is left as the last of them sets it
+      const int     iterations = budget / 3;
+      const uint8_t compare    = decode_cache.fetch(cpu.pc + 2).kk;
+      if (iterations == 0 || delay.get() == compare) {
+        dispatch(entry.instruction);
+        return 1;
       }
+      cpu.registers[entry.instruction.x] = delay.get();
+      idle_cycles += iterations * 3;
+      return iterations * 3;
     }
-    case 0xF000: {
-      switch (cpu.instruction & 0x00FF) {
-        case 0x07: cpu.opcode = OP_CODE::LD_Vx_DT; break;
-        case 0x0A: cpu.opcode = OP_CODE::LD_Vx_K; break;
-        case 0x15: cpu.opcode = OP_CODE::LD_DT_Vx; break;
-        case 0x18: cpu.opcode = OP_CODE::LD_ST_Vx; break;
-        case 0x1E: cpu.opcode = OP_CODE::ADD_I_Vx; break;
-        case 0x29: cpu.opcode = OP_CODE::LD_F_Vx; break;
-        case 0x33: cpu.opcode = OP_CODE::LD_B_Vx; break;
-        case 0x55: cpu.opcode = OP_CODE::LD_I_Vx; break;
-        case 0x65: cpu.opcode = OP_CODE::LD_Vx_I; break;
-        default: break;
-      }
-    } break;
     default: break;
   }
+  idle_cycles += budget;
+  return budget;
+}
 
-  // The following comments are mostly taken from the Cowgod's Chip-8 Technical Reference v1.0.
-  // link: http://devernay.free.fr/hacks/chip8/C8TECH10.HTM
-  switch (cpu.opcode) {
-    // 0nnn - SYS addr
-    //
-    // Jump to a machine code routine at nnn.
-    //
-    // This instruction is only used on the old computers on which Chip-8 was
-    // originally implemented. It is ignored by modern interpreters.
-    case OP_CODE::SYS_addr: {
-      const uint16_t target = cpu.instruction & 0x0FFF;
-      cpu.pc                = target;
-    } break;
-    // 00E0 - CLS
-    //
-    // Clear the display.
-    case OP_CODE::CLS: {
-      display.reset();
-      display.is_refresh = true;
-      cpu.advance_pc();
-    } break;
-    // 1nnn - JP addr
-    //
-    // Jump to location nnn.
-    //
-    // The interpreter sets the program counter to nnn.
-    case OP_CODE::JP_addr: {
-      const uint16_t target = cpu.instruction & 0x0FFF;
-      cpu.pc                = target;
-    } break;
-    // 2nnn - CALL addr
-    //
-    // Call subroutine at nnn.
-    //
-    // The interpreter increments the stack pointer,
-    // then puts the current PC on the top of the stack.
-    // The PC is then set to nnn.
-    case OP_CODE::CALL_addr: {
-      cpu.stack.push(cpu.pc + 2);
-      const uint16_t target = cpu.instruction & 0x0FFF;
-      cpu.pc                = target;
-    } break;
-    // 00EE - RET
-    //
-    // Return from a subroutine.
-    //
-    // The interpreter sets the program counter to the address at the top of the stack,
-    // then subtracts 1 from the stack pointer.
-    case OP_CODE::RET: {
-      if (!cpu.stack.empty()) {
-        cpu.pc = cpu.stack.top();
-        cpu.stack.pop();
-      }
-    } break;
-    // 3xkk - SE Vx, byte
-    //
-    // Skip next instruction if Vx = kk.
-    //
-    // The interpreter compares register Vx to kk,
-    // and if they are equal, increments the program counter by 2.
-    case OP_CODE::SE_Vx_byte: {
-      const uint8_t x       = (cpu.instruction & 0x0F00) >> 8;
-      const uint8_t kk_byte = cpu.instruction & 0x00FF;
-
-      if (cpu.registers[x] == kk_byte) {
-        cpu.advance_pc();
-      }
-      cpu.advance_pc();
-    } break;
-    // 4xkk - SNE Vx, byte
-    //
-    // Skip next instruction if Vx != kk.
-    //
-    // The interpreter compares register Vx to kk,
-    // and if they are not equal, increments the program counter by 2.
-    case OP_CODE::SNE_Vx_byte: {
-      const uint8_t x       = (cpu.instruction & 0x0F00) >> 8;
-      const uint8_t kk_byte = cpu.instruction & 0x00FF;
-
-      if (cpu.registers[x] != kk_byte) {
-        cpu.advance_pc();
-      }
-      cpu.advance_pc();
-    } break;
-    // 5xy0 - SE Vx, Vy
-    //
-    // Skip next instruction if Vx = Vy.
-    //
-    // The interpreter compares register Vx to register Vy,
-    // and if they are equal, increments the program counter by 2.
-    case OP_CODE::SE_Vx_Vy: {
-      const uint8_t x = (cpu.instruction & 0x0F00) >> 8;
-      const uint8_t y = (cpu.instruction & 0x00F0) >> 4;
-
-      if (cpu.registers[x] == cpu.registers[y]) {
-        cpu.advance_pc();
-      }
-      cpu.advance_pc();
-    } break;
-    // 6xkk - LD Vx, byte
-    //
-    // Set Vx = kk.
-    //
-    // The interpreter puts the value kk into register Vx.
-    case OP_CODE::LD_Vx_byte: {
-      const uint8_t x       = (cpu.instruction & 0x0F00) >> 8;
-      const uint8_t kk_byte = cpu.instruction & 0x00FF;
-
-      cpu.registers[x] = kk_byte;
-      cpu.advance_pc();
-    } break;
-    // 7xkk - ADD Vx, byte
-    //
-    // Set Vx = Vx + kk.
-    //
-    // Adds the value kk to the value of register Vx,
-    // then stores the result in Vx.
-    case OP_CODE::ADD_Vx_byte: {
-      const uint8_t x       = (cpu.instruction & 0x0F00) >> 8;
-      const uint8_t kk_byte = cpu.instruction & 0x00FF;
-
-      cpu.registers[x] = cpu.registers[x] + kk_byte; // it will be wrapped if overflow occurs
-      cpu.advance_pc();
-    } break;
-    // 8xy0 - LD Vx, Vy
-    //
-    // Set Vx = Vy.
-    //
-    // Stores the value of register Vy in register Vx.
-    case OP_CODE::LD_Vx_Vy: {
-      const uint8_t x = (cpu.instruction & 0x0F00) >> 8;
-      const uint8_t y = (cpu.instruction & 0x00F0) >> 4;
-
-      cpu.registers[x] = cpu.registers[y];
-      cpu.advance_pc();
-    } break;
-    // 8xy1 - OR Vx, Vy
-    //
-    // Set Vx = Vx OR Vy.
-    //
-    // Performs a bitwise OR on the values of Vx and Vy, then stores the result in Vx.
-    // A bitwise OR compares the corrseponding bits from two values,
-    // and if either bit is 1, then the same bit in the result is also 1. Otherwise, it is 0.
-    case OP_CODE::OR_Vx_Vy: {
-      const uint8_t x = (cpu.instruction & 0x0F00) >> 8;
-      const uint8_t y = (cpu.instruction & 0x00F0) >> 4;
-
-      cpu.registers[x] |= cpu.registers[y];
-      cpu.advance_pc();
-    } break;
-    // 8xy2 - AND Vx, Vy
-    //
-    // Set Vx = Vx AND Vy.
-    //
-    // Performs a bitwise AND on the values of Vx and Vy, then stores the result in Vx.
-    // A bitwise AND compares the corrseponding bits from two values, and if both bits are 1,
-    // then the same bit in the result is also 1. Otherwise, it is 0.
-    case OP_CODE::AND_Vx_Vy: {
-      const uint8_t x = (cpu.instruction & 0x0F00) >> 8;
-      const uint8_t y = (cpu.instruction & 0x00F0) >> 4;
-
-      cpu.registers[x] &= cpu.registers[y];
-      cpu.advance_pc();
-    } break;
-    // 8xy3 - XOR Vx, Vy
-    //
-    // Set Vx = Vx XOR Vy.
-    //
-    // Performs a bitwise exclusive OR on the values of Vx and Vy, then stores the result in Vx.
-    // An exclusive OR compares the corrseponding bits from two values,
-    // and if the bits are not both the same, then the corresponding bit in the result is set to 1. Otherwise, it is 0.
-    case OP_CODE::XOR_Vx_Vy: {
-      const uint8_t x = (cpu.instruction & 0x0F00) >> 8;
-      const uint8_t y = (cpu.instruction & 0x00F0) >> 4;
-
-      cpu.registers[x] ^= cpu.registers[y];
-      cpu.advance_pc();
-    } break;
-    // 8xy4 - ADD Vx, Vy
-    //
-    // Set Vx = Vx + Vy, set VF = carry.
-    //
-    // The values of Vx and Vy are added together.
-    // If the result is greater than 8 bits (i.e., > 255,) VF is set to 1, otherwise 0.
-    // Only the lowest 8 bits of the result are kept, and stored in Vx.
-    case OP_CODE::ADD_Vx_Vy: {
-      const uint8_t x = (cpu.instruction & 0x0F00) >> 8;
-      const uint8_t y = (cpu.instruction & 0x00F0) >> 4;
-
-      const uint16_t sum = cpu.registers[x] + cpu.registers[y];
-      cpu.registers[0xF] = sum > 255;
-      cpu.registers[x]   = sum & 0xFF;
-
-      cpu.advance_pc();
-    } break;
-    // 8xy5 - SUB Vx, Vy
-    //
-    // Set Vx = Vx - Vy, set VF = NOT borrow.
-    //
-    // If Vx > Vy, then VF is set to 1, otherwise 0.
-    // Then Vy is subtracted from Vx, and the results stored in Vx.
-    case OP_CODE::SUB_Vx_Vy: {
-      const uint8_t x = (cpu.instruction & 0x0F00) >> 8;
-      const uint8_t y = (cpu.instruction & 0x00F0) >> 4;
-
-      cpu.registers[0xF] = cpu.registers[x] > cpu.registers[y];
-      cpu.registers[x]   = cpu.registers[x] - cpu.registers[y];
-
-      cpu.advance_pc();
-    } break;
-    // 8xy6 - SHR Vx {, Vy}
-    //
-    // Set Vx = Vx SHR 1.
-    //
-    // If the least-significant bit of Vx is 1, then VF is set to 1, otherwise 0. Then Vx is divided by 2.
-    case OP_CODE::SHR_Vx: {
-      // Remark: historically, the semantics is "right shift V[x] by V[y] amount
-      // and store the result to V[x]" in the original chip8 implementation, however, most of the game
-      // after 90s follows the buggy implementation of HP which ignoring V[y], so we just follow the same for now.
-      const uint8_t x = (cpu.instruction & 0x0F00) >> 8;
-
-      cpu.registers[0xF] = cpu.registers[x] & 1;
-      cpu.registers[x]   = cpu.registers[x] >> 1;
-
-      cpu.advance_pc();
-    } break;
-    // 8xy7 - SUBN Vx, Vy
-    //
-    // Set Vx = Vy - Vx, set VF = NOT borrow.
-    //
-    // If Vy > Vx, then VF is set to 1, otherwise 0.
-    // Then Vx is subtracted from Vy, and the results stored in Vx.
-    case OP_CODE::SUBN_Vx_Vy: {
-      const uint8_t x = (cpu.instruction & 0x0F00) >> 8;
-      const uint8_t y = (cpu.instruction & 0x00F0) >> 4;
-
-      cpu.registers[0xF] = cpu.registers[y] > cpu.registers[x];
-      cpu.registers[x]   = cpu.registers[y] - cpu.registers[x];
-
-      cpu.advance_pc();
-    } break;
-    // 8xyE - SHL Vx {, Vy}
-    //
-    // Set Vx = Vx SHL 1.
-    //
-    // If the most-significant bit of Vx is 1, then VF is set to 1, otherwise to 0. Then Vx is multiplied by 2.
-    case OP_CODE::SHL_Vx: {
-      // Remark: historically, the semantics is "left shift V[x] by V[y] amount
-      // and store the result to V[x]" in the original chip8 implementation, however, most of the game
-      // after 90s follows the buggy implementation of HP which ignoring V[y], so we just follow the same for now.
-      const uint8_t x = (cpu.instruction & 0x0F00) >> 8;
-
-      cpu.registers[0xF] = (cpu.registers[x] >> 7) & 1;
-      cpu.registers[x]   = cpu.registers[x] << 1;
-
-      cpu.advance_pc();
-    } break;
-    // 9xy0 - SNE Vx, Vy
-    //
-    // Skip next instruction if Vx != Vy.
-    //
-    // The values of Vx and Vy are compared, and if they are not equal, the program counter is increased by 2.
-    case OP_CODE::SNE_Vx_Vy: {
-      const uint8_t x = (cpu.instruction & 0x0F00) >> 8;
-      const uint8_t y = (cpu.instruction & 0x00F0) >> 4;
-
-      if (cpu.registers[x] != cpu.registers[y]) {
-        cpu.advance_pc();
+void Emulator::set_video_sink(VideoSink* const sink) {
+  video_sink = sink;
+}
+
+void Emulator::set_profiler(Profiler* const profiler) {
+  this->profiler = profiler;
+}
+
+void Emulator::set_fusion(const bool is_enable) {
+  decode_cache.set_fusion(is_enable);
+}
+
+const DecodeCache::Entry& Emulator::fetch() {
+  const auto& entry = decode_cache.lookup(cpu.pc);
+  cpu.instruction   = entry.instruction.word;
+  cpu.opcode        = entry.instruction.opcode;
+
+  trace::log<trace::Event::FETCH>(cpu.pc, cpu.instruction);
+
+  return entry;
+}
+
+#define ARABICA_HANDLER_ENTRY(op_code, handler) &Emulator::handler,
+const Emulator::Handler Emulator::handlers[] = {ARABICA_OP_CODE_LIST(ARABICA_HANDLER_ENTRY) &Emulator::unknown};
+#undef ARABICA_HANDLER_ENTRY
+
+void Emulator::dispatch(const Instruction& instruction) {
+#if defined(ARABICA_DISPATCH_SWITCH)
+  switch (instruction.opcode) {
+  #define ARABICA_CASE_HANDLER(op_code, handler) \
+    case OP_CODE::op_code: handler(instruction); break;
+    ARABICA_OP_CODE_LIST(ARABICA_CASE_HANDLER)
+  #undef ARABICA_CASE_HANDLER
+    default: unknown(instruction); break;
+  }
+#else
+  (this->*handlers[instruction.handler])(instruction);
+#endif
+}
+
+// The following comments are mostly taken from the Cowgod's Chip-8 Technical Reference v1.0, the
+// SUPER-CHIP ones from its section 3.2.
+// link: http://devernay.free.fr/hacks/chip8/C8TECH10.HTM
+
+// 0nnn - SYS addr
+//
+// Jump to a machine code routine at nnn.
+//
+// This instruction is only used on the old computers on which Chip-8 was
+// originally implemented. It is ignored by modern interpreters.
+void Emulator::sys_addr(const Instruction& instruction) {
+  const uint16_t target = instruction.nnn;
+  cpu.pc                = target;
+}
+
+// 00E0 - CLS
+//
+// Clear the display.
+void Emulator::cls(const Instruction&) {
+  display.reset();
+  display.is_refresh = true;
+  cpu.advance_pc();
+}
+
+// 1nnn - JP addr
+//
+// Jump to location nnn.
+//
+// The interpreter sets the program counter to nnn.
+void Emulator::jp_addr(const Instruction& instruction) {
+  const uint16_t target = instruction.nnn;
+  cpu.pc                = target;
+}
+
+// 2nnn - CALL addr
+//
+// Call subroutine at nnn.
+//
+// The interpreter increments the stack pointer,
+// then puts the current PC on the top of the stack.
+// The PC is then set to nnn.
+void Emulator::call_addr(const Instruction& instruction) {
+  cpu.stack.push(cpu.pc + 2);
+  const uint16_t target = instruction.nnn;
+  cpu.pc                = target;
+}
+
+// 00EE - RET
+//
+// Return from a subroutine.
+//
+// The interpreter sets the program counter to the address at the top of the stack,
+// then subtracts 1 from the stack pointer.
+void Emulator::ret(const Instruction&) {
+  if (!cpu.stack.empty()) {
+    cpu.pc = cpu.stack.top();
+    cpu.stack.pop();
+  }
+}
+
+// 3xkk - SE Vx, byte
+//
+// Skip next instruction if Vx = kk.
+//
+// The interpreter compares register Vx to kk,
+// and if they are equal, increments the program counter by 2.
+void Emulator::se_vx_byte(const Instruction& instruction) {
+  const uint8_t x       = instruction.x;
+  const uint8_t kk_byte = instruction.kk;
+
+  if (cpu.registers[x] == kk_byte) {
+    cpu.advance_pc();
+  }
+  cpu.advance_pc();
+}
+
+// 4xkk - SNE Vx, byte
+//
+// Skip next instruction if Vx != kk.
+//
+// The interpreter compares register Vx to kk,
+// and if they are not equal, increments the program counter by 2.
+void Emulator::sne_vx_byte(const Instruction& instruction) {
+  const uint8_t x       = instruction.x;
+  const uint8_t kk_byte = instruction.kk;
+
+  if (cpu.registers[x] != kk_byte) {
+    cpu.advance_pc();
+  }
+  cpu.advance_pc();
+}
+
+// 5xy0 - SE Vx, Vy
+//
+// Skip next instruction if Vx = Vy.
+//
+// The interpreter compares register Vx to register Vy,
+// and if they are equal, increments the program counter by 2.
+void Emulator::se_vx_vy(const Instruction& instruction) {
+  const uint8_t x = instruction.x;
+  const uint8_t y = instruction.y;
+
+  if (cpu.registers[x] == cpu.registers[y]) {
+    cpu.advance_pc();
+  }
+  cpu.advance_pc();
+}
+
+// 6xkk - LD Vx, byte
+//
+// Set Vx = kk.
+//
+// The interpreter puts the value kk into register Vx.
+void Emulator::ld_vx_byte(const Instruction& instruction) {
+  const uint8_t x       = instruction.x;
+  const uint8_t kk_byte = instruction.kk;
+
+  cpu.registers[x] = kk_byte;
+  cpu.advance_pc();
+}
+
+// 7xkk - ADD Vx, byte
+//
+// Set Vx = Vx + kk.
+//
+// Adds the value kk to the value of register Vx,
+// then stores the result in Vx.
+void Emulator::add_vx_byte(const Instruction& instruction) {
+  const uint8_t x       = instruction.x;
+  const uint8_t kk_byte = instruction.kk;
+
+  cpu.registers[x] = cpu.registers[x] + kk_byte; // it will be wrapped if overflow occurs
+  cpu.advance_pc();
+}
+
+// 8xy0 - LD Vx, Vy
+//
+// Set Vx = Vy.
+//
+// Stores the value of register Vy in register Vx.
+void Emulator::ld_vx_vy(const Instruction& instruction) {
+  const uint8_t x = instruction.x;
+  const uint8_t y = instruction.y;
+
+  cpu.registers[x] = cpu.registers[y];
+  cpu.advance_pc();
+}
+
+// 8xy1 - OR Vx, Vy
+//
+// Set Vx = Vx OR Vy.
+//
+// Performs a bitwise OR on the values of Vx and Vy, then stores the result in Vx.
+// A bitwise OR compares the corrseponding bits from two values,
+// and if either bit is 1, then the same bit in the result is also 1. Otherwise, it is 0.
+void Emulator::or_vx_vy(const Instruction& instruction) {
+  const uint8_t x = instruction.x;
+  const uint8_t y = instruction.y;
+
+  cpu.registers[x] |= cpu.registers[y];
+  cpu.advance_pc();
+}
+
+// 8xy2 - AND Vx, Vy
+//
+// Set Vx = Vx AND Vy.
+//
+// Performs a bitwise AND on the values of Vx and Vy, then stores the result in Vx.
+// A bitwise AND compares the corrseponding bits from two values, and if both bits are 1,
+// then the same bit in the result is also 1. Otherwise, it is 0.
+void Emulator::and_vx_vy(const Instruction& instruction) {
+  const uint8_t x = instruction.x;
+  const uint8_t y = instruction.y;
+
+  cpu.registers[x] &= cpu.registers[y];
+  cpu.advance_pc();
+}
+
+// 8xy3 - XOR Vx, Vy
+//
+// Set Vx = Vx XOR Vy.
+//
+// Performs a bitwise exclusive OR on the values of Vx and Vy, then stores the result in Vx.
+// An exclusive OR compares the corrseponding bits from two values,
+// and if the bits are not both the same, then the corresponding bit in the result is set to 1. Otherwise, it is 0.
+void Emulator::xor_vx_vy(const Instruction& instruction) {
+  const uint8_t x = instruction.x;
+  const uint8_t y = instruction.y;
+
+  cpu.registers[x] ^= cpu.registers[y];
+  cpu.advance_pc();
+}
+
+// 8xy4 - ADD Vx, Vy
+//
+// Set Vx = Vx + Vy, set VF = carry.
+//
+// The values of Vx and Vy are added together.
+// If the result is greater than 8 bits (i.e., > 255,) VF is set to 1, otherwise 0.
+// Only the lowest 8 bits of the result are kept, and stored in Vx.
+void Emulator::add_vx_vy(const Instruction& instruction) {
+  const uint8_t x = instruction.x;
+  const uint8_t y = instruction.y;
+
+  const uint16_t sum = cpu.registers[x] + cpu.registers[y];
+  cpu.registers[0xF] = sum > 255;
+  cpu.registers[x]   = sum & 0xFF;
+
+  cpu.advance_pc();
+}
+
+// 8xy5 - SUB Vx, Vy
+//
+// Set Vx = Vx - Vy, set VF = NOT borrow.
+//
+// If Vx > Vy, then VF is set to 1, otherwise 0.
+// Then Vy is subtracted from Vx, and the results stored in Vx.
+void Emulator::sub_vx_vy(const Instruction& instruction) {
+  const uint8_t x = instruction.x;
+  const uint8_t y = instruction.y;
+
+  cpu.registers[0xF] = cpu.registers[x] > cpu.registers[y];
+  cpu.registers[x]   = cpu.registers[x] - cpu.registers[y];
+
+  cpu.advance_pc();
+}
+
+// 8xy6 - SHR Vx {, Vy}
+//
+// Set Vx = Vx SHR 1.
+//
+// If the least-significant bit of Vx is 1, then VF is set to 1, otherwise 0. Then Vx is divided by 2.
+void Emulator::shr_vx(const Instruction& instruction) {
+  // Remark: historically, the semantics is "right shift V[x] by V[y] amount
+  // and store the result to V[x]" in the original chip8 implementation, however, most of the game
+  // after 90s follows the buggy implementation of HP which ignoring V[y], so we just follow the same for now.
+  const uint8_t x = instruction.x;
+
+  cpu.registers[0xF] = cpu.registers[x] & 1;
+  cpu.registers[x]   = cpu.registers[x] >> 1;
+
+  cpu.advance_pc();
+}
+
+// 8xy7 - SUBN Vx, Vy
+//
+// Set Vx = Vy - Vx, set VF = NOT borrow.
+//
+// If Vy > Vx, then VF is set to 1, otherwise 0.
+// Then Vx is subtracted from Vy, and the results stored in Vx.
+void Emulator::subn_vx_vy(const Instruction& instruction) {
+  const uint8_t x = instruction.x;
+  const uint8_t y = instruction.y;
+
+  cpu.registers[0xF] = cpu.registers[y] > cpu.registers[x];
+  cpu.registers[x]   = cpu.registers[y] - cpu.registers[x];
+
+  cpu.advance_pc();
+}
+
+// 8xyE - SHL Vx {, Vy}
+//
+// Set Vx = Vx SHL 1.
+//
+// If the most-significant bit of Vx is 1, then VF is set to 1, otherwise to 0. Then Vx is multiplied by 2.
+void Emulator::shl_vx(const Instruction& instruction) {
+  // Remark: historically, the semantics is "left shift V[x] by V[y] amount
+  // and store the result to V[x]" in the original chip8 implementation, however, most of the game
+  // after 90s follows the buggy implementation of HP which ignoring V[y], so we just follow the same for now.
+  const uint8_t x = instruction.x;
+
+  cpu.registers[0xF] = (cpu.registers[x] >> 7) & 1;
+  cpu.registers[x]   = cpu.registers[x] << 1;
+
+  cpu.advance_pc();
+}
+
+// 9xy0 - SNE Vx, Vy
+//
+// Skip next instruction if Vx != Vy.
+//
+// The values of Vx and Vy are compared, and if they are not equal, the program counter is increased by 2.
+void Emulator::sne_vx_vy(const Instruction& instruction) {
+  const uint8_t x = instruction.x;
+  const uint8_t y = instruction.y;
+
+  if (cpu.registers[x] != cpu.registers[y]) {
+    cpu.advance_pc();
+  }
+  cpu.advance_pc();
+}
+
+// Annn - LD I, addr
+//
+// Set I = nnn.
+//
+// The value of register I is set to nnn.
+void Emulator::ld_i_addr(const Instruction& instruction) {
+  const uint16_t data = instruction.nnn;
+  cpu.reg_I           = data;
+  cpu.advance_pc();
+}
+
+// Bnnn - JP V0, addr
+//
+// Jump to location nnn + V0.
+//
+// The program counter is set to nnn plus the value of V0.
+void Emulator::jp_v0_addr(const Instruction& instruction) {
+  const uint16_t base_address = instruction.nnn;
+  cpu.pc                      = base_address;
+  cpu.advance_pc(cpu.registers[0]);
+}
+
+// Cxkk - RND Vx, byte
+//
+// Set Vx = random byte AND kk.
+//
+// The interpreter generates a random number from 0 to 255,
+// which is then ANDed with the value kk. The results are stored in Vx.
+void Emulator::rnd_vx_byte(const Instruction& instruction) {
+  const uint8_t x         = instruction.x;
+  const uint8_t kk_byte   = instruction.kk;
+  const uint8_t rand_byte = random.next_byte();
+
+  cpu.registers[x] = rand_byte & kk_byte;
+
+  cpu.advance_pc();
+}
+
+// Fx07 - LD Vx, DT
+//
+// Set Vx = delay timer value.
+//
+// The value of DT is placed into Vx.
+void Emulator::ld_vx_dt(const Instruction& instruction) {
+  const uint8_t x  = instruction.x;
+  cpu.registers[x] = delay.get();
+  cpu.advance_pc();
+}
+
+// Fx15 - LD DT, Vx
+//
+// Set delay timer = Vx.
+//
+// DT is set equal to the value of Vx.
+void Emulator::ld_dt_vx(const Instruction& instruction) {
+  const uint8_t x = instruction.x;
+  delay.set(cpu.registers[x]);
+  cpu.advance_pc();
+}
+
+// Fx18 - LD ST, Vx
+//
+// Set sound timer = Vx.
+//
+// ST is set equal to the value of Vx.
+void Emulator::ld_st_vx(const Instruction& instruction) {
+  const uint8_t x = instruction.x;
+  cpu.reg_sound   = cpu.registers[x];
+  sound.frequency = cpu.reg_sound;
+  if (sound.frequency > 0) {
+    sound.start_beep();
+  }
+  cpu.advance_pc();
+}
+
+// Fx1E - ADD I, Vx
+//
+// Set I = I + Vx.
+//
+// The values of I and Vx are added, and the results are stored in I.
+void Emulator::add_i_vx(const Instruction& instruction) {
+  const uint8_t x = instruction.x;
+  cpu.reg_I       = cpu.reg_I + cpu.registers[x];
+  cpu.advance_pc();
+}
+
+// Fx0A - LD Vx, K
+//
+// Wait for a key press, store the value of the key in Vx.
+//
+// All execution stops until a key is pressed, then the value of that key is stored in Vx.
+void Emulator::ld_vx_k(const Instruction& instruction) {
+  const uint8_t x = instruction.x;
+
+  const auto keycode = keypad.get_last_keypressed_code();
+  if (keycode != -1) {
+    cpu.registers[x] = keycode;
+    cpu.advance_pc();
+  }
+}
+
+// Ex9E - SKP Vx
+//
+// Skip next instruction if key with the value of Vx is pressed.
+//
+// Checks the keyboard, and if the key corresponding to the value of Vx is currently in the down position, PC is
+// increased by 2.
+void Emulator::skp_vx(const Instruction& instruction) {
+  const uint8_t x = instruction.x;
+
+  if (keypad.is_keypressed(cpu.registers[x])) {
+    cpu.advance_pc();
+  }
+  cpu.advance_pc();
+}
+
+// ExA1 - SKNP Vx
+//
+// Skip next instruction if key with the value of Vx is not pressed.
+//
+// Checks the keyboard, and if the key corresponding to the value of Vx is currently in the up position, PC is
+// increased by 2.
+void Emulator::sknp_vx(const Instruction& instruction) {
+  const uint8_t x = instruction.x;
+
+  if (!keypad.is_keypressed(cpu.registers[x])) {
+    cpu.advance_pc();
+  }
+  cpu.advance_pc();
+}
+
+// Dxyn - DRW Vx, Vy, nibble
+//
+// Display n-byte sprite starting at memory location I at (Vx, Vy), set VF = collision.
+//
+// The interpreter reads n bytes from memory, starting at the address stored in I.
+// These bytes are then displayed as sprites on screen at coordinates (Vx, Vy).
+// Sprites are XORed onto the existing screen.
+// If this causes any pixels to be erased, VF is set to 1, otherwise it is set to 0.
+// If the sprite is positioned so part of it is outside the coordinates of the display,
+// it wraps around to the opposite side of the screen.
+//
+// Dxy0 - DRW Vx, Vy, 0
+//
+// Show 16x16 sprite, SUPER-CHIP. It is read from 32 bytes at I, two per row, in either resolution.
+void Emulator::drw_vx_vy_nibble(const Instruction& instruction) {
+  draw(instruction.x, instruction.y, instruction.n);
+  cpu.advance_pc();
+}
+
+// Fx29 - LD F, Vx
+//
+// Set I = location of sprite for digit Vx.
+//
+// The value of I is set to the location for the hexadecimal sprite corresponding to the value of Vx.
+void Emulator::ld_f_vx(const Instruction& instruction) {
+  const uint8_t x = instruction.x;
+  cpu.reg_I       = cpu.registers[x] * 0x5;
+  cpu.advance_pc();
+}
+
+// Fx33 - LD B, Vx
+//
+// Store BCD representation of Vx in memory locations I, I+1, and I+2.
+//
+// The interpreter takes the decimal value of Vx, and
+// places the hundreds digit in memory at location in I,
+// the tens digit at location I + 1,
+// and the ones digit at location I + 2.
+void Emulator::ld_b_vx(const Instruction& instruction) {
+  const uint8_t x = instruction.x;
+
+  const auto rx         = cpu.registers[x];
+  memory[cpu.reg_I + 0] = (rx % 1000) / 100;
+  memory[cpu.reg_I + 1] = (rx % 100) / 10;
+  memory[cpu.reg_I + 2] = (rx % 10);
+  cpu.advance_pc();
+}
+
+// Fx55 - LD [I], Vx
+//
+// Store registers V0 through Vx in memory starting at location I.
+//
+// The interpreter copies the values of registers V0 through Vx into memory, starting at the address in I.
+void Emulator::ld_i_vx(const Instruction& instruction) {
+  const uint8_t x = instruction.x;
+
+  for (int i = 0; i <= x; i++) {
+    memory[cpu.reg_I + i] = cpu.registers[i];
+  }
+  cpu.advance_pc();
+}
+
+// Fx65 - LD Vx, [I]
+//
+// Read registers V0 through Vx from memory starting at location I.
+//
+// The interpreter reads values from memory starting at location I into registers V0 through Vx.
+void Emulator::ld_vx_i(const Instruction& instruction) {
+  const uint8_t x = instruction.x;
+
+  for (int i = 0; i <= x; i++) {
+    cpu.registers[i] = std::as_const(memory)[cpu.reg_I + i];
+  }
+  cpu.advance_pc();
+}
+
+// 00Cn - SCD nibble
+//
+// Scroll display N lines down.
+//
+// The rows are counted in the current resolution, blank rows come in at the top.
+void Emulator::scd_nibble(const Instruction& instruction) {
+  display.scroll_down(instruction.n);
+  display.is_refresh = true;
+  cpu.advance_pc();
+}
+
+// 00FB - SCR
+//
+// Scroll display 4 pixels right.
+void Emulator::scr(const Instruction&) {
+  display.scroll_right(4);
+  display.is_refresh = true;
+  cpu.advance_pc();
+}
+
+// 00FC - SCL
+//
+// Scroll display 4 pixels left.
+void Emulator::scl(const Instruction&) {
+  display.scroll_left(4);
+  display.is_refresh = true;
+  cpu.advance_pc();
+}
+
+// 00FD - EXIT
+//
+// Exit the interpreter.
+//
+// The program counter stays on it, so the machine idles from then on like on `JP` to itself.
+void Emulator::exit(const Instruction&) {
+}
+
+// 00FE - LOW
+//
+// Disable extended screen mode.
+void Emulator::low(const Instruction&) {
+  display.set_hires(false);
+  display.is_refresh = true;
+  cpu.advance_pc();
+}
+
+// 00FF - HIGH
+//
+// Enable extended screen mode for full-screen graphics.
+void Emulator::high(const Instruction&) {
+  display.set_hires(true);
+  display.is_refresh = true;
+  cpu.advance_pc();
+}
+
+// Fx30 - LD HF, Vx
+//
+// Set I = location of the 10-byte sprite for digit Vx.
+void Emulator::ld_hf_vx(const Instruction& instruction) {
+  const uint8_t x = instruction.x;
+  cpu.reg_I       = Memory::BIG_FONT + (cpu.registers[x] & 0xF) * 10;
+  cpu.advance_pc();
+}
+
+// Fx75 - LD R, Vx
+//
+// Store V0..Vx in RPL user flags (x <= 7).
+void Emulator::ld_r_vx(const Instruction& instruction) {
+  const uint8_t x = std::min<uint8_t>(instruction.x, CPU::RPL_COUNT - 1);
+
+  for (int i = 0; i <= x; i++) {
+    cpu.rpl[i] = cpu.registers[i];
+  }
+  cpu.advance_pc();
+}
+
+// Fx85 - LD Vx, R
+//
+// Read V0..Vx from RPL user flags (x <= 7).
+void Emulator::ld_vx_r(const Instruction& instruction) {
+  const uint8_t x = std::min<uint8_t>(instruction.x, CPU::RPL_COUNT - 1);
+
+  for (int i = 0; i <= x; i++) {
+    cpu.registers[i] = cpu.rpl[i];
+  }
+  cpu.advance_pc();
+}
+
+// Superinstructions, see `FUSION` for the sequences they stand for.
+void Emulator::fused(const Superinstruction& superinstruction) {
+  const uint8_t x = superinstruction.x;
+
+  switch (superinstruction.kind) {
+    case FUSION::LD_I_DRW: {
+      cpu.reg_I = superinstruction.nnn;
+      draw(x, superinstruction.y, superinstruction.n);
+      cpu.advance_pc(4);
+    } break;
+    case FUSION::LD_Vx_DT: {
+      cpu.registers[x] = superinstruction.kk;
+      delay.set(superinstruction.kk);
+      cpu.advance_pc(4);
+    } break;
+    case FUSION::ADD_SE_JP: {
+      cpu.registers[x] = cpu.registers[x] + superinstruction.kk;
+      if (cpu.registers[x] == superinstruction.compare) {
+        cpu.advance_pc(6);
+      } else {
+        cpu.pc = superinstruction.nnn;
       }
-      cpu.advance_pc();
     } break;
-    // Annn - LD I, addr
-    //
-    // Set I = nnn.
-    //
-    // The value of register I is set to nnn.
-    case OP_CODE::LD_I_addr: {
-      const uint16_t data = (cpu.instruction & 0x0FFF);
-      cpu.reg_I           = data;
-      cpu.advance_pc();
-    } break;
-    // Bnnn - JP V0, addr
-    //
-    // Jump to location nnn + V0.
-    //
-    // The program counter is set to nnn plus the value of V0.
-    case OP_CODE::JP_V0_addr: {
-      const uint16_t base_address = (cpu.instruction & 0x0FFF);
-      cpu.pc                      = base_address;
-      cpu.advance_pc(cpu.registers[0]);
-    } break;
-    // Cxkk - RND Vx, byte
-    //
-    // Set Vx = random byte AND kk.
-    //
-    // The interpreter generates a random number from 0 to 255,
-    // which is then ANDed with the value kk. The results are stored in Vx.
-    case OP_CODE::RND_Vx_byte: {
-      const uint8_t x         = (cpu.instruction & 0x0F00) >> 8;
-      const uint8_t kk_byte   = (cpu.instruction & 0x00FF);
-      const uint8_t rand_byte = random(0, 255);
-
-      cpu.registers[x] = rand_byte & kk_byte;
-
-      cpu.advance_pc();
-    } break;
-    // Fx07 - LD Vx, DT
-    //
-    // Set Vx = delay timer value.
-    //
-    // The value of DT is placed into Vx.
-    case OP_CODE::LD_Vx_DT: {
-      const uint8_t x  = (cpu.instruction & 0x0F00) >> 8;
+    case FUSION::DT_SE_JP: {
       cpu.registers[x] = delay.get();
-      cpu.advance_pc();
-    } break;
-    // Fx15 - LD DT, Vx
-    //
-    // Set delay timer = Vx.
-    //
-    // DT is set equal to the value of Vx.
-    case OP_CODE::LD_DT_Vx: {
-      const uint8_t x = (cpu.instruction & 0x0F00) >> 8;
-      delay.set(cpu.registers[x]);
-      cpu.advance_pc();
-    } break;
-    // Fx18 - LD ST, Vx
-    //
-    // Set sound timer = Vx.
-    //
-    // ST is set equal to the value of Vx.
-    case OP_CODE::LD_ST_Vx: {
-      const uint8_t x = (cpu.instruction & 0x0F00) >> 8;
-      cpu.reg_sound   = cpu.registers[x];
-      sound.frequency = cpu.reg_sound;
-      if (sound.frequency > 0) {
-        sound.start_beep();
-      }
-      cpu.advance_pc();
-    } break;
-    // Fx1E - ADD I, Vx
-    //
-    // Set I = I + Vx.
-    //
-    // The values of I and Vx are added, and the results are stored in I.
-    case OP_CODE::ADD_I_Vx: {
-      const uint8_t x = (cpu.instruction & 0x0F00) >> 8;
-      cpu.reg_I       = cpu.reg_I + cpu.registers[x];
-      cpu.advance_pc();
-    } break;
-    // Fx0A - LD Vx, K
-    //
-    // Wait for a key press, store the value of the key in Vx.
-    //
-    // All execution stops until a key is pressed, then the value of that key is stored in Vx.
-    case OP_CODE::LD_Vx_K: {
-      const uint8_t x = (cpu.instruction & 0x0F00) >> 8;
-
-      const auto keycode = keypad.get_last_keypressed_code();
-      if (keycode != -1) {
-        cpu.registers[x] = keycode;
-        cpu.advance_pc();
-      }
-    } break;
-    // Ex9E - SKP Vx
-    //
-    // Skip next instruction if key with the value of Vx is pressed.
-    //
-    // Checks the keyboard, and if the key corresponding to the value of Vx is currently in the down position, PC is
-    // increased by 2.
-    case OP_CODE::SKP_Vx: {
-      const uint8_t x = (cpu.instruction & 0x0F00) >> 8;
-
-      if (keypad.is_keypressed(cpu.registers[x])) {
-        cpu.advance_pc();
-      }
-      cpu.advance_pc();
-    } break;
-    // ExA1 - SKNP Vx
-    //
-    // Skip next instruction if key with the value of Vx is not pressed.
-    //
-    // Checks the keyboard, and if the key corresponding to the value of Vx is currently in the up position, PC is
-    // increased by 2.
-    case OP_CODE::SKNP_Vx: {
-      const uint8_t x = (cpu.instruction & 0x0F00) >> 8;
-
-      if (!keypad.is_keypressed(cpu.registers[x])) {
-        cpu.advance_pc();
-      }
-      cpu.advance_pc();
-    } break;
-    // Dxyn - DRW Vx, Vy, nibble
-    //
-    // Display n-byte sprite starting at memory location I at (Vx, Vy), set VF = collision.
-    //
-    // The interpreter reads n bytes from memory, starting at the address stored in I.
-    // These bytes are then displayed as sprites on screen at coordinates (Vx, Vy).
-    // Sprites are XORed onto the existing screen.
-    // If this causes any pixels to be erased, VF is set to 1, otherwise it is set to 0.
-    // If the sprite is positioned so part of it is outside the coordinates of the display,
-    // it wraps around to the opposite side of the screen.
-    case OP_CODE::DRW_Vx_Vy_nibble: {
-      const uint8_t x      = (cpu.instruction & 0x0F00) >> 8;
-      const uint8_t y      = (cpu.instruction & 0x00F0) >> 4;
-      const uint8_t nibble = cpu.instruction & 0x000F;
-
-      std::vector<uint8_t> sprite_data;
-      for (int i = 0; i < nibble; ++i) {
-        sprite_data.push_back(memory.read(cpu.reg_I + i));
+      if (cpu.registers[x] == superinstruction.compare) {
+        cpu.advance_pc(6);
+      } else {
+        cpu.pc = superinstruction.nnn;
       }
-      cpu.registers[0xF] = display.update(cpu.registers[x], cpu.registers[y], sprite_data);
-      display.is_refresh = true;
-      cpu.advance_pc();
-    } break;
-    // Fx29 - LD F, Vx
-    //
-    // Set I = location of sprite for digit Vx.
-    //
-    // The value of I is set to the location for the hexadecimal sprite corresponding to the value of Vx.
-    case OP_CODE::LD_F_Vx: {
-      const uint8_t x = (cpu.instruction & 0x0F00) >> 8;
-      cpu.reg_I       = cpu.registers[x] * 0x5;
-      cpu.advance_pc();
-    } break;
-    // Fx33 - LD B, Vx
-    //
-    // Store BCD representation of Vx in memory locations I, I+1, and I+2.
-    //
-    // The interpreter takes the decimal value of Vx, and
-    // places the hundreds digit in memory at location in I,
-    // the tens digit at location I + 1,
-    // and the ones digit at location I + 2.
-    case OP_CODE::LD_B_Vx: {
-      const uint8_t x = (cpu.instruction & 0x0F00) >> 8;
-
-      const auto rx         = cpu.registers[x];
-      memory[cpu.reg_I + 0] = (rx % 1000) / 100;
-      memory[cpu.reg_I + 1] = (rx % 100) / 10;
-      memory[cpu.reg_I + 2] = (rx % 10);
-      cpu.advance_pc();
-    } break;
-    // Fx55 - LD [I], Vx
-    //
-    // Store registers V0 through Vx in memory starting at location I.
-    //
-    // The interpreter copies the values of registers V0 through Vx into memory, starting at the address in I.
-    case OP_CODE::LD_I_Vx: {
-      const uint8_t x = (cpu.instruction & 0x0F00) >> 8;
-
-      for (int i = 0; i <= x; i++) {
-        memory[cpu.reg_I + i] = cpu.registers[i];
-      }
-      cpu.advance_pc();
-    } break;
-    // Fx65 - LD Vx, [I]
-    //
-    // Read registers V0 through Vx from memory starting at location I.
-    //
-    // The interpreter reads values from memory starting at location I into registers V0 through Vx.
-    case OP_CODE::LD_Vx_I: {
-      const uint8_t x = (cpu.instruction & 0x0F00) >> 8;
-
-      for (int i = 0; i <= x; i++) {
-        cpu.registers[i] = memory[cpu.reg_I + i];
-      }
-      cpu.advance_pc();
-    } break;
-    default: {
-      log_info("Unknown opcode: 0x{:X}\n", static_cast<uint16_t>(cpu.opcode));
     } break;
+    default: break;
+  }
+}
+
+void Emulator::draw(const uint8_t x, const uint8_t y, const uint8_t nibble) {
+  uint8_t   sprite[32];
+  const int size = nibble == 0 ? 32 : nibble;
+  for (int i = 0; i < size; ++i) {
+    sprite[i] = std::as_const(memory)[cpu.reg_I + i];
   }
+  cpu.registers[0xF] = nibble == 0 ? display.update_large(cpu.registers[x], cpu.registers[y], sprite)
+                                   : display.update(cpu.registers[x], cpu.registers[y], sprite, nibble);
+  display.is_refresh = true;
+}
+
+void Emulator::unknown(const Instruction& instruction) {
+  trace::log<trace::Event::UNKNOWN>(instruction.word, cpu.pc);
 }
 
 } // namespace arabica
@@ -1,13 +1,31 @@
 #pragma once
 
+#include <arabica/aot/runtime.hpp>
 #include <arabica/cpu/cpu.hpp>
+#include <arabica/cpu/decode_cache.hpp>
 #include <arabica/memory/memory.hpp>
 #include <arabica/device/keypad.hpp>
 #include <arabica/device/display.hpp>
+#include <arabica/device/sink.hpp>
 #include <arabica/device/sound.hpp>
 #include <arabica/device/delay.hpp>
-#include <fmt/core.h>
-#include <random>
+#include <arabica/device/random.hpp>
+#include <arabica/emulator/machine_state.hpp>
+#include <arabica/emulator/profiler.hpp>
+#include <arabica/jit/jit.hpp>
+#include <arabica/trace/trace.hpp>
+
+// The instruction dispatch engine is picked at build time, see `ARABICA_DISPATCH` in CMakeLists.txt.
+// The plain switch is the fallback when nothing is selected.
+#if !defined(ARABICA_DISPATCH_SWITCH) && !defined(ARABICA_DISPATCH_TABLE) && !defined(ARABICA_DISPATCH_THREADED)
+  #define ARABICA_DISPATCH_SWITCH
+#endif
+
+// computed goto is a GNU extension
+#if defined(ARABICA_DISPATCH_THREADED) && !defined(__GNUC__)
+  #undef ARABICA_DISPATCH_THREADED
+  #define ARABICA_DISPATCH_TABLE
+#endif
 
 namespace arabica {
 
@@ -15,19 +33,46 @@ class Emulator {
 public:
   Emulator()
     : cycle(0)
-    , is_enable_log(false)
-    , cpu(memory) {
+    , cpu(memory)
+    , decode_cache(memory)
+    , aot(memory)
+#if defined(ARABICA_JIT)
+    , jit(cpu, memory, decode_cache)
+#endif
+  {
   }
 
-  bool init();
   bool load(const std::string& rom);
+  bool load(const std::vector<uint8_t>& rom);
+  bool load(const aot::Program& program);
   void single_step();
+  void run(const int instructions);
   void execute();
 
-  int  fps                    = 60;         // 60 FPS = 60 (Frames Per Second) = 60 (frames) / 1 (second)
-  int  milliseconds_per_frame = 1000 / fps; // (FPS)^{-1} = 1 (s) / 60 (frames) = 1000 (milliseconds) / 60 (frames)
-  int  cycle                  = 0;
-  bool is_enable_log          = false;
+  // One frame with `events`, sorted by instruction, applied to the keypad that many instructions into
+  // it. A frame without any runs in one go, exactly like `execute()`.
+  void execute(const KeyEvent* const events, const std::size_t count);
+  void set_fusion(const bool is_enable);
+  void set_video_sink(VideoSink* const sink);
+
+  // Every instruction is counted and timed in `profiler` from now on, nullptr stops it. Without
+  // `ARABICA_PROFILE` the profiler is compiled out and left alone, see `Profiler::IS_COMPILED_IN`.
+  void set_profiler(Profiler* const profiler);
+
+  // The whole machine in and out of a `MachineState`. Restoring only reports the memory range that
+  // differs to the caches and only repaints a screen that differs, so going back and forth between
+  // nearby states is cheap.
+  MachineState snapshot() const;
+  void         snapshot(MachineState& state) const;
+  void         restore(const MachineState& state);
+
+  // Executes `instruction` as if it was fetched from `cpu.pc`.
+  void dispatch(const Instruction& instruction);
+
+  int   fps             = 60;   // 60 FPS = 60 (Frames Per Second) = 60 (frames) / 1 (second), see `Pacer`
+  int   cycle           = 0;
+  int   idle_cycles     = 0;    // instructions of the current frame skipped in idle loops
+  float idle_percentage = 0.0f; // share of the last frame spent in idle loops
 
   CPU     cpu;
   Memory  memory;
@@ -35,23 +80,79 @@ public:
   Display display;
   Sound   sound;
   Delay   delay;
+  Random  random;
 
 private:
-  template<typename T>
-  inline T random(T range_from, T range_to) {
-    std::random_device               rand_dev;
-    std::mt19937                     generator(rand_dev());
-    std::uniform_int_distribution<T> distr(range_from, range_to);
-    return distr(generator);
-  }
+  using Handler = void (Emulator::*)(const Instruction& instruction);
+
+  static const Handler handlers[HANDLER_COUNT + 1];
+
+  const DecodeCache::Entry& fetch();
+  void                      fused(const Superinstruction& superinstruction);
+  void                      draw(const uint8_t x, const uint8_t y, const uint8_t nibble);
+  void                      run_aot(const int instructions);
+  int                       skip_idle(const DecodeCache::Entry& entry, const int budget);
+#if defined(ARABICA_PROFILE)
+  void run_profiled(const int instructions);
+#endif
 
-  template<typename... Args>
-  inline void log_info(const char* const format, const Args&... args) {
-    if (is_enable_log) {
-      fmt::print("[emulator log] ");
-      fmt::print(format, args...);
-    }
+  bool is_fusible(const Superinstruction& superinstruction, const int budget) const {
+    return superinstruction.kind != FUSION::NONE && superinstruction.length <= budget;
   }
+
+  void cls(const Instruction& instruction);
+  void ret(const Instruction& instruction);
+  void sys_addr(const Instruction& instruction);
+  void jp_addr(const Instruction& instruction);
+  void call_addr(const Instruction& instruction);
+  void se_vx_byte(const Instruction& instruction);
+  void sne_vx_byte(const Instruction& instruction);
+  void se_vx_vy(const Instruction& instruction);
+  void ld_vx_byte(const Instruction& instruction);
+  void add_vx_byte(const Instruction& instruction);
+  void ld_vx_vy(const Instruction& instruction);
+  void or_vx_vy(const Instruction& instruction);
+  void and_vx_vy(const Instruction& instruction);
+  void xor_vx_vy(const Instruction& instruction);
+  void add_vx_vy(const Instruction& instruction);
+  void sub_vx_vy(const Instruction& instruction);
+  void shr_vx(const Instruction& instruction);
+  void subn_vx_vy(const Instruction& instruction);
+  void shl_vx(const Instruction& instruction);
+  void sne_vx_vy(const Instruction& instruction);
+  void ld_i_addr(const Instruction& instruction);
+  void jp_v0_addr(const Instruction& instruction);
+  void rnd_vx_byte(const Instruction& instruction);
+  void drw_vx_vy_nibble(const Instruction& instruction);
+  void skp_vx(const Instruction& instruction);
+  void sknp_vx(const Instruction& instruction);
+  void ld_vx_dt(const Instruction& instruction);
+  void ld_vx_k(const Instruction& instruction);
+  void ld_dt_vx(const Instruction& instruction);
+  void ld_st_vx(const Instruction& instruction);
+  void add_i_vx(const Instruction& instruction);
+  void ld_f_vx(const Instruction& instruction);
+  void ld_b_vx(const Instruction& instruction);
+  void ld_i_vx(const Instruction& instruction);
+  void ld_vx_i(const Instruction& instruction);
+  void scd_nibble(const Instruction& instruction);
+  void scr(const Instruction& instruction);
+  void scl(const Instruction& instruction);
+  void exit(const Instruction& instruction);
+  void low(const Instruction& instruction);
+  void high(const Instruction& instruction);
+  void ld_hf_vx(const Instruction& instruction);
+  void ld_r_vx(const Instruction& instruction);
+  void ld_vx_r(const Instruction& instruction);
+  void unknown(const Instruction& instruction);
+
+  DecodeCache  decode_cache;
+  aot::Runtime aot;
+  VideoSink*   video_sink{nullptr};
+  Profiler*    profiler{nullptr};
+#if defined(ARABICA_JIT)
+  Jit jit;
+#endif
 };
 
 } // namespace arabica
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <arabica/cpu/cpu.hpp>
+#include <arabica/cpu/stack.hpp>
+#include <arabica/device/display.hpp>
+#include <arabica/memory/memory.hpp>
+#include <cstdint>
+#include <type_traits>
+
+namespace arabica {
+
+// Everything a running machine is made of, as plain data: a snapshot is a `memcpy` of a few KB, and
+// as the layout has no padding two snapshots of the same machine compare equal byte for byte.
+//
+// The host side of the emulator (sinks, caches, the scaled display buffer) is not part of it.
+struct MachineState {
+  uint8_t  registers[CPU::REGISTER_COUNT];
+  uint16_t reg_I;
+  uint16_t pc;
+  Stack    stack;
+  uint8_t  reg_delay;
+  uint8_t  reg_sound;
+  uint32_t sound;
+  int32_t  cycle;
+  uint8_t  delay;
+  uint8_t  last_key; // 0xFF until the first key press
+  bool     keys[16];
+  uint8_t  rpl[CPU::RPL_COUNT];
+  bool     hires; // the layout of `display`, see `Display::plane`
+  uint8_t  reserved[5];
+  uint32_t random[4]; // generator of RND, a replayed stream stays where it is
+  uint64_t display[Display::PLANE_WORDS];
+  uint8_t  memory[Memory::SIZE];
+};
+
+static_assert(std::is_trivially_copyable_v<MachineState>, "a snapshot is copied byte by byte");
+static_assert(std::is_standard_layout_v<MachineState>, "the save-state file stores the state as is");
+static_assert(std::has_unique_object_representations_v<MachineState>, "padding would make equal states differ");
+
+} // namespace arabica
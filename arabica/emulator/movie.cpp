@@ -0,0 +1,105 @@
+#include <arabica/emulator/emulator.hpp>
+#include <arabica/emulator/movie.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+namespace arabica {
+
+namespace {
+
+struct MovieHeader {
+  char     magic[4];
+  uint32_t version;
+  uint64_t seed;
+  uint64_t rom_hash;
+  uint32_t frames;
+  uint32_t count;
+};
+
+static_assert(sizeof(MovieHeader) == 32, "the header is written as is");
+static_assert(sizeof(KeyEvent) == 8, "the events are written as is");
+
+} // namespace
+
+uint64_t Movie::hash(const Memory& memory) {
+  uint64_t hash = 0xCBF29CE484222325;
+  for (std::size_t address = Memory::RESERVED; address < Memory::SIZE; ++address) {
+    hash = (hash ^ memory.data()[address]) * 0x100000001B3;
+  }
+  return hash;
+}
+
+bool Movie::save(const std::string& path) const {
+  MovieHeader header;
+  std::memcpy(header.magic, MAGIC, sizeof(header.magic));
+  header.version  = VERSION;
+  header.seed     = seed;
+  header.rom_hash = rom_hash;
+  header.frames   = frames;
+  header.count    = static_cast<uint32_t>(events.size());
+
+  std::ofstream file(path, std::ios::binary);
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char*>(events.data()), events.size() * sizeof(KeyEvent));
+  return static_cast<bool>(file);
+}
+
+bool Movie::load(const std::string& path) {
+  std::ifstream        file(path, std::ios::binary | std::ios::ate);
+  const std::streamoff size = file.tellg();
+  file.seekg(0, std::ios::beg);
+  MovieHeader header;
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+      std::memcmp(header.magic, MAGIC, sizeof(header.magic)) != 0 || header.version != VERSION) {
+    return false;
+  }
+  // more events than the rest of the file holds is a corrupt header, not something to allocate for
+  if (header.count > static_cast<uint64_t>(size - sizeof(header)) / sizeof(KeyEvent)) {
+    return false;
+  }
+  std::vector<KeyEvent> loaded(header.count);
+  if (!file.read(reinterpret_cast<char*>(loaded.data()), loaded.size() * sizeof(KeyEvent))) {
+    return false;
+  }
+  seed     = header.seed;
+  rom_hash = header.rom_hash;
+  frames   = header.frames;
+  events   = std::move(loaded);
+  return true;
+}
+
+void Movie::truncate(const uint32_t frame) {
+  const auto first = std::find_if(events.begin(), events.end(), [frame](const KeyEvent& event) {
+    return event.frame >= frame;
+  });
+  events.erase(first, events.end());
+  frames = std::min(frames, frame);
+}
+
+bool MoviePlayer::start(Emulator& emulator) {
+  _frame = 0;
+  _next  = 0;
+  emulator.random.seed(_movie.seed);
+  return Movie::hash(emulator.memory) == _movie.rom_hash;
+}
+
+bool MoviePlayer::execute(Emulator& emulator) {
+  if (is_done()) {
+    return false;
+  }
+  const auto& events = _movie.events;
+  while (_next < events.size() && events[_next].frame < _frame) {
+    ++_next; // out of order, nowhere to play it
+  }
+  const std::size_t first = _next;
+  while (_next < events.size() && events[_next].frame == _frame) {
+    ++_next;
+  }
+  emulator.execute(events.data() + first, _next - first);
+  ++_frame;
+  return true;
+}
+
+} // namespace arabica
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <arabica/device/keypad.hpp>
+#include <arabica/device/random.hpp>
+#include <arabica/memory/memory.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace arabica {
+
+class Emulator;
+
+// An input movie: the key presses of a session, stamped with the frame and the instruction they
+// happened at, along with what else makes the session reproducible, the seed of RND and the rom.
+//
+// The file is a header followed by the events as they are in memory, 8 bytes each:
+//
+// +--------+---------+------+----------+--------+-------+--------------------+
+// | magic  | version | seed | rom hash | frames | count | KeyEvent x count   |
+// | 4 bytes|   u32   |  u64 |    u64   |   u32  |  u32  | 8 bytes each       |
+// +--------+---------+------+----------+--------+-------+--------------------+
+struct Movie {
+  constexpr static char     MAGIC[4] = {'A', 'R', 'M', 'V'};
+  constexpr static uint32_t VERSION  = 1;
+
+  // FNV-1a over the program space, which right after loading is the rom
+  static uint64_t hash(const Memory& memory);
+
+  bool save(const std::string& path) const;
+  bool load(const std::string& path);
+
+  // Drops everything from `frame` on, e.g. after the recording was rewound to it.
+  void truncate(const uint32_t frame);
+
+  uint64_t              seed{Random::DEFAULT_SEED};
+  uint64_t              rom_hash{0};
+  uint32_t              frames{0}; // length of the session
+  std::vector<KeyEvent> events;    // sorted by frame then instruction
+};
+
+// Plays a movie back into an emulator one frame at a time. A frame without events costs nothing
+// more than `Emulator::execute`.
+class MoviePlayer {
+public:
+  explicit MoviePlayer(const Movie& movie)
+    : _movie(movie) {
+  }
+
+  // Seeds the generator of RND as the recording did, false when the loaded rom is not the one
+  // the movie was recorded with.
+  bool start(Emulator& emulator);
+
+  // Runs the next frame with its events, false once the movie is over.
+  bool execute(Emulator& emulator);
+
+  uint32_t frame() const {
+    return _frame;
+  }
+
+  bool is_done() const {
+    return _frame >= _movie.frames;
+  }
+
+private:
+  const Movie& _movie;
+  uint32_t     _frame{0};
+  std::size_t  _next{0};
+};
+
+} // namespace arabica
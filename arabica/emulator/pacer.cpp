@@ -0,0 +1,74 @@
+#include <arabica/emulator/pacer.hpp>
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+// steady_clock is CLOCK_MONOTONIC on Linux, its time points are deadlines clock_nanosleep takes as is
+#if defined(__linux__)
+  #include <cerrno>
+  #include <time.h>
+#endif
+
+namespace arabica {
+
+void Pacer::start(const Clock::time_point now) {
+  _anchor       = now;
+  _frame        = 0;
+  _frames       = 0;
+  _rate         = 1.0;
+  _first_sample = _samples != nullptr ? _samples->load(std::memory_order_relaxed) : 0;
+}
+
+Pacer::Clock::time_point Pacer::next(const Clock::time_point now) {
+  ++_frame;
+  ++_frames;
+  if (_samples != nullptr) {
+    follow_samples();
+  }
+  const Clock::time_point due = deadline();
+  if (now - due > MAX_LATE * period()) {
+    ++_restarts;
+    start(now);
+    return now;
+  }
+  return due;
+}
+
+// The drift is in frames: how many the samples played stand for, less how many were run. A new rate
+// starts a new stretch of the schedule at the current frame, the frames before it keep their deadlines.
+void Pacer::follow_samples() {
+  const uint64_t samples = _samples->load(std::memory_order_relaxed) - _first_sample;
+  const double   drift   = static_cast<double>(samples) * _fps / _sample_rate - static_cast<double>(_frames);
+  const double   rate    = 1.0 + std::clamp(drift * RATE_GAIN, -MAX_RATE_ADJUST, MAX_RATE_ADJUST);
+  if (rate == _rate) {
+    return;
+  }
+  --_frame;
+  _anchor = deadline();
+  _frame  = 1;
+  _rate   = rate;
+}
+
+Pacer::Clock::time_point Pacer::deadline() const {
+  const double nanoseconds = static_cast<double>(_frame) * 1e9 / (_fps * _rate);
+  return _anchor + std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(std::llround(nanoseconds)));
+}
+
+void Pacer::sleep_until(const Clock::time_point deadline) {
+  const Clock::time_point wakeup = deadline - SPIN;
+  if (Clock::now() < wakeup) {
+#if defined(__linux__)
+    const auto     since = std::chrono::duration_cast<std::chrono::nanoseconds>(wakeup.time_since_epoch()).count();
+    const timespec until{static_cast<time_t>(since / 1'000'000'000), static_cast<long>(since % 1'000'000'000)};
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &until, nullptr) == EINTR) {
+    }
+#else
+    std::this_thread::sleep_until(wakeup);
+#endif
+  }
+  while (Clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+}
+
+} // namespace arabica
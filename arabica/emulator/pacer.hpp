@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace arabica {
+
+// Frame pacing against absolute deadlines: frame k of a schedule is due k / fps seconds after it
+// started, worked out from k rather than added up period by period, so 60 fps is 60.00 Hz and a late
+// wakeup does not push the frames after it back. Waiting sleeps until shortly before the deadline and
+// spins the rest of the way, the sleep alone can overshoot by the timer slack of the host.
+//
+// A late frame is due at once, so a few late ones are caught up back to back; beyond `MAX_LATE`
+// frames, e.g. after the process was stopped, the schedule starts over from where it is instead.
+//
+// Optionally the pace follows a clock counting samples, e.g. the ones an audio device has played:
+// the frames run that much faster or slower, by at most `MAX_RATE_ADJUST`, as the frames the samples
+// stand for run ahead of or behind the frames run. The host clock and the sound card never quite
+// agree, this keeps the sound fed without it being heard.
+class Pacer {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  constexpr static std::chrono::microseconds SPIN{300};               // spun rather than slept before a deadline
+  constexpr static int                       MAX_LATE        = 4;     // frames late that are still caught up
+  constexpr static double                    MAX_RATE_ADJUST = 0.005; // 0.5%, less than an ear can tell
+  constexpr static double                    RATE_GAIN       = 0.001; // rate change per frame of drift
+
+  explicit Pacer(const int fps = 60)
+    : _fps(fps) {
+  }
+
+  // `samples` counts what the clock consumed at `sample_rate` per second, nullptr goes back to the
+  // host clock alone. It takes effect with the next `start`.
+  void follow(const std::atomic<uint64_t>* const samples, const uint32_t sample_rate) {
+    _samples     = samples;
+    _sample_rate = sample_rate;
+  }
+
+  // A new schedule whose frame 0 is due at `now`.
+  void start(const Clock::time_point now = Clock::now());
+
+  // Moves on to the next frame and returns when it is due, which is `now` or earlier when late.
+  Clock::time_point next(const Clock::time_point now);
+
+  // the next frame, once it is due
+  void wait() {
+    sleep_until(next(Clock::now()));
+  }
+
+  // Returns at `deadline` or right after it, at once if it has passed.
+  static void sleep_until(const Clock::time_point deadline);
+
+  Clock::duration period() const {
+    return std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(1'000'000'000 / _fps));
+  }
+
+  // 1 on the host clock, above it when the frames run faster to keep up with the sample clock
+  double rate() const {
+    return _rate;
+  }
+
+  // times the schedule started over, being too late to catch up
+  uint64_t restarts() const {
+    return _restarts;
+  }
+
+private:
+  // when frame `_frame` is due
+  Clock::time_point deadline() const;
+
+  void follow_samples();
+
+  int                          _fps;
+  const std::atomic<uint64_t>* _samples{nullptr};
+  uint32_t                     _sample_rate{0};
+
+  Clock::time_point _anchor;          // when frame 0 was due, moved along whenever the rate changes
+  uint64_t          _frame{0};        // frames since `_anchor`
+  uint64_t          _frames{0};       // frames since `start`
+  uint64_t          _first_sample{0}; // the sample clock at `start`
+  double            _rate{1.0};
+  uint64_t          _restarts{0};
+};
+
+} // namespace arabica
@@ -0,0 +1,148 @@
+#include <arabica/cpu/disassembler.hpp>
+#include <arabica/emulator/profiler.hpp>
+#include <fmt/core.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <vector>
+
+namespace arabica {
+
+namespace {
+
+uint64_t total_count(const Profiler::Counter* const counters, const std::size_t size) {
+  uint64_t total = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    total += counters[i].count;
+  }
+  return total;
+}
+
+double share(const uint64_t part, const uint64_t total) {
+  return total > 0 ? 100.0 * part / total : 0.0;
+}
+
+double per_op(const Profiler::Counter& counter) {
+  return counter.count > 0 ? static_cast<double>(counter.nanoseconds) / counter.count : 0.0;
+}
+
+} // namespace
+
+Profiler::Profiler() {
+  clear();
+
+  // the fastest of many back to back reads is what reading the clock costs on its own
+  uint64_t fastest = UINT64_MAX;
+  for (int i = 0; i < 1000; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    const auto stop  = std::chrono::steady_clock::now();
+    fastest          = std::min<uint64_t>(fastest, std::chrono::nanoseconds(stop - start).count());
+  }
+  _overhead = fastest;
+}
+
+void Profiler::merge(const Profiler& other) {
+  for (std::size_t i = 0; i <= HANDLER_COUNT; ++i) {
+    _op_codes[i].count += other._op_codes[i].count;
+    _op_codes[i].nanoseconds += other._op_codes[i].nanoseconds;
+  }
+  for (std::size_t i = 0; i < Memory::SIZE; ++i) {
+    _addresses[i].count += other._addresses[i].count;
+    _addresses[i].nanoseconds += other._addresses[i].nanoseconds;
+    if (other._addresses[i].count > 0) {
+      _words[i] = other._words[i];
+    }
+  }
+}
+
+void Profiler::clear() {
+  std::fill(std::begin(_op_codes), std::end(_op_codes), Counter{});
+  std::fill(std::begin(_addresses), std::end(_addresses), Counter{});
+  std::fill(std::begin(_words), std::end(_words), 0);
+}
+
+std::string Profiler::report(const std::size_t top) const {
+  const uint64_t instructions = total_count(_op_codes, HANDLER_COUNT + 1);
+  uint64_t       nanoseconds  = 0;
+  for (const Counter& counter : _op_codes) {
+    nanoseconds += counter.nanoseconds;
+  }
+
+  std::string report = fmt::format("{} instructions in {:.3f} ms of host time, less {} ns of clock overhead each\n",
+                                   instructions,
+                                   nanoseconds / 1e6,
+                                   _overhead);
+
+  std::vector<uint8_t> handlers;
+  for (uint8_t i = 0; i <= HANDLER_COUNT; ++i) {
+    if (_op_codes[i].count > 0) {
+      handlers.push_back(i);
+    }
+  }
+  std::sort(handlers.begin(), handlers.end(), [this](const uint8_t lhs, const uint8_t rhs) {
+    return _op_codes[lhs].nanoseconds > _op_codes[rhs].nanoseconds;
+  });
+  report += fmt::format("\n{:<18} {:>12} {:>7} {:>14} {:>7} {:>9}\n", "op code", "count", "%", "ns", "%", "ns/op");
+  for (const uint8_t handler : handlers) {
+    const Counter& counter = _op_codes[handler];
+    report += fmt::format("{:<18} {:>12} {:>6.2f}% {:>14} {:>6.2f}% {:>9.1f}\n",
+                          handler < HANDLER_COUNT ? op_code_name(HANDLED_OP_CODES[handler]) : "UNKNOWN",
+                          counter.count,
+                          share(counter.count, instructions),
+                          counter.nanoseconds,
+                          share(counter.nanoseconds, nanoseconds),
+                          per_op(counter));
+  }
+
+  std::vector<uint16_t> addresses;
+  for (uint16_t pc = 0; pc < Memory::SIZE; ++pc) {
+    if (_addresses[pc].count > 0) {
+      addresses.push_back(pc);
+    }
+  }
+  std::vector<uint16_t> hottest = addresses;
+  std::sort(hottest.begin(), hottest.end(), [this](const uint16_t lhs, const uint16_t rhs) {
+    return _addresses[lhs].nanoseconds > _addresses[rhs].nanoseconds;
+  });
+  hottest.resize(std::min(hottest.size(), top));
+
+  const auto line = [this, instructions, nanoseconds](const uint16_t pc) {
+    const Counter& counter = _addresses[pc];
+    return fmt::format("0x{:03X}  {:04X}  {:<20} {:>12} {:>6.2f}% {:>14} {:>6.2f}% {:>9.1f}\n",
+                       pc,
+                       _words[pc],
+                       disassemble(decode(_words[pc])),
+                       counter.count,
+                       share(counter.count, instructions),
+                       counter.nanoseconds,
+                       share(counter.nanoseconds, nanoseconds),
+                       per_op(counter));
+  };
+  const std::string header = fmt::format("{:<5}  {:<4}  {:<20} {:>12} {:>7} {:>14} {:>7} {:>9}\n",
+                                         "pc",
+                                         "word",
+                                         "",
+                                         "count",
+                                         "%",
+                                         "ns",
+                                         "%",
+                                         "ns/op");
+
+  report += fmt::format("\nhottest addresses\n") + header;
+  for (const uint16_t pc : hottest) {
+    report += line(pc);
+  }
+  report += fmt::format("\nlisting\n") + header;
+  for (const uint16_t pc : addresses) {
+    report += line(pc);
+  }
+  return report;
+}
+
+bool Profiler::save(const std::string& path, const std::size_t top) const {
+  std::ofstream file(path);
+  file << report(top);
+  return static_cast<bool>(file);
+}
+
+} // namespace arabica
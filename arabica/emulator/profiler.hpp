@@ -0,0 +1,73 @@
+#pragma once
+
+#include <arabica/cpu/instruction.hpp>
+#include <arabica/memory/memory.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace arabica {
+
+// Execution profile: how many times each op code and each address ran, and the host time it took.
+//
+// The emulator only feeds it when built with `ARABICA_PROFILE` (see `ARABICA_PROFILER` in
+// CMakeLists.txt) and given one through `Emulator::set_profiler`. It then runs one instruction at
+// a time with neither fusion, idle skipping nor compiled blocks, so that every instruction is
+// counted and timed on its own: the counts are exact, the times are those of the interpreter.
+class Profiler {
+public:
+#if defined(ARABICA_PROFILE)
+  constexpr static bool IS_COMPILED_IN = true;
+#else
+  constexpr static bool IS_COMPILED_IN = false;
+#endif
+
+  struct Counter {
+    uint64_t count{0};
+    uint64_t nanoseconds{0};
+  };
+
+  Profiler();
+
+  void record(const uint16_t pc, const Instruction& instruction, const uint64_t nanoseconds) {
+    Counter& op_code = _op_codes[instruction.handler];
+    op_code.count++;
+    op_code.nanoseconds += nanoseconds;
+
+    Counter& address = _addresses[pc % Memory::SIZE];
+    address.count++;
+    address.nanoseconds += nanoseconds;
+    _words[pc % Memory::SIZE] = instruction.word;
+  }
+
+  // adds the counts of `other`, e.g. of another emulator running the same rom
+  void merge(const Profiler& other);
+
+  void clear();
+
+  // Op codes by host time, the `top` hottest addresses, then the listing of every address that ran
+  // annotated with its counts.
+  std::string report(const std::size_t top = 20) const;
+  bool        save(const std::string& path, const std::size_t top = 20) const;
+
+  // the cost of reading the clock, taken off every timed instruction
+  uint64_t overhead() const {
+    return _overhead;
+  }
+
+  const Counter& op_code(const OP_CODE opcode) const {
+    return _op_codes[handler_of(opcode)];
+  }
+
+  const Counter& address(const uint16_t pc) const {
+    return _addresses[pc % Memory::SIZE];
+  }
+
+private:
+  Counter  _op_codes[HANDLER_COUNT + 1];
+  Counter  _addresses[Memory::SIZE];
+  uint16_t _words[Memory::SIZE]; // the last word run at each address, the code may modify itself
+  uint64_t _overhead{0};
+};
+
+} // namespace arabica
@@ -0,0 +1,225 @@
+#include <arabica/emulator/rewind.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace arabica {
+
+namespace {
+
+constexpr std::size_t STATE_SIZE = sizeof(MachineState);
+
+// a zero run shorter than this is cheaper to keep inside the literal than to start a new token
+constexpr std::size_t MIN_ZERO_RUN = 3;
+
+void put_varint(std::size_t value, std::vector<uint8_t>& out) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<uint8_t>(value) | 0x80);
+    value >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+std::size_t get_varint(const uint8_t*& data) {
+  std::size_t value = 0;
+  for (int shift = 0;; shift += 7) {
+    const uint8_t byte = *data++;
+    value |= static_cast<std::size_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return value;
+    }
+  }
+}
+
+uint64_t load_word(const uint8_t* const data) {
+  uint64_t word;
+  std::memcpy(&word, data, sizeof(word));
+  return word;
+}
+
+} // namespace
+
+Rewind::Rewind(const std::size_t capacity)
+  : _ring(std::max(capacity, 4 * STATE_SIZE)) {
+}
+
+void Rewind::record(const MachineState& state) {
+  _scratch.clear();
+  const auto* const bytes = reinterpret_cast<const uint8_t*>(&state);
+  if (!_entries.empty()) {
+    encode(bytes, reinterpret_cast<const uint8_t*>(&_newest), _scratch);
+  }
+  const std::size_t delta_size = _scratch.size();
+  if (_recorded % KEYFRAME_INTERVAL == 0) {
+    encode(bytes, nullptr, _scratch);
+  }
+
+  Entry entry;
+  entry.offset     = static_cast<uint32_t>(allocate(_scratch.size()));
+  entry.delta_size = static_cast<uint32_t>(delta_size);
+  entry.key_size   = static_cast<uint32_t>(_scratch.size() - delta_size);
+  std::copy(_scratch.begin(), _scratch.end(), _ring.begin() + entry.offset);
+  _entries.push_back(entry);
+
+  _newest = state;
+  ++_recorded;
+}
+
+// Starts from whichever of the newest state and the keyframes is the fewest deltas away.
+void Rewind::seek(const std::size_t frames, MachineState& state) const {
+  const std::size_t target = _entries.size() - 1 - frames;
+
+  // keyframes are recorded every KEYFRAME_INTERVAL entries, the closest one is at most that far
+  const std::size_t first   = target > KEYFRAME_INTERVAL ? target - KEYFRAME_INTERVAL : 0;
+  const std::size_t last    = std::min(target + KEYFRAME_INTERVAL, _entries.size() - 1);
+  std::size_t       source  = _entries.size() - 1;
+  std::size_t       nearest = frames;
+  for (std::size_t i = first; i <= last; ++i) {
+    const std::size_t distance = i > target ? i - target : target - i;
+    if (_entries[i].key_size > 0 && distance < nearest) {
+      source  = i;
+      nearest = distance;
+    }
+  }
+
+  auto* const bytes = reinterpret_cast<uint8_t*>(&state);
+  if (source == _entries.size() - 1) {
+    state = _newest;
+  } else {
+    const Entry& key = _entries[source];
+    std::memset(bytes, 0, STATE_SIZE);
+    apply(&_ring[key.offset + key.delta_size], key.key_size, bytes);
+  }
+  for (std::size_t i = source; i > target; --i) {
+    apply(&_ring[_entries[i].offset], _entries[i].delta_size, bytes);
+  }
+  for (std::size_t i = source + 1; i <= target; ++i) {
+    apply(&_ring[_entries[i].offset], _entries[i].delta_size, bytes);
+  }
+}
+
+bool Rewind::step_back(MachineState& state) {
+  if (size() == 0) {
+    return false;
+  }
+  truncate(1);
+  state = _newest;
+  return true;
+}
+
+void Rewind::truncate(const std::size_t frames) {
+  const std::size_t count = std::min(frames, size());
+  if (count == 0) {
+    return;
+  }
+  seek(count, _newest);
+  for (std::size_t i = 0; i < count; ++i) {
+    const Entry& entry = _entries.back();
+    _bytes -= entry.delta_size + entry.key_size;
+    _head = entry.offset;
+    _entries.pop_back();
+  }
+  _recorded -= count;
+}
+
+void Rewind::clear() {
+  _entries.clear();
+  _head     = 0;
+  _bytes    = 0;
+  _recorded = 0;
+}
+
+// Tokens of a zero run length and a literal length, both varints, then the literal bytes XORed
+// with `base`; zeros at the end are implied. Without a `base` the state itself is encoded.
+void Rewind::encode(const uint8_t* const state, const uint8_t* const base, std::vector<uint8_t>& out) {
+  const auto byte = [state, base](const std::size_t i) -> uint8_t {
+    return base != nullptr ? state[i] ^ base[i] : state[i];
+  };
+  const auto is_zero_word = [state, base](const std::size_t i) {
+    return load_word(state + i) == (base != nullptr ? load_word(base + i) : 0);
+  };
+
+  std::size_t position = 0;
+  while (position < STATE_SIZE) {
+    std::size_t literal = position;
+    while (literal + sizeof(uint64_t) <= STATE_SIZE && is_zero_word(literal)) {
+      literal += sizeof(uint64_t);
+    }
+    while (literal < STATE_SIZE && byte(literal) == 0) {
+      ++literal;
+    }
+    if (literal == STATE_SIZE) {
+      break;
+    }
+
+    std::size_t end = literal;
+    while (end < STATE_SIZE) {
+      std::size_t zeros = 0;
+      while (end + zeros < STATE_SIZE && zeros < MIN_ZERO_RUN && byte(end + zeros) == 0) {
+        ++zeros;
+      }
+      if (zeros == MIN_ZERO_RUN || end + zeros == STATE_SIZE) {
+        break;
+      }
+      end += zeros + 1;
+    }
+
+    put_varint(literal - position, out);
+    put_varint(end - literal, out);
+    for (std::size_t i = literal; i < end; ++i) {
+      out.push_back(byte(i));
+    }
+    position = end;
+  }
+}
+
+void Rewind::apply(const uint8_t* data, const std::size_t size, uint8_t* const state) {
+  const uint8_t* const end      = data + size;
+  std::size_t          position = 0;
+  while (data < end) {
+    position += get_varint(data);
+    const std::size_t literal = get_varint(data);
+    for (std::size_t i = 0; i < literal; ++i) {
+      state[position + i] ^= data[i];
+    }
+    data += literal;
+    position += literal;
+  }
+}
+
+// The entries sit in the ring in the order they were recorded. A new one goes right after the
+// newest, or back at the start when it does not fit before the end, and pushes out the oldest ones
+// that are in its way.
+std::size_t Rewind::allocate(const std::size_t size) {
+  while (true) {
+    if (_entries.empty()) {
+      _head = 0;
+    }
+    const bool is_wrapped = !_entries.empty() && _entries.front().offset >= _head;
+    if (!is_wrapped) {
+      if (_head + size <= _ring.size()) {
+        break;
+      }
+      _head = 0;
+      if (_entries.front().offset >= size) {
+        break;
+      }
+      drop_oldest();
+    } else if (_head + size <= _entries.front().offset) {
+      break;
+    } else {
+      drop_oldest();
+    }
+  }
+  const std::size_t offset = _head;
+  _head += size;
+  _bytes += size;
+  return offset;
+}
+
+void Rewind::drop_oldest() {
+  const Entry& entry = _entries.front();
+  _bytes -= entry.delta_size + entry.key_size;
+  _entries.pop_front();
+}
+
+} // namespace arabica
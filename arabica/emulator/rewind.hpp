@@ -0,0 +1,73 @@
+#pragma once
+
+#include <arabica/emulator/machine_state.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace arabica {
+
+// Rewind history: the states recorded once per frame, stored in a fixed-size ring buffer.
+//
+// Each state is stored as the XOR against the state recorded before it, run-length encoded. Two
+// frames in a row differ in a handful of bytes, so an entry takes tens of bytes rather than
+// `sizeof(MachineState)`. An XOR delta works both ways: applied to the newer state it gives back
+// the older one, so stepping back costs one delta whatever the length of the history.
+//
+// Every `KEYFRAME_INTERVAL` entries a whole state is stored as well, encoded against zero, so that
+// seeking far back starts from the closest keyframe instead of walking every delta from the end.
+// Once the buffer is full the oldest entries are dropped.
+class Rewind {
+public:
+  constexpr static std::size_t KEYFRAME_INTERVAL = 600;     // 10 seconds at 60 fps
+  constexpr static std::size_t DEFAULT_CAPACITY  = 8 << 20; // about an hour of a typical game
+
+  explicit Rewind(const std::size_t capacity = DEFAULT_CAPACITY);
+
+  void record(const MachineState& state);
+
+  // the state `frames` entries before the newest one, `frames` must be at most `size()`
+  void seek(const std::size_t frames, MachineState& state) const;
+
+  // Drops the newest entry and leaves the one before it in `state`, false when there is none.
+  bool step_back(MachineState& state);
+
+  // Drops the `frames` newest entries, e.g. to resume from where a scrub stopped.
+  void truncate(const std::size_t frames);
+
+  void clear();
+
+  // how many frames back the history goes
+  std::size_t size() const {
+    return _entries.empty() ? 0 : _entries.size() - 1;
+  }
+
+  // bytes of the ring buffer in use
+  std::size_t bytes() const {
+    return _bytes;
+  }
+
+private:
+  struct Entry {
+    uint32_t offset{0};
+    uint32_t delta_size{0}; // XOR against the previous entry, empty for the oldest one
+    uint32_t key_size{0};   // the whole state, stored right after the delta, empty between keyframes
+  };
+
+  static void encode(const uint8_t* const state, const uint8_t* const base, std::vector<uint8_t>& out);
+  static void apply(const uint8_t* data, const std::size_t size, uint8_t* const state);
+
+  std::size_t allocate(const std::size_t size);
+  void        drop_oldest();
+
+  std::vector<uint8_t> _ring;
+  std::deque<Entry>    _entries;
+  std::size_t          _head{0};
+  std::size_t          _bytes{0};
+  std::size_t          _recorded{0};
+  MachineState         _newest;
+  std::vector<uint8_t> _scratch;
+};
+
+} // namespace arabica
@@ -0,0 +1,74 @@
+#include <arabica/emulator/save_state.hpp>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+namespace arabica {
+
+namespace {
+
+bool is_readable(const SaveStateHeader& header) {
+  return std::memcmp(header.magic, SaveStateHeader::MAGIC, sizeof(header.magic)) == 0 &&
+         header.version == SaveStateHeader::VERSION && header.size == sizeof(MachineState) &&
+         header.offset >= sizeof(SaveStateHeader) && header.offset % alignof(MachineState) == 0;
+}
+
+// The payload is checked too, a corrupt or crafted one must not make the emulator index past its
+// stack, hold a `bool` that is neither 0 nor 1 or a key it does not have. The bools are read as the
+// bytes they are stored as.
+bool is_valid(const MachineState& state) {
+  uint8_t keys[sizeof(state.keys)];
+  uint8_t hires;
+  std::memcpy(keys, state.keys, sizeof(keys));
+  std::memcpy(&hires, &state.hires, sizeof(hires));
+  for (const uint8_t key : keys) {
+    if (key > 1) {
+      return false;
+    }
+  }
+  return hires <= 1 && state.stack.size() <= Stack::DEPTH && (state.last_key < 16 || state.last_key == 0xFF);
+}
+
+} // namespace
+
+bool save_state(const std::string& path, const MachineState& state) {
+  SaveStateHeader header;
+  std::memcpy(header.magic, SaveStateHeader::MAGIC, sizeof(header.magic));
+  header.version = SaveStateHeader::VERSION;
+  header.size    = sizeof(MachineState);
+  header.offset  = sizeof(SaveStateHeader);
+
+  std::ofstream file(path, std::ios::binary);
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char*>(&state), sizeof(state));
+  return static_cast<bool>(file);
+}
+
+bool load_state(const std::string& path, MachineState& state) {
+  std::ifstream   file(path, std::ios::binary);
+  SaveStateHeader header;
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || !is_readable(header)) {
+    return false;
+  }
+  file.seekg(header.offset);
+  return file.read(reinterpret_cast<char*>(&state), sizeof(state)) && is_valid(state);
+}
+
+const MachineState* view_state(const void* const image, const std::size_t size) {
+  SaveStateHeader header;
+  if (size < sizeof(header)) {
+    return nullptr;
+  }
+  std::memcpy(&header, image, sizeof(header));
+  if (!is_readable(header) || size < header.offset + header.size) {
+    return nullptr;
+  }
+  const char* const state = static_cast<const char*>(image) + header.offset;
+  if (reinterpret_cast<std::uintptr_t>(state) % alignof(MachineState) != 0) {
+    return nullptr;
+  }
+  const MachineState* const view = reinterpret_cast<const MachineState*>(state);
+  return is_valid(*view) ? view : nullptr;
+}
+
+} // namespace arabica
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <arabica/emulator/machine_state.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace arabica {
+
+// A save-state file is a header followed by the `MachineState` exactly as it is in memory, in the
+// byte order of the machine that wrote it:
+//
+// +--------+---------+------+--------+--------------+
+// | magic  | version | size | offset | MachineState |
+// | 4 bytes|   u32   |  u32 |   u32  |  size bytes  |
+// +--------+---------+------+--------+--------------+
+//
+// `offset` is where the state starts, a multiple of its alignment, so a memory-mapped file can be
+// used in place through `view_state`. Any change to `MachineState` bumps `VERSION`.
+struct SaveStateHeader {
+  constexpr static char     MAGIC[4] = {'A', 'R', 'S', 'S'};
+  constexpr static uint32_t VERSION  = 3;
+
+  char     magic[4];
+  uint32_t version;
+  uint32_t size;
+  uint32_t offset;
+};
+
+static_assert(sizeof(SaveStateHeader) % alignof(MachineState) == 0, "the state follows the header directly");
+
+bool save_state(const std::string& path, const MachineState& state);
+
+// False when the file is not a save state this build can read or the state in it is not one a machine
+// can be in, e.g. a deeper stack than it has; `state` is left undefined then.
+bool load_state(const std::string& path, MachineState& state);
+
+// The state inside a save-state image of `size` bytes, e.g. a memory-mapped file, or nullptr when the
+// image is not a save state this build can read, is not aligned for it or holds an invalid state.
+const MachineState* view_state(const void* const image, const std::size_t size);
+
+} // namespace arabica
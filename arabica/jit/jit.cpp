@@ -0,0 +1,191 @@
+#if defined(ARABICA_JIT)
+
+#include <arabica/jit/jit.hpp>
+#include <sys/mman.h>
+#include <cstring>
+
+namespace arabica {
+
+using REG = X86_64Emitter::REG;
+using ALU = X86_64Emitter::ALU;
+
+Jit::Jit(CPU& cpu, Memory& memory, DecodeCache& decode_cache)
+  : _cpu(cpu)
+  , _memory(memory)
+  , _decode_cache(decode_cache) {
+  _offset_I  = reinterpret_cast<uint8_t*>(&_cpu.reg_I) - _cpu.registers;
+  _offset_pc = reinterpret_cast<uint8_t*>(&_cpu.pc) - _cpu.registers;
+
+  void* const arena = mmap(nullptr, ARENA_SIZE, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (arena != MAP_FAILED) {
+    _arena = static_cast<uint8_t*>(arena);
+  }
+
+  _memory.attach(this);
+}
+
+Jit::~Jit() {
+  _memory.detach(this);
+  if (_arena != nullptr) {
+    munmap(_arena, ARENA_SIZE);
+  }
+}
+
+void Jit::on_write(const Memory::address_t address, const std::size_t size) {
+  if (size >= Memory::SIZE) {
+    flush();
+    return;
+  }
+
+  const uint16_t first = (address & DecodeCache::ADDRESS_MASK) / PAGE_SIZE;
+  const uint16_t last  = ((address + size - 1) & DecodeCache::ADDRESS_MASK) / PAGE_SIZE;
+  for (uint16_t page = first;; page = (page + 1) % PAGE_COUNT) {
+    for (const auto pc : _page_blocks[page]) {
+      _blocks[pc].generation = 0;
+    }
+    _page_blocks[page].clear();
+    if (page == last) {
+      break;
+    }
+  }
+}
+
+// Drops every block and recycles the whole code arena.
+void Jit::flush() {
+  if (++_generation == 0) {
+    for (auto& block : _blocks) {
+      block.generation = 0;
+    }
+    _generation = 1;
+  }
+  for (auto& blocks : _page_blocks) {
+    blocks.clear();
+  }
+  _arena_used = 0;
+}
+
+void Jit::compile(Block& block, const uint16_t pc) {
+  _emitter.clear();
+
+  uint16_t length = 0;
+  while (is_available() && length < MAX_BLOCK_LENGTH) {
+    if (!translate(_decode_cache.fetch(pc + 2 * length))) {
+      break;
+    }
+    ++length;
+  }
+
+  if (length > 0) {
+    _emitter.add_word_imm(_offset_pc, 2 * length);
+    _emitter.ret();
+
+    const auto& code = _emitter.code();
+    if (_arena_used + code.size() > ARENA_SIZE) {
+      flush();
+    }
+    std::memcpy(_arena + _arena_used, code.data(), code.size());
+    block.function = reinterpret_cast<Function>(_arena + _arena_used);
+    _arena_used += code.size();
+  }
+
+  block.length     = length;
+  block.generation = _generation;
+
+  // an empty block is remembered as well, so the instruction is not translated again on every visit
+  const uint16_t size = length > 0 ? 2 * length : 2;
+  for (uint16_t page = pc / PAGE_SIZE;; page = (page + 1) % PAGE_COUNT) {
+    _page_blocks[page].push_back(pc);
+    if (page == ((pc + size - 1) & DecodeCache::ADDRESS_MASK) / PAGE_SIZE) {
+      break;
+    }
+  }
+}
+
+// The native code mirrors the interpreter handlers step by step, including the order
+// in which VF and Vx are written, so that instructions with x = F behave the same.
+bool Jit::translate(const Instruction& instruction) {
+  const int32_t x = instruction.x;
+  const int32_t y = instruction.y;
+  const int32_t f = 0xF;
+
+  switch (instruction.opcode) {
+    case OP_CODE::LD_Vx_byte: {
+      _emitter.store_byte_imm(x, instruction.kk);
+    } break;
+    case OP_CODE::ADD_Vx_byte: {
+      _emitter.add_byte_imm(x, instruction.kk);
+    } break;
+    case OP_CODE::LD_Vx_Vy: {
+      _emitter.load_byte(REG::EAX, y);
+      _emitter.store_byte(x, REG::EAX);
+    } break;
+    case OP_CODE::OR_Vx_Vy:
+    case OP_CODE::AND_Vx_Vy:
+    case OP_CODE::XOR_Vx_Vy: {
+      const ALU op = instruction.opcode == OP_CODE::OR_Vx_Vy    ? ALU::OR
+                     : instruction.opcode == OP_CODE::AND_Vx_Vy ? ALU::AND
+                                                                : ALU::XOR;
+      _emitter.load_byte(REG::EAX, x);
+      _emitter.load_byte(REG::ECX, y);
+      _emitter.alu(op, REG::EAX, REG::ECX);
+      _emitter.store_byte(x, REG::EAX);
+    } break;
+    case OP_CODE::ADD_Vx_Vy: {
+      _emitter.load_byte(REG::EAX, x);
+      _emitter.load_byte(REG::ECX, y);
+      _emitter.alu(ALU::ADD, REG::EAX, REG::ECX);
+      _emitter.alu(ALU::MOV, REG::EDX, REG::EAX);
+      _emitter.shr_imm(REG::EDX, 8);
+      _emitter.store_byte(f, REG::EDX);
+      _emitter.store_byte(x, REG::EAX);
+    } break;
+    case OP_CODE::SUB_Vx_Vy:
+    case OP_CODE::SUBN_Vx_Vy: {
+      const int32_t lhs = instruction.opcode == OP_CODE::SUB_Vx_Vy ? x : y;
+      const int32_t rhs = instruction.opcode == OP_CODE::SUB_Vx_Vy ? y : x;
+      _emitter.load_byte(REG::EAX, lhs);
+      _emitter.load_byte(REG::ECX, rhs);
+      _emitter.alu(ALU::CMP, REG::EAX, REG::ECX);
+      _emitter.seta(REG::EDX);
+      _emitter.store_byte(f, REG::EDX);
+      _emitter.load_byte(REG::EAX, lhs);
+      _emitter.load_byte(REG::ECX, rhs);
+      _emitter.alu(ALU::SUB, REG::EAX, REG::ECX);
+      _emitter.store_byte(x, REG::EAX);
+    } break;
+    case OP_CODE::SHR_Vx: {
+      _emitter.load_byte(REG::EAX, x);
+      _emitter.and_imm(REG::EAX, 1);
+      _emitter.store_byte(f, REG::EAX);
+      _emitter.load_byte(REG::EAX, x);
+      _emitter.shr_imm(REG::EAX, 1);
+      _emitter.store_byte(x, REG::EAX);
+    } break;
+    case OP_CODE::SHL_Vx: {
+      _emitter.load_byte(REG::EAX, x);
+      _emitter.shr_imm(REG::EAX, 7);
+      _emitter.store_byte(f, REG::EAX);
+      _emitter.load_byte(REG::EAX, x);
+      _emitter.alu(ALU::ADD, REG::EAX, REG::EAX);
+      _emitter.store_byte(x, REG::EAX);
+    } break;
+    case OP_CODE::LD_I_addr: {
+      _emitter.store_word_imm(_offset_I, instruction.nnn);
+    } break;
+    case OP_CODE::ADD_I_Vx: {
+      _emitter.load_byte(REG::EAX, x);
+      _emitter.add_word(_offset_I, REG::EAX);
+    } break;
+    case OP_CODE::LD_F_Vx: {
+      _emitter.load_byte(REG::EAX, x);
+      _emitter.times5(REG::EAX);
+      _emitter.store_word(_offset_I, REG::EAX);
+    } break;
+    default: return false;
+  }
+  return true;
+}
+
+} // namespace arabica
+
+#endif
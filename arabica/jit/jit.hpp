@@ -0,0 +1,86 @@
+#pragma once
+
+#if defined(ARABICA_JIT)
+
+#include <arabica/cpu/cpu.hpp>
+#include <arabica/cpu/decode_cache.hpp>
+#include <arabica/jit/x86_64_emitter.hpp>
+#include <arabica/memory/memory.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace arabica {
+
+// Dynamic recompiler translating Chip-8 basic blocks into x86-64 code.
+//
+// A block starts at `cpu.pc` and covers the straight run of register-only instructions
+// (6xkk, 7xkk, 8xyN, Annn, Fx1E, Fx29) from there. It ends before the first instruction the
+// native code does not handle, i.e. jumps, skips, calls, DRW, Fx0A, timer and memory accesses,
+// which are left to the interpreter. The generated code works on the `CPU` object itself: `rdi`
+// points to `cpu.registers`, `reg_I` and `pc` are addressed at fixed offsets from it.
+//
+// Writes into memory drop every block on the touched code pages.
+class Jit : public Memory::Observer {
+public:
+  constexpr static uint16_t    MAX_BLOCK_LENGTH = 64;
+  constexpr static uint16_t    PAGE_SIZE        = 64;
+  constexpr static uint16_t    PAGE_COUNT       = Memory::SIZE / PAGE_SIZE;
+  constexpr static std::size_t ARENA_SIZE       = 256 * 1024;
+
+  Jit(CPU& cpu, Memory& memory, DecodeCache& decode_cache);
+  ~Jit() override;
+
+  Jit(const Jit&)            = delete;
+  Jit& operator=(const Jit&) = delete;
+
+  // Runs the block at `cpu.pc` if it fits into `budget` instructions, returns the number of executed
+  // instructions, 0 means the instruction at `cpu.pc` has to be interpreted.
+  int execute(const int budget) {
+    Block& block = _blocks[_cpu.pc & DecodeCache::ADDRESS_MASK];
+    if (block.generation != _generation) {
+      compile(block, _cpu.pc & DecodeCache::ADDRESS_MASK);
+    }
+    if (block.length == 0 || block.length > budget) {
+      return 0;
+    }
+    block.function(_cpu.registers);
+    return block.length;
+  }
+
+  bool is_available() const {
+    return _arena != nullptr;
+  }
+
+  void on_write(const Memory::address_t address, const std::size_t size) override;
+  void flush();
+
+private:
+  using Function = void (*)(uint8_t* context);
+
+  struct Block {
+    Function function{nullptr};
+    uint16_t length{0};
+    uint32_t generation{0};
+  };
+
+  void compile(Block& block, const uint16_t pc);
+  bool translate(const Instruction& instruction);
+
+  CPU&                                          _cpu;
+  Memory&                                       _memory;
+  DecodeCache&                                  _decode_cache;
+  X86_64Emitter                                 _emitter;
+  uint8_t*                                      _arena{nullptr};
+  std::size_t                                   _arena_used{0};
+  uint32_t                                      _generation{1};
+  int32_t                                       _offset_I{0};
+  int32_t                                       _offset_pc{0};
+  std::array<Block, Memory::SIZE>               _blocks{};
+  std::array<std::vector<uint16_t>, PAGE_COUNT> _page_blocks{};
+};
+
+} // namespace arabica
+
+#endif
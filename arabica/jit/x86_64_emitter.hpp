@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace arabica {
+
+// The handful of x86-64 instructions the recompiler needs, all of them address memory relative to
+// `rdi`, which holds the pinned CPU context while a block runs.
+//
+// reference: Intel 64 and IA-32 Architectures Software Developer's Manual, Volume 2
+class X86_64Emitter {
+public:
+  enum class REG : uint8_t {
+    EAX = 0,
+    ECX = 1,
+    EDX = 2,
+  };
+
+  // ALU op codes in the `op r/m32, r32` form
+  enum class ALU : uint8_t {
+    ADD = 0x01,
+    OR  = 0x09,
+    AND = 0x21,
+    SUB = 0x29,
+    XOR = 0x31,
+    CMP = 0x39,
+    MOV = 0x89,
+  };
+
+  // movzx r32, byte [rdi + disp]
+  void load_byte(const REG dst, const int32_t disp) {
+    emit(0x0F, 0xB6);
+    emit_memory(static_cast<uint8_t>(dst), disp);
+  }
+
+  // mov byte [rdi + disp], r8
+  void store_byte(const int32_t disp, const REG src) {
+    emit(0x88);
+    emit_memory(static_cast<uint8_t>(src), disp);
+  }
+
+  // mov byte [rdi + disp], imm8
+  void store_byte_imm(const int32_t disp, const uint8_t imm) {
+    emit(0xC6);
+    emit_memory(0, disp);
+    emit(imm);
+  }
+
+  // add byte [rdi + disp], imm8
+  void add_byte_imm(const int32_t disp, const uint8_t imm) {
+    emit(0x80);
+    emit_memory(0, disp);
+    emit(imm);
+  }
+
+  // mov word [rdi + disp], r16
+  void store_word(const int32_t disp, const REG src) {
+    emit(0x66, 0x89);
+    emit_memory(static_cast<uint8_t>(src), disp);
+  }
+
+  // mov word [rdi + disp], imm16
+  void store_word_imm(const int32_t disp, const uint16_t imm) {
+    emit(0x66, 0xC7);
+    emit_memory(0, disp);
+    emit(imm & 0xFF, imm >> 8);
+  }
+
+  // add word [rdi + disp], imm16
+  void add_word_imm(const int32_t disp, const uint16_t imm) {
+    emit(0x66, 0x81);
+    emit_memory(0, disp);
+    emit(imm & 0xFF, imm >> 8);
+  }
+
+  // add word [rdi + disp], r16
+  void add_word(const int32_t disp, const REG src) {
+    emit(0x66, 0x01);
+    emit_memory(static_cast<uint8_t>(src), disp);
+  }
+
+  // op dst, src
+  void alu(const ALU op, const REG dst, const REG src) {
+    emit(static_cast<uint8_t>(op));
+    emit_register(static_cast<uint8_t>(src), static_cast<uint8_t>(dst));
+  }
+
+  // and r32, imm8
+  void and_imm(const REG dst, const uint8_t imm) {
+    emit(0x83);
+    emit_register(4, static_cast<uint8_t>(dst));
+    emit(imm);
+  }
+
+  // shr r32, imm8
+  void shr_imm(const REG dst, const uint8_t imm) {
+    emit(0xC1);
+    emit_register(5, static_cast<uint8_t>(dst));
+    emit(imm);
+  }
+
+  // lea r32, [r + r * 4]
+  void times5(const REG dst) {
+    const auto r = static_cast<uint8_t>(dst);
+    emit(0x8D, static_cast<uint8_t>((r << 3) | 0x04), static_cast<uint8_t>(0x80 | (r << 3) | r));
+  }
+
+  // seta r8
+  void seta(const REG dst) {
+    emit(0x0F, 0x97);
+    emit_register(0, static_cast<uint8_t>(dst));
+  }
+
+  void ret() {
+    emit(0xC3);
+  }
+
+  void clear() {
+    _code.clear();
+  }
+
+  const std::vector<uint8_t>& code() const {
+    return _code;
+  }
+
+private:
+  template<typename... Bytes>
+  void emit(const Bytes... bytes) {
+    (_code.push_back(static_cast<uint8_t>(bytes)), ...);
+  }
+
+  // ModRM with mod = 10 (disp32) and rm = 111 (rdi)
+  void emit_memory(const uint8_t reg, const int32_t disp) {
+    emit(0x80 | (reg << 3) | 0x07);
+    for (int i = 0; i < 4; ++i) {
+      emit((static_cast<uint32_t>(disp) >> (8 * i)) & 0xFF);
+    }
+  }
+
+  // ModRM with mod = 11 (register direct)
+  void emit_register(const uint8_t reg, const uint8_t rm) {
+    emit(0xC0 | (reg << 3) | rm);
+  }
+
+  std::vector<uint8_t> _code;
+};
+
+} // namespace arabica
@@ -2,6 +2,8 @@
 #include <iostream>
 #include <fstream>
 #include <stdexcept>
+#include <algorithm>
+#include <cstring>
 #include <fmt/core.h>
 
 namespace arabica {
@@ -11,11 +13,40 @@ Memory::Memory() {
   init_fonts();
 }
 
+Memory::Memory(const Memory& other)
+  : _cell(other._cell) {
+}
+
 Memory::~Memory() {
   clear_cell();
 }
 
+// Only the cells are copied, the observers stay bound to the memory they are attached to.
+Memory& Memory::operator=(const Memory& other) {
+  if (this != &other) {
+    _cell = other._cell;
+    notify(0, SIZE);
+  }
+  return *this;
+}
+
+void Memory::attach(Observer* const observer) {
+  _observers.push_back(observer);
+}
+
+void Memory::detach(Observer* const observer) {
+  _observers.erase(std::remove(_observers.begin(), _observers.end(), observer), _observers.end());
+}
+
+void Memory::notify(const address_t address, const std::size_t size) {
+  for (auto* const observer : _observers) {
+    observer->on_write(address, size);
+  }
+}
+
+// The returned reference can be written through, so it is reported as a write.
 Memory::value_t& Memory::read(const address_t address) {
+  notify(address, 1);
   return _cell[address];
 }
 
@@ -26,6 +57,32 @@ const Memory::value_t& Memory::read(const address_t address) const {
 void Memory::write(const address_t address, const value_t value) {
   is_valid(address);
   _cell[address] = value;
+  notify(address, 1);
+}
+
+// The changed range is found a block at a time with `memcmp`, then narrowed down to the byte.
+void Memory::assign(const value_t* const cells) {
+  constexpr std::size_t BLOCK = 64;
+
+  if (std::memcmp(_cell.data(), cells, SIZE) == 0) {
+    return;
+  }
+  std::size_t first = 0;
+  while (std::memcmp(&_cell[first], &cells[first], BLOCK) == 0) {
+    first += BLOCK;
+  }
+  std::size_t last = SIZE;
+  while (std::memcmp(&_cell[last - BLOCK], &cells[last - BLOCK], BLOCK) == 0) {
+    last -= BLOCK;
+  }
+  while (_cell[first] == cells[first]) {
+    ++first;
+  }
+  while (_cell[last - 1] == cells[last - 1]) {
+    --last;
+  }
+  std::memcpy(&_cell[first], &cells[first], last - first);
+  notify(first, last - first);
 }
 
 Memory::value_t& Memory::operator[](const address_t address) {
@@ -49,17 +106,28 @@ void Memory::is_valid(const address_t address) const {
 bool Memory::load(const std::string& rom) {
   std::ifstream file(rom, std::ios::binary | std::ios::ate);
   if (!file) {
-    fmt::print("Failed to open the file.");
+    fmt::print(stderr, "Failed to open {}\n", rom);
     return false;
   }
 
   std::streamsize size = file.tellg();
-  file.seekg(0, std::ios::beg);
-  if (!file.read(reinterpret_cast<char*>(_cell.data() + RESERVED), size)) {
-    file.close();
+  if (size > static_cast<std::streamsize>(SIZE - RESERVED)) {
+    fmt::print(stderr, "{} is {} bytes, a rom has room for {}\n", rom, size, SIZE - RESERVED);
     return false;
   }
+  file.seekg(0, std::ios::beg);
+  const bool is_read = static_cast<bool>(file.read(reinterpret_cast<char*>(_cell.data() + RESERVED), size));
   file.close();
+  notify(RESERVED, SIZE - RESERVED);
+  return is_read;
+}
+
+bool Memory::load(const std::vector<value_t>& rom) {
+  if (rom.size() > SIZE - RESERVED) {
+    return false;
+  }
+  std::copy(rom.begin(), rom.end(), _cell.begin() + RESERVED);
+  notify(RESERVED, SIZE - RESERVED);
   return true;
 }
 
@@ -84,9 +152,33 @@ void Memory::init_fonts() {
     0xF0, 0x80, 0xF0, 0x80, 0x80  // F
   };
 
+  // SUPER-CHIP 1.1 has the digits 0 to 9, A to F are the ones of Octo
+  constexpr std::array<value_t, 160> big_fonts = {
+    0x3C, 0x7E, 0xE7, 0xC3, 0xC3, 0xC3, 0xC3, 0xE7, 0x7E, 0x3C, // 0
+    0x18, 0x38, 0x58, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x3C, // 1
+    0x3E, 0x7F, 0xC3, 0x06, 0x0C, 0x18, 0x30, 0x60, 0xFF, 0xFF, // 2
+    0x3C, 0x7E, 0xC3, 0x03, 0x0E, 0x0E, 0x03, 0xC3, 0x7E, 0x3C, // 3
+    0x06, 0x0E, 0x1E, 0x36, 0x66, 0xC6, 0xFF, 0xFF, 0x06, 0x06, // 4
+    0xFF, 0xFF, 0xC0, 0xC0, 0xFC, 0xFE, 0x03, 0xC3, 0x7E, 0x3C, // 5
+    0x3E, 0x7C, 0xC0, 0xC0, 0xFC, 0xFE, 0xC3, 0xC3, 0x7E, 0x3C, // 6
+    0xFF, 0xFF, 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x60, 0x60, // 7
+    0x3C, 0x7E, 0xC3, 0xC3, 0x7E, 0x7E, 0xC3, 0xC3, 0x7E, 0x3C, // 8
+    0x3C, 0x7E, 0xC3, 0xC3, 0x7F, 0x3F, 0x03, 0x03, 0x3E, 0x7C, // 9
+    0x7E, 0xFF, 0xC3, 0xC3, 0xC3, 0xFF, 0xFF, 0xC3, 0xC3, 0xC3, // A
+    0xFC, 0xFC, 0xC3, 0xC3, 0xFC, 0xFC, 0xC3, 0xC3, 0xFC, 0xFC, // B
+    0x3C, 0xFF, 0xC3, 0xC0, 0xC0, 0xC0, 0xC0, 0xC3, 0xFF, 0x3C, // C
+    0xFC, 0xFE, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xFE, 0xFC, // D
+    0xFF, 0xFF, 0xC0, 0xC0, 0xFF, 0xFF, 0xC0, 0xC0, 0xFF, 0xFF, // E
+    0xFF, 0xFF, 0xC0, 0xC0, 0xFF, 0xFF, 0xC0, 0xC0, 0xC0, 0xC0  // F
+  };
+
   for (int i = 0; i < fonts.size(); ++i) {
-    _cell[i] = fonts[i];
+    _cell[FONT + i] = fonts[i];
+  }
+  for (std::size_t i = 0; i < big_fonts.size(); ++i) {
+    _cell[BIG_FONT + i] = big_fonts[i];
   }
+  notify(FONT, BIG_FONT + big_fonts.size());
 }
 
 } // namespace arabica
\ No newline at end of file
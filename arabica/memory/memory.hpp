@@ -1,8 +1,10 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 namespace arabica {
 
@@ -38,26 +40,52 @@ public:
 
   constexpr static uint16_t SIZE     = 4096;
   constexpr static uint16_t RESERVED = (0x1FF - 0x000) + 1;
+  constexpr static uint16_t FONT     = 0x000; // 5 bytes per hexadecimal digit, see `Fx29`
+  constexpr static uint16_t BIG_FONT = 0x050; // SUPER-CHIP, 10 bytes per digit, see `Fx30`
+
+  // Anything derived from the memory content (e.g. decoded instructions) observes the memory,
+  // every mutable access is reported so that the derived data can be dropped.
+  class Observer {
+  public:
+    virtual ~Observer() = default;
+    virtual void on_write(const address_t address, const std::size_t size) = 0;
+  };
 
   Memory();
+  Memory(const Memory& other);
   ~Memory();
 
+  Memory& operator=(const Memory& other);
+
+  void attach(Observer* const observer);
+  void detach(Observer* const observer);
+
   void init_fonts();
   bool load(const std::string& rom);
+  bool load(const std::vector<value_t>& rom);
 
   value_t&       read(const address_t address);
   const value_t& read(const address_t address) const;
 
   void write(const address_t address, const value_t value);
 
+  const value_t* data() const {
+    return _cell.data();
+  }
+
+  // Overwrites every cell with `cells`, only the range that actually changed is reported.
+  void assign(const value_t* const cells);
+
   value_t&       operator[](const address_t address);
   const value_t& operator[](const address_t address) const;
 
 private:
   void clear_cell();
   void is_valid(const address_t address) const;
+  void notify(const address_t address, const std::size_t size);
 
   std::array<value_t, SIZE> _cell;
+  std::vector<Observer*>    _observers;
 };
 
 } // namespace arabica
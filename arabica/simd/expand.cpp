@@ -0,0 +1,221 @@
+#include <arabica/simd/expand.hpp>
+#include <cstring>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+  #define ARABICA_EXPAND_X86_64
+  #include <immintrin.h>
+#endif
+
+namespace arabica::simd {
+
+namespace {
+
+uint8_t byte_of(const uint64_t* const bits, const std::size_t index) {
+  return static_cast<uint8_t>(bits[index / 8] >> (56 - 8 * (index % 8)));
+}
+
+void line_generic(const uint64_t* const bits,
+                  const std::size_t     count,
+                  const uint32_t        on,
+                  const uint32_t        off,
+                  uint32_t* const       pixels) {
+  for (std::size_t i = 0; i < count; ++i) {
+    pixels[i] = (bits[i / 64] >> (63 - i % 64)) & 1 ? on : off;
+  }
+}
+
+#if defined(ARABICA_EXPAND_X86_64)
+// The pixels of every byte, or nibble for SSE2, as lane masks: all ones where the bit is set, the
+// leftmost pixel in the first lane.
+template<std::size_t BITS>
+struct MaskTable {
+  alignas(32) uint32_t masks[1 << BITS][BITS];
+
+  constexpr MaskTable()
+    : masks() {
+    for (std::size_t value = 0; value < (1 << BITS); ++value) {
+      for (std::size_t bit = 0; bit < BITS; ++bit) {
+        masks[value][bit] = (value >> (BITS - 1 - bit)) & 1 ? 0xFFFFFFFF : 0;
+      }
+    }
+  }
+};
+
+constexpr MaskTable<8> BYTE_MASKS;
+constexpr MaskTable<4> NIBBLE_MASKS;
+
+__attribute__((target("sse2"))) void line_sse2(const uint64_t* const bits,
+                                               const std::size_t     count,
+                                               const uint32_t        on,
+                                               const uint32_t        off,
+                                               uint32_t* const       pixels) {
+  const __m128i on_pixels  = _mm_set1_epi32(static_cast<int>(on));
+  const __m128i off_pixels = _mm_set1_epi32(static_cast<int>(off));
+  for (std::size_t i = 0; i < count / 8; ++i) {
+    const uint8_t byte = byte_of(bits, i);
+    for (std::size_t half = 0; half < 2; ++half) {
+      const uint8_t nibble = half == 0 ? byte >> 4 : byte & 0x0F;
+      const __m128i mask   = _mm_load_si128(reinterpret_cast<const __m128i*>(NIBBLE_MASKS.masks[nibble]));
+      const __m128i result = _mm_or_si128(_mm_and_si128(mask, on_pixels), _mm_andnot_si128(mask, off_pixels));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + 8 * i + 4 * half), result);
+    }
+  }
+}
+
+__attribute__((target("avx2"))) void line_avx2(const uint64_t* const bits,
+                                               const std::size_t     count,
+                                               const uint32_t        on,
+                                               const uint32_t        off,
+                                               uint32_t* const       pixels) {
+  const __m256i on_pixels  = _mm256_set1_epi32(static_cast<int>(on));
+  const __m256i off_pixels = _mm256_set1_epi32(static_cast<int>(off));
+  for (std::size_t i = 0; i < count / 8; ++i) {
+    const __m256i mask = _mm256_load_si256(reinterpret_cast<const __m256i*>(BYTE_MASKS.masks[byte_of(bits, i)]));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + 8 * i), _mm256_blendv_epi8(off_pixels, on_pixels, mask));
+  }
+}
+#endif
+
+const Expander GENERIC{"generic", line_generic};
+#if defined(ARABICA_EXPAND_X86_64)
+const Expander SSE2{"sse2", line_sse2};
+const Expander AVX2{"avx2", line_avx2};
+#endif
+
+// sets `count` bits from bit `first` on, counted from the top bit of `bits[0]`
+void set_bits(uint64_t* const bits, std::size_t first, std::size_t count) {
+  while (count > 0) {
+    const std::size_t offset = first % 64;
+    const std::size_t span   = count < 64 - offset ? count : 64 - offset;
+    const uint64_t    ones   = span == 64 ? ~uint64_t{0} : ((uint64_t{1} << span) - 1) << (64 - offset - span);
+    bits[first / 64] |= ones;
+    first += span;
+    count -= span;
+  }
+}
+
+// each bit of `row` repeated `scale` times into `stretched`
+void stretch(const uint64_t* const row, const int words, const int scale, uint64_t* const stretched) {
+  if (scale == 1) {
+    std::memcpy(stretched, row, sizeof(uint64_t) * words);
+    return;
+  }
+  std::memset(stretched, 0, sizeof(uint64_t) * words * scale);
+  for (int word = 0; word < words; ++word) {
+    for (uint64_t bits = row[word]; bits != 0; bits &= bits - 1) {
+      const int x = word * 64 + 63 - __builtin_ctzll(bits);
+      set_bits(stretched, static_cast<std::size_t>(x) * scale, scale);
+    }
+  }
+}
+
+// the bits of `half` spread to the even bits of the result, the top one to bit 62
+uint64_t spread(const uint32_t half) {
+  uint64_t bits = half;
+  bits          = (bits | bits << 16) & 0x0000FFFF0000FFFF;
+  bits          = (bits | bits << 8) & 0x00FF00FF00FF00FF;
+  bits          = (bits | bits << 4) & 0x0F0F0F0F0F0F0F0F;
+  bits          = (bits | bits << 2) & 0x3333333333333333;
+  bits          = (bits | bits << 1) & 0x5555555555555555;
+  return bits;
+}
+
+// `left` and `right` side by side: bit by bit, left first
+void interleave(const uint64_t left, const uint64_t right, uint64_t* const words) {
+  words[0] = spread(static_cast<uint32_t>(left >> 32)) << 1 | spread(static_cast<uint32_t>(right >> 32));
+  words[1] = spread(static_cast<uint32_t>(left)) << 1 | spread(static_cast<uint32_t>(right));
+}
+
+} // namespace
+
+const std::vector<const Expander*>& supported_expanders() {
+  static const std::vector<const Expander*> expanders = [] {
+    std::vector<const Expander*> supported;
+#if defined(ARABICA_EXPAND_X86_64)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+      supported.push_back(&AVX2);
+    }
+    if (__builtin_cpu_supports("sse2")) {
+      supported.push_back(&SSE2);
+    }
+#endif
+    supported.push_back(&GENERIC);
+    return supported;
+  }();
+  return expanders;
+}
+
+// Scale2x works on all the pixels of a row at once: with A above, D below, C left and B right of
+// each pixel P, the four pixels it becomes are
+//
+//   top left     = C == A && C != D && A != B ? A : P
+//   top right    = A == B && A != C && B != D ? B : P
+//   bottom left  = D == C && D != B && C != A ? C : P
+//   bottom right = B == D && B != A && D != C ? D : P
+//
+// which on bit masks is a handful of XORs per 64 pixels.
+void epx(const Bitmap& bitmap, std::vector<uint64_t>& smoothed) {
+  const int words = bitmap.words;
+  smoothed.assign(static_cast<std::size_t>(4) * words * bitmap.height, 0);
+  for (int y = 0; y < bitmap.height; ++y) {
+    const uint64_t* const row   = bitmap.rows + y * words;
+    const uint64_t* const above = y > 0 ? row - words : row;
+    const uint64_t* const below = y + 1 < bitmap.height ? row + words : row;
+    uint64_t* const       top   = &smoothed[static_cast<std::size_t>(2 * y) * 2 * words];
+    uint64_t* const       under = top + 2 * words;
+    for (int word = 0; word < words; ++word) {
+      const uint64_t p = row[word];
+      const uint64_t a = above[word];
+      const uint64_t d = below[word];
+      const uint64_t c = p >> 1 | (word > 0 ? row[word - 1] << 63 : p & uint64_t{1} << 63);
+      const uint64_t b = p << 1 | (word + 1 < words ? row[word + 1] >> 63 : p & 1);
+
+      const uint64_t top_left     = ~(c ^ a) & (c ^ d) & (a ^ b);
+      const uint64_t top_right    = ~(a ^ b) & (a ^ c) & (b ^ d);
+      const uint64_t bottom_left  = ~(d ^ c) & (d ^ b) & (c ^ a);
+      const uint64_t bottom_right = ~(b ^ d) & (b ^ a) & (d ^ c);
+      interleave((top_left & a) | (~top_left & p), (top_right & b) | (~top_right & p), top + 2 * word);
+      interleave((bottom_left & c) | (~bottom_left & p),
+                 (bottom_right & d) | (~bottom_right & p),
+                 under + 2 * word);
+    }
+  }
+}
+
+void expand(const Bitmap&   bitmap,
+            const int       scale,
+            const FILTER    filter,
+            const uint32_t  on,
+            const uint32_t  off,
+            void* const     pixels,
+            const int       pitch,
+            const Expander& expander) {
+  if (filter == FILTER::EPX && scale % 2 == 0) {
+    thread_local std::vector<uint64_t> smoothed;
+    epx(bitmap, smoothed);
+    expand(Bitmap{smoothed.data(), 2 * bitmap.words, 2 * bitmap.height},
+           scale / 2,
+           FILTER::NONE,
+           on,
+           off,
+           pixels,
+           pitch,
+           expander);
+    return;
+  }
+
+  const std::size_t                  width = static_cast<std::size_t>(64) * bitmap.words * scale;
+  thread_local std::vector<uint64_t> stretched;
+  stretched.resize(static_cast<std::size_t>(bitmap.words) * scale);
+  for (int y = 0; y < bitmap.height; ++y) {
+    uint8_t* const line = static_cast<uint8_t*>(pixels) + static_cast<std::ptrdiff_t>(y) * scale * pitch;
+    stretch(bitmap.rows + y * bitmap.words, bitmap.words, scale, stretched.data());
+    expander.line(stretched.data(), width, on, off, reinterpret_cast<uint32_t*>(line));
+    for (int dy = 1; dy < scale; ++dy) {
+      std::memcpy(line + dy * pitch, line, sizeof(uint32_t) * width);
+    }
+  }
+}
+
+} // namespace arabica::simd
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace arabica::simd {
+
+enum class FILTER : uint8_t {
+  NONE, // every pixel becomes a square
+  EPX,  // Scale2x/EPX, diagonal edges are smoothed; needs an even scale, an odd one is expanded plainly
+};
+
+// A 1-bit image: `words` 64-bit words per row, the leftmost pixel in the top bit of the first one.
+struct Bitmap {
+  const uint64_t* rows{nullptr};
+  int             words{1};
+  int             height{0};
+};
+
+// Turns bits into ARGB pixels, compiled once per instruction set.
+struct Expander {
+  const char* name{nullptr};
+
+  // `count` pixels, a multiple of 8, from the bits of `bits`: `on` where a bit is set, `off` elsewhere
+  void (*line)(const uint64_t* bits, std::size_t count, uint32_t on, uint32_t off, uint32_t* pixels){nullptr};
+};
+
+// The expanders the host can run, fastest first; the generic one is always last.
+const std::vector<const Expander*>& supported_expanders();
+
+// Expands `bitmap` at `scale` by `scale` ARGB8888 pixels per bit into `pixels`, `pitch` bytes from one
+// line to the next, e.g. a locked streaming texture. Every row is stretched and expanded once, then
+// copied to the other lines it covers.
+void expand(const Bitmap&   bitmap,
+            const int       scale,
+            const FILTER    filter,
+            const uint32_t  on,
+            const uint32_t  off,
+            void* const     pixels,
+            const int       pitch,
+            const Expander& expander = *supported_expanders().front());
+
+// Scale2x/EPX of `bitmap` into `smoothed`, twice as wide and twice as high, bit for bit; a pixel
+// beyond the edge is taken to be the one on it.
+void epx(const Bitmap& bitmap, std::vector<uint64_t>& smoothed);
+
+} // namespace arabica::simd
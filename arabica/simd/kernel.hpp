@@ -0,0 +1,204 @@
+// No include guard: lockstep.cpp includes this file once per instruction set, with
+// `ARABICA_LOCKSTEP_ISA` naming the namespace of the kernel and `ARABICA_LOCKSTEP_TARGET` the
+// attributes its functions are compiled with.
+//
+// The loops are written for the vectoriser: no calls, no early exits, and rather than branching on
+// the mask every lane is computed and the mask picks between the new and the old value bit by bit.
+// A loop may write a register it reads (x or y is F), each lane still reads and writes its registers
+// in the order the emulator does.
+
+namespace arabica::simd::ARABICA_LOCKSTEP_ISA {
+
+ARABICA_LOCKSTEP_TARGET inline uint8_t blend(const uint8_t mask, const uint8_t value, const uint8_t old) {
+  return (value & mask) | (old & ~mask);
+}
+
+ARABICA_LOCKSTEP_TARGET inline uint16_t blend(const uint8_t mask, const uint16_t value, const uint16_t old) {
+  const uint16_t wide = static_cast<int8_t>(mask);
+  return (value & wide) | (old & ~wide);
+}
+
+ARABICA_LOCKSTEP_TARGET inline uint16_t select(Lanes& lanes) {
+  const std::size_t     count  = lanes.padded;
+  const uint16_t* const pc     = lanes.pc.data();
+  const int32_t* const  budget = lanes.budget.data();
+  uint8_t* const        mask   = lanes.mask.data();
+
+  uint16_t leader = Lanes::NO_PC;
+  for (std::size_t i = 0; i < count; ++i) {
+    const uint16_t candidate = pc[i] | (budget[i] > 0 ? 0x0000 : Lanes::NO_PC);
+    leader                   = candidate < leader ? candidate : leader;
+  }
+  for (std::size_t i = 0; i < count; ++i) {
+    mask[i] = (budget[i] > 0) & (pc[i] == leader) ? Lanes::ACTIVE : Lanes::INACTIVE;
+  }
+  return leader;
+}
+
+ARABICA_LOCKSTEP_TARGET inline void retire(Lanes& lanes) {
+  const std::size_t    count  = lanes.padded;
+  const uint8_t* const mask   = lanes.mask.data();
+  int32_t* const       budget = lanes.budget.data();
+  for (std::size_t i = 0; i < count; ++i) {
+    budget[i] -= mask[i] & 1;
+  }
+}
+
+ARABICA_LOCKSTEP_TARGET inline bool execute(Lanes& lanes, const Instruction& instruction) {
+  const std::size_t    count = lanes.padded;
+  const uint8_t* const m     = lanes.mask.data();
+  uint16_t* const      pc    = lanes.pc.data();
+  uint16_t* const      reg_I = lanes.reg_I.data();
+  uint8_t* const       vx    = lanes.registers[instruction.x].data();
+  uint8_t* const       vy    = lanes.registers[instruction.y].data();
+  uint8_t* const       vf    = lanes.registers[0xF].data();
+  uint8_t* const       v0    = lanes.registers[0x0].data();
+  uint8_t* const       dt    = lanes.reg_delay.data();
+  uint8_t* const       st    = lanes.reg_sound.data();
+  const uint8_t        kk    = instruction.kk;
+  const uint16_t       nnn   = instruction.nnn;
+
+  // pc moves on by 2, or by 4 where the lane skips
+  uint16_t next = 2;
+
+  switch (instruction.opcode) {
+    case OP_CODE::JP_addr:
+      for (std::size_t i = 0; i < count; ++i) {
+        pc[i] = blend(m[i], nnn, pc[i]);
+      }
+      next = 0;
+      break;
+    case OP_CODE::JP_V0_addr:
+      for (std::size_t i = 0; i < count; ++i) {
+        pc[i] = blend(m[i], static_cast<uint16_t>(nnn + v0[i]), pc[i]);
+      }
+      next = 0;
+      break;
+    case OP_CODE::SE_Vx_byte:
+      for (std::size_t i = 0; i < count; ++i) {
+        pc[i] += m[i] & (vx[i] == kk ? 4 : 2);
+      }
+      next = 0;
+      break;
+    case OP_CODE::SNE_Vx_byte:
+      for (std::size_t i = 0; i < count; ++i) {
+        pc[i] += m[i] & (vx[i] != kk ? 4 : 2);
+      }
+      next = 0;
+      break;
+    case OP_CODE::SE_Vx_Vy:
+      for (std::size_t i = 0; i < count; ++i) {
+        pc[i] += m[i] & (vx[i] == vy[i] ? 4 : 2);
+      }
+      next = 0;
+      break;
+    case OP_CODE::SNE_Vx_Vy:
+      for (std::size_t i = 0; i < count; ++i) {
+        pc[i] += m[i] & (vx[i] != vy[i] ? 4 : 2);
+      }
+      next = 0;
+      break;
+    case OP_CODE::LD_Vx_byte:
+      for (std::size_t i = 0; i < count; ++i) {
+        vx[i] = blend(m[i], kk, vx[i]);
+      }
+      break;
+    case OP_CODE::ADD_Vx_byte:
+      for (std::size_t i = 0; i < count; ++i) {
+        vx[i] = vx[i] + (m[i] & kk);
+      }
+      break;
+    case OP_CODE::LD_Vx_Vy:
+      for (std::size_t i = 0; i < count; ++i) {
+        vx[i] = blend(m[i], vy[i], vx[i]);
+      }
+      break;
+    case OP_CODE::OR_Vx_Vy:
+      for (std::size_t i = 0; i < count; ++i) {
+        vx[i] = vx[i] | (m[i] & vy[i]);
+      }
+      break;
+    case OP_CODE::AND_Vx_Vy:
+      for (std::size_t i = 0; i < count; ++i) {
+        vx[i] = vx[i] & (~m[i] | vy[i]);
+      }
+      break;
+    case OP_CODE::XOR_Vx_Vy:
+      for (std::size_t i = 0; i < count; ++i) {
+        vx[i] = vx[i] ^ (m[i] & vy[i]);
+      }
+      break;
+    case OP_CODE::ADD_Vx_Vy:
+      for (std::size_t i = 0; i < count; ++i) {
+        const uint16_t sum = vx[i] + vy[i];
+        vf[i]              = blend(m[i], static_cast<uint8_t>(sum >> 8), vf[i]);
+        vx[i]              = blend(m[i], static_cast<uint8_t>(sum), vx[i]);
+      }
+      break;
+    case OP_CODE::SUB_Vx_Vy:
+      for (std::size_t i = 0; i < count; ++i) {
+        vf[i] = blend(m[i], static_cast<uint8_t>(vx[i] > vy[i]), vf[i]);
+        vx[i] = vx[i] - (m[i] & vy[i]);
+      }
+      break;
+    case OP_CODE::SUBN_Vx_Vy:
+      for (std::size_t i = 0; i < count; ++i) {
+        vf[i] = blend(m[i], static_cast<uint8_t>(vy[i] > vx[i]), vf[i]);
+        vx[i] = blend(m[i], static_cast<uint8_t>(vy[i] - vx[i]), vx[i]);
+      }
+      break;
+    case OP_CODE::SHR_Vx:
+      for (std::size_t i = 0; i < count; ++i) {
+        vf[i] = blend(m[i], static_cast<uint8_t>(vx[i] & 1), vf[i]);
+        vx[i] = blend(m[i], static_cast<uint8_t>(vx[i] >> 1), vx[i]);
+      }
+      break;
+    case OP_CODE::SHL_Vx:
+      for (std::size_t i = 0; i < count; ++i) {
+        vf[i] = blend(m[i], static_cast<uint8_t>(vx[i] >> 7), vf[i]);
+        vx[i] = blend(m[i], static_cast<uint8_t>(vx[i] << 1), vx[i]);
+      }
+      break;
+    case OP_CODE::LD_I_addr:
+      for (std::size_t i = 0; i < count; ++i) {
+        reg_I[i] = blend(m[i], nnn, reg_I[i]);
+      }
+      break;
+    case OP_CODE::ADD_I_Vx:
+      for (std::size_t i = 0; i < count; ++i) {
+        reg_I[i] = reg_I[i] + (m[i] & vx[i]);
+      }
+      break;
+    case OP_CODE::LD_F_Vx:
+      for (std::size_t i = 0; i < count; ++i) {
+        reg_I[i] = blend(m[i], static_cast<uint16_t>(vx[i] * 5), reg_I[i]);
+      }
+      break;
+    case OP_CODE::LD_Vx_DT:
+      for (std::size_t i = 0; i < count; ++i) {
+        vx[i] = blend(m[i], dt[i], vx[i]);
+      }
+      break;
+    case OP_CODE::LD_DT_Vx:
+      for (std::size_t i = 0; i < count; ++i) {
+        dt[i] = blend(m[i], vx[i], dt[i]);
+      }
+      break;
+    case OP_CODE::LD_ST_Vx:
+      for (std::size_t i = 0; i < count; ++i) {
+        st[i] = blend(m[i], vx[i], st[i]);
+      }
+      break;
+    default: return false;
+  }
+
+  if (next != 0) {
+    for (std::size_t i = 0; i < count; ++i) {
+      pc[i] += m[i] & next;
+    }
+  }
+  retire(lanes);
+  return true;
+}
+
+} // namespace arabica::simd::ARABICA_LOCKSTEP_ISA
@@ -0,0 +1,339 @@
+#include <arabica/simd/lockstep.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+#define ARABICA_LOCKSTEP_ISA    generic
+#define ARABICA_LOCKSTEP_TARGET
+#include <arabica/simd/kernel.hpp>
+#undef ARABICA_LOCKSTEP_ISA
+#undef ARABICA_LOCKSTEP_TARGET
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define ARABICA_LOCKSTEP_X86_64
+
+#define ARABICA_LOCKSTEP_ISA    avx2
+#define ARABICA_LOCKSTEP_TARGET __attribute__((target("avx2")))
+#include <arabica/simd/kernel.hpp>
+#undef ARABICA_LOCKSTEP_ISA
+#undef ARABICA_LOCKSTEP_TARGET
+
+#define ARABICA_LOCKSTEP_ISA    avx512
+#define ARABICA_LOCKSTEP_TARGET __attribute__((target("avx512f,avx512bw,avx512vl")))
+#include <arabica/simd/kernel.hpp>
+#undef ARABICA_LOCKSTEP_ISA
+#undef ARABICA_LOCKSTEP_TARGET
+#endif
+
+namespace arabica::simd {
+
+namespace {
+
+const Kernel GENERIC{"generic", generic::select, generic::execute};
+#if defined(ARABICA_LOCKSTEP_X86_64)
+const Kernel AVX2{"avx2", avx2::select, avx2::execute};
+const Kernel AVX512{"avx512", avx512::select, avx512::execute};
+#endif
+
+std::size_t align_up(const std::size_t count) {
+  return (count + Lanes::LANE_ALIGN - 1) / Lanes::LANE_ALIGN * Lanes::LANE_ALIGN;
+}
+
+} // namespace
+
+const std::vector<const Kernel*>& supported_kernels() {
+  static const std::vector<const Kernel*> kernels = [] {
+    std::vector<const Kernel*> supported;
+#if defined(ARABICA_LOCKSTEP_X86_64)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+        __builtin_cpu_supports("avx512vl")) {
+      supported.push_back(&AVX512);
+    }
+    if (__builtin_cpu_supports("avx2")) {
+      supported.push_back(&AVX2);
+    }
+#endif
+    supported.push_back(&GENERIC);
+    return supported;
+  }();
+  return kernels;
+}
+
+Lanes::Lanes(const std::size_t n)
+  : count(n)
+  , padded(align_up(n)) {
+  for (auto& lane_registers : registers) {
+    lane_registers.assign(padded, 0);
+  }
+  for (auto& lane_stack : stack) {
+    lane_stack.assign(padded, 0);
+  }
+  reg_I.assign(padded, 0x0000);
+  pc.assign(padded, CPU::PC_START);
+  reg_delay.assign(padded, 0);
+  reg_sound.assign(padded, 0);
+  sp.assign(padded, 0);
+  budget.assign(padded, 0);
+  mask.assign(padded, INACTIVE);
+  memory.assign(padded * Memory::SIZE, 0);
+  display.assign(padded * DISPLAY_ROWS, 0);
+  keys.assign(padded, 0);
+  last_key.assign(padded, -1);
+  random.resize(padded);
+  for (std::size_t i = 0; i < padded; ++i) {
+    random[i].seed(Random::DEFAULT_SEED + i);
+  }
+}
+
+Lockstep::Lockstep(const std::size_t count)
+  : Lockstep(count, *supported_kernels().front()) {
+}
+
+Lockstep::Lockstep(const std::size_t count, const Kernel& kernel)
+  : _lanes(count)
+  , _kernel(kernel) {
+  load(std::vector<uint8_t>{});
+}
+
+bool Lockstep::load(const std::string& rom) {
+  std::ifstream file(rom, std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  return load(std::vector<uint8_t>{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()});
+}
+
+// Every lane starts over from the same state, the generators included.
+bool Lockstep::load(const std::vector<uint8_t>& rom) {
+  if (rom.size() > Memory::SIZE - Memory::RESERVED) {
+    return false;
+  }
+  _lanes = Lanes(_lanes.count);
+  const Memory memory;
+  _image.resize(Memory::SIZE);
+  for (std::size_t i = 0; i < Memory::SIZE; ++i) {
+    _image[i] = memory[i];
+  }
+  std::copy(rom.begin(), rom.end(), _image.begin() + Memory::RESERVED);
+
+  for (std::size_t lane = 0; lane < _lanes.padded; ++lane) {
+    std::copy(_image.begin(), _image.end(), _lanes.memory.begin() + lane * Memory::SIZE);
+  }
+  _written.reset();
+  return true;
+}
+
+void Lockstep::run(const int instructions) {
+  std::fill(_lanes.budget.begin(), _lanes.budget.begin() + _lanes.count, instructions);
+
+  for (uint16_t pc = _kernel.select(_lanes); pc != Lanes::NO_PC; pc = _kernel.select(_lanes)) {
+    const Instruction instruction = fetch(pc);
+    if (instruction.opcode == OP_CODE::JP_addr && instruction.nnn == pc) {
+      idle();
+    } else if (!_kernel.execute(_lanes, instruction)) {
+      scalar(instruction);
+    }
+  }
+}
+
+void Lockstep::execute() {
+  run(clock_speed / FPS);
+  tick();
+}
+
+void Lockstep::tick() {
+  for (std::size_t i = 0; i < _lanes.padded; ++i) {
+    _lanes.reg_delay[i] -= _lanes.reg_delay[i] > 0;
+    _lanes.reg_sound[i] -= _lanes.reg_sound[i] > 0;
+  }
+}
+
+void Lockstep::set_key(const std::size_t lane, const uint8_t key, const bool is_pressed) {
+  if (is_pressed) {
+    _lanes.keys[lane] |= 1 << key;
+    _lanes.last_key[lane] = key;
+  } else {
+    _lanes.keys[lane] &= ~(1 << key);
+  }
+}
+
+void Lockstep::seed(const std::size_t lane, const uint64_t seed) {
+  _lanes.random[lane].seed(seed);
+}
+
+bool Lockstep::is_pixel_set(const std::size_t lane, const int x, const int y) const {
+  return (_lanes.display[lane * Lanes::DISPLAY_ROWS + y] >> (63 - x)) & 1;
+}
+
+uint64_t Lockstep::hash(const std::size_t lane) const {
+  uint64_t hash = 0xCBF29CE484222325;
+  for (std::size_t y = 0; y < Lanes::DISPLAY_ROWS; ++y) {
+    for (int x = 0; x < 64; ++x) {
+      hash = (hash ^ (is_pixel_set(lane, x, y) ? 1 : 0)) * 0x100000001B3;
+    }
+  }
+  return hash;
+}
+
+// The instruction at `pc` is the same on every lane unless some lane has written there, then only
+// the lanes holding the same word as the first one take part in this step, the others come next.
+Instruction Lockstep::fetch(const uint16_t pc) {
+  const uint16_t address = pc & (Memory::SIZE - 1);
+  const uint16_t next    = (pc + 1) & (Memory::SIZE - 1);
+  if (!_written[address] && !_written[next]) {
+    return decode(_image[address] << 8 | _image[next]);
+  }
+
+  const auto word = [this, address, next](const std::size_t lane) {
+    const uint8_t* const memory = &_lanes.memory[lane * Memory::SIZE];
+    return static_cast<uint16_t>(memory[address] << 8 | memory[next]);
+  };
+  const auto     first  = std::find(_lanes.mask.begin(), _lanes.mask.end(), Lanes::ACTIVE) - _lanes.mask.begin();
+  const uint16_t leader = word(first);
+  for (std::size_t lane = first + 1; lane < _lanes.count; ++lane) {
+    if (_lanes.mask[lane] && word(lane) != leader) {
+      _lanes.mask[lane] = Lanes::INACTIVE;
+    }
+  }
+  return decode(leader);
+}
+
+// The masked lanes would not move for the rest of the run, like `IDLE::JP_SELF` in the emulator.
+void Lockstep::idle() {
+  for (std::size_t lane = 0; lane < _lanes.count; ++lane) {
+    if (_lanes.mask[lane]) {
+      _lanes.budget[lane] = 0;
+    }
+  }
+}
+
+void Lockstep::scalar(const Instruction& instruction) {
+  for (std::size_t lane = 0; lane < _lanes.count; ++lane) {
+    if (_lanes.mask[lane]) {
+      step(lane, instruction);
+      _lanes.budget[lane] -= _lanes.budget[lane] > 0;
+    }
+  }
+}
+
+// The instructions the kernels leave out, one lane at a time and with the emulator's semantics.
+void Lockstep::step(const std::size_t lane, const Instruction& instruction) {
+  uint16_t& pc       = _lanes.pc[lane];
+  uint16_t& reg_I    = _lanes.reg_I[lane];
+  uint8_t&  sp       = _lanes.sp[lane];
+  uint8_t&  vx       = _lanes.registers[instruction.x][lane];
+  int32_t&  budget   = _lanes.budget[lane];
+  uint8_t*  memory   = &_lanes.memory[lane * Memory::SIZE];
+  uint64_t* display  = &_lanes.display[lane * Lanes::DISPLAY_ROWS];
+  const int last_key = _lanes.last_key[lane];
+
+  switch (instruction.opcode) {
+    case OP_CODE::CLS:
+      std::fill(display, display + Lanes::DISPLAY_ROWS, 0);
+      pc += 2;
+      break;
+    case OP_CODE::RET:
+      if (sp > 0) {
+        pc = _lanes.stack[--sp][lane];
+      }
+      break;
+    case OP_CODE::SYS_addr: pc = instruction.nnn; break;
+    case OP_CODE::CALL_addr:
+      // deeper calls than a Chip-8 stack holds keep overwriting the innermost return address
+      _lanes.stack[std::min<std::size_t>(sp, Lanes::STACK_DEPTH - 1)][lane] = pc + 2;
+      sp = std::min<std::size_t>(sp + 1, Lanes::STACK_DEPTH);
+      pc = instruction.nnn;
+      break;
+    case OP_CODE::RND_Vx_byte:
+      vx = _lanes.random[lane].next_byte() & instruction.kk;
+      pc += 2;
+      break;
+    case OP_CODE::DRW_Vx_Vy_nibble:
+      draw(lane, instruction);
+      pc += 2;
+      break;
+    case OP_CODE::SKP_Vx: pc += (_lanes.keys[lane] >> (vx & 0xF)) & 1 ? 4 : 2; break;
+    case OP_CODE::SKNP_Vx: pc += (_lanes.keys[lane] >> (vx & 0xF)) & 1 ? 2 : 4; break;
+    case OP_CODE::LD_Vx_K:
+      if (last_key != -1) {
+        vx = last_key;
+        pc += 2;
+      } else {
+        // nothing changes until a key goes down, which does not happen within a run
+        budget = 0;
+      }
+      break;
+    case OP_CODE::LD_B_Vx:
+      write(lane, reg_I + 0, (vx % 1000) / 100);
+      write(lane, reg_I + 1, (vx % 100) / 10);
+      write(lane, reg_I + 2, vx % 10);
+      pc += 2;
+      break;
+    case OP_CODE::LD_I_Vx:
+      for (int i = 0; i <= instruction.x; ++i) {
+        write(lane, reg_I + i, _lanes.registers[i][lane]);
+      }
+      pc += 2;
+      break;
+    case OP_CODE::LD_Vx_I:
+      for (int i = 0; i <= instruction.x; ++i) {
+        _lanes.registers[i][lane] = memory[(reg_I + i) & (Memory::SIZE - 1)];
+      }
+      pc += 2;
+      break;
+    case OP_CODE::SCD_nibble:
+      std::copy_backward(display, display + Lanes::DISPLAY_ROWS - instruction.n, display + Lanes::DISPLAY_ROWS);
+      std::fill(display, display + instruction.n, 0);
+      pc += 2;
+      break;
+    case OP_CODE::SCR:
+      std::for_each(display, display + Lanes::DISPLAY_ROWS, [](uint64_t& row) { row >>= 4; });
+      pc += 2;
+      break;
+    case OP_CODE::SCL:
+      std::for_each(display, display + Lanes::DISPLAY_ROWS, [](uint64_t& row) { row <<= 4; });
+      pc += 2;
+      break;
+    case OP_CODE::LOW: pc += 2; break; // the lanes are always in low resolution
+    case OP_CODE::LD_HF_Vx:
+      reg_I = Memory::BIG_FONT + (vx & 0xF) * 10;
+      pc += 2;
+      break;
+    // the lanes have neither the high resolution nor the RPL flags, 00FF, Fx75 and Fx85 stall them
+    default: break; // unknown instructions stall the emulator as well, and so does 00FD
+  }
+}
+
+// Each sprite row becomes a 64-bit mask rotated into place, which wraps it around the screen edge
+// the same way `Display::update` does. Dxy0 draws 16x16 sprites, two bytes per row.
+void Lockstep::draw(const std::size_t lane, const Instruction& instruction) {
+  const uint8_t* const memory  = &_lanes.memory[lane * Memory::SIZE];
+  uint64_t* const      display = &_lanes.display[lane * Lanes::DISPLAY_ROWS];
+  const unsigned       x       = _lanes.registers[instruction.x][lane] % 64;
+  const unsigned       y       = _lanes.registers[instruction.y][lane];
+  const uint16_t       reg_I   = _lanes.reg_I[lane];
+  const bool           is_wide = instruction.n == 0;
+  const unsigned       rows    = is_wide ? 16 : instruction.n;
+
+  const auto byte = [memory, reg_I](const unsigned offset) {
+    return static_cast<uint64_t>(memory[(reg_I + offset) & (Memory::SIZE - 1)]);
+  };
+  bool collision = false;
+  for (unsigned row = 0; row < rows; ++row) {
+    const uint64_t sprite = is_wide ? (byte(2 * row) << 8 | byte(2 * row + 1)) << 48 : byte(row) << 56;
+    const uint64_t pixels = x == 0 ? sprite : sprite >> x | sprite << (64 - x);
+    uint64_t&      line   = display[(y + row) % Lanes::DISPLAY_ROWS];
+    collision             = collision || (line & pixels) != 0;
+    line ^= pixels;
+  }
+  _lanes.registers[0xF][lane] = collision ? 1 : 0;
+}
+
+void Lockstep::write(const std::size_t lane, const uint16_t address, const uint8_t value) {
+  const uint16_t cell                       = address & (Memory::SIZE - 1);
+  _lanes.memory[lane * Memory::SIZE + cell] = value;
+  _written.set(cell);
+}
+
+} // namespace arabica::simd
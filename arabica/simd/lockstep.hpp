@@ -0,0 +1,132 @@
+#pragma once
+
+#include <arabica/cpu/cpu.hpp>
+#include <arabica/cpu/instruction.hpp>
+#include <arabica/device/random.hpp>
+#include <arabica/memory/memory.hpp>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace arabica::simd {
+
+// The state of many Chip-8 machines in structure-of-arrays form, element `i` of every array
+// belongs to lane `i`. The arrays are padded to a multiple of `LANE_ALIGN` lanes so that the
+// kernels never need a scalar tail, padding lanes have no budget and never take part in a step.
+struct Lanes {
+  constexpr static std::size_t LANE_ALIGN   = 64;
+  constexpr static std::size_t STACK_DEPTH  = 16;
+  constexpr static std::size_t DISPLAY_ROWS = 32;
+  constexpr static uint16_t    NO_PC        = 0xFFFF;
+  constexpr static uint8_t     ACTIVE       = 0xFF;
+  constexpr static uint8_t     INACTIVE     = 0x00;
+
+  explicit Lanes(const std::size_t count);
+
+  std::size_t count{0};
+  std::size_t padded{0};
+
+  std::vector<uint8_t>  registers[CPU::REGISTER_COUNT];
+  std::vector<uint16_t> reg_I;
+  std::vector<uint16_t> pc;
+  std::vector<uint8_t>  reg_delay;
+  std::vector<uint8_t>  reg_sound;
+  std::vector<uint8_t>  sp;
+  std::vector<uint16_t> stack[STACK_DEPTH];
+
+  std::vector<int32_t> budget; // instructions left in the current run
+  std::vector<uint8_t> mask;   // ACTIVE for the lanes taking part in the current step
+
+  std::vector<uint8_t>    memory;   // Memory::SIZE bytes per lane
+  std::vector<uint64_t>   display;  // DISPLAY_ROWS rows per lane, the leftmost pixel in the top bit
+  std::vector<uint16_t>   keys;     // bit `k` is set while key `k` is down
+  std::vector<int8_t>     last_key; // -1 until the first key press, like `Keypad`
+  std::vector<Xoshiro128> random;   // generator of RND, the one `Random` uses
+};
+
+// The vectorised part of a step, compiled once per instruction set.
+struct Kernel {
+  const char* name{nullptr};
+
+  // the lowest pc among the lanes with budget left, `NO_PC` once every lane is done;
+  // `mask` is set for the lanes at that pc
+  uint16_t (*select)(Lanes& lanes){nullptr};
+
+  // runs `instruction` on the masked lanes and retires it, false for the instructions that are
+  // left to the scalar path (memory, stack, display and keypad)
+  bool (*execute)(Lanes& lanes, const Instruction& instruction){nullptr};
+};
+
+// the kernels the cpu supports, widest first: AVX-512, AVX2 and the plain C++ one that is always there
+const std::vector<const Kernel*>& supported_kernels();
+
+// Runs many instances of the same rom in lockstep, much like a GPU runs its threads.
+//
+// Every step picks the lowest pc among the lanes that still have instructions to run, decodes the
+// instruction there once and runs it on all lanes at that pc with a kernel working on whole
+// vectors of lanes. Lanes whose pc has diverged are masked off and wait, picking the lowest pc
+// lets them catch up so that the lanes reconverge after a branch.
+//
+// Each lane ends up exactly where an `Emulator` running the same instructions with the same
+// inputs would, RND included once the lane is seeded like the emulator.
+class Lockstep {
+public:
+  explicit Lockstep(const std::size_t count);
+  Lockstep(const std::size_t count, const Kernel& kernel);
+
+  bool load(const std::string& rom);
+  bool load(const std::vector<uint8_t>& rom);
+
+  // runs `instructions` instructions on every lane
+  void run(const int instructions);
+
+  // one frame, `clock_speed / FPS` instructions on every lane then a timer tick
+  void execute();
+
+  void tick();
+
+  void set_key(const std::size_t lane, const uint8_t key, const bool is_pressed);
+
+  // Seeds the generator of RND on `lane` as `Random::seed` does, `load` gives lane `i` the seed
+  // `Random::DEFAULT_SEED + i`, so lane 0 starts out like a fresh `Emulator`.
+  void seed(const std::size_t lane, const uint64_t seed);
+
+  std::size_t size() const {
+    return _lanes.count;
+  }
+
+  const Lanes& lanes() const {
+    return _lanes;
+  }
+
+  const char* kernel_name() const {
+    return _kernel.name;
+  }
+
+  bool is_pixel_set(const std::size_t lane, const int x, const int y) const;
+
+  // same as `Display::hash` for the lane's screen
+  uint64_t hash(const std::size_t lane) const;
+
+  constexpr static int FPS = 60;
+
+  uint32_t clock_speed{CPU::DEFAULT_CPU_HZ};
+
+private:
+  Instruction fetch(const uint16_t pc);
+
+  void idle();
+  void scalar(const Instruction& instruction);
+  void step(const std::size_t lane, const Instruction& instruction);
+  void draw(const std::size_t lane, const Instruction& instruction);
+  void write(const std::size_t lane, const uint16_t address, const uint8_t value);
+
+  Lanes                     _lanes;
+  Kernel                    _kernel;
+  std::vector<uint8_t>      _image;   // memory at load time, the same for every lane
+  std::bitset<Memory::SIZE> _written; // cells some lane has written since
+};
+
+} // namespace arabica::simd
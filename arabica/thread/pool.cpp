@@ -0,0 +1,106 @@
+#include <arabica/thread/pool.hpp>
+#include <algorithm>
+
+namespace arabica {
+
+namespace {
+
+// the pool and the index of the worker running on this thread, if any
+thread_local const void* t_pool  = nullptr;
+thread_local std::size_t t_index = 0;
+
+} // namespace
+
+ThreadPool::ThreadPool(const std::size_t thread_count) {
+  const std::size_t count = std::max<std::size_t>(thread_count, 1);
+  for (std::size_t i = 0; i < count; ++i) {
+    _workers.push_back(std::make_unique<Worker>());
+  }
+  for (std::size_t i = 0; i < count; ++i) {
+    _threads.emplace_back([this, i] { run(i); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  wait();
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _is_stopping = true;
+  }
+  _wake.notify_all();
+  for (auto& thread : _threads) {
+    thread.join();
+  }
+}
+
+void ThreadPool::submit(Task task) {
+  const std::size_t index = t_pool == this ? t_index : _next++ % _workers.size();
+  _pending++;
+  {
+    // counted first, so that `_queued` never drops below the tasks in the deques, and under the lock
+    // so that a worker cannot miss the wake up between checking it and going to sleep
+    std::lock_guard<std::mutex> lock(_mutex);
+    _queued++;
+  }
+  {
+    std::lock_guard<std::mutex> lock(_workers[index]->mutex);
+    _workers[index]->tasks.push_back(std::move(task));
+  }
+  _wake.notify_one();
+}
+
+void ThreadPool::wait() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  _done.wait(lock, [this] { return _pending == 0; });
+}
+
+void ThreadPool::run(const std::size_t index) {
+  t_pool  = this;
+  t_index = index;
+
+  Task task;
+  while (true) {
+    if (pop(index, task) || steal(index, task)) {
+      _queued--;
+      task();
+      task = nullptr;
+      if (--_pending == 0) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _done.notify_all();
+      }
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _wake.wait(lock, [this] { return _is_stopping || _queued > 0; });
+    if (_is_stopping && _queued == 0) {
+      return;
+    }
+  }
+}
+
+bool ThreadPool::pop(const std::size_t index, Task& task) {
+  Worker&                     worker = *_workers[index];
+  std::lock_guard<std::mutex> lock(worker.mutex);
+  if (worker.tasks.empty()) {
+    return false;
+  }
+  task = std::move(worker.tasks.back());
+  worker.tasks.pop_back();
+  return true;
+}
+
+bool ThreadPool::steal(const std::size_t index, Task& task) {
+  for (std::size_t i = 1; i < _workers.size(); ++i) {
+    Worker&                     victim = *_workers[(index + i) % _workers.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace arabica
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace arabica {
+
+// Work-stealing thread pool.
+//
+// Every worker owns a deque: it takes its own tasks from the back (most recent first, still warm
+// in its cache) and, once it runs dry, steals from the front of the others, so long and short
+// tasks even out across the workers without a shared queue everyone contends on. Tasks submitted
+// from a worker go to its own deque, the others are spread round robin.
+class ThreadPool {
+public:
+  using Task = std::function<void()>;
+
+  explicit ThreadPool(const std::size_t thread_count = std::thread::hardware_concurrency());
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&)            = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  void submit(Task task);
+
+  // blocks until every submitted task, including the ones submitted meanwhile, has finished,
+  // it must not be called from a task
+  void wait();
+
+  std::size_t size() const {
+    return _workers.size();
+  }
+
+private:
+  struct Worker {
+    std::mutex       mutex;
+    std::deque<Task> tasks;
+  };
+
+  void run(const std::size_t index);
+  bool pop(const std::size_t index, Task& task);
+  bool steal(const std::size_t index, Task& task);
+
+  std::vector<std::unique_ptr<Worker>> _workers;
+  std::vector<std::thread>             _threads;
+  std::atomic<std::size_t>             _next{0};
+  std::atomic<std::size_t>             _queued{0};  // tasks waiting in a deque
+  std::atomic<std::size_t>             _pending{0}; // tasks submitted but not finished
+  bool                                 _is_stopping{false};
+  std::mutex                           _mutex;
+  std::condition_variable              _wake;
+  std::condition_variable              _done;
+};
+
+} // namespace arabica
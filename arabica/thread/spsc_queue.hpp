@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace arabica {
+
+// Lock-free bounded queue between one producer and one consumer, neither of which ever waits: a
+// push onto a full queue fails and a pop from an empty one too. `CAPACITY` is a power of two, the
+// indices only ever grow and are masked into the ring.
+template<typename T, std::size_t CAPACITY>
+class SpscQueue {
+  static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "the capacity is a power of two");
+
+public:
+  SpscQueue()                            = default;
+  SpscQueue(const SpscQueue&)            = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+
+  // producer only
+  bool push(const T& value) {
+    const uint64_t head = _head.load(std::memory_order_relaxed);
+    if (head - _tail.load(std::memory_order_acquire) == CAPACITY) {
+      return false;
+    }
+    _values[head & (CAPACITY - 1)] = value;
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // consumer only
+  bool pop(T& value) {
+    const uint64_t tail = _tail.load(std::memory_order_relaxed);
+    if (tail == _head.load(std::memory_order_acquire)) {
+      return false;
+    }
+    value = _values[tail & (CAPACITY - 1)];
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool is_empty() const {
+    return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+  }
+
+private:
+  T _values[CAPACITY]{};
+  // `_head` is only stored by the producer and `_tail` by the consumer, a line apart so the stores never collide
+  alignas(64) std::atomic<uint64_t> _head{0};
+  alignas(64) std::atomic<uint64_t> _tail{0};
+};
+
+} // namespace arabica
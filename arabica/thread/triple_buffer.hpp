@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace arabica {
+
+// Lock-free triple buffer between one writer and one reader, neither of which ever waits.
+//
+// The writer fills `back` and `publish` swaps it with the middle slot, the reader's `acquire` swaps
+// its front slot with the middle one when it holds something newer. Whatever the two threads do, the
+// reader always holds a complete value and the writer always has a slot of its own to fill, and a
+// value the reader was too slow for is overwritten by the next one.
+template<typename T>
+class TripleBuffer {
+public:
+  TripleBuffer()                               = default;
+  TripleBuffer(const TripleBuffer&)            = delete;
+  TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+  // the slot the writer fills, only the writer may touch it
+  T& back() {
+    return _slots[_back];
+  }
+
+  // Hands `back` to the reader and returns true if the reader had acquired the value published
+  // before it, false if that one was overwritten unseen.
+  bool publish() {
+    const uint8_t middle = _middle.exchange(_back | FRESH, std::memory_order_acq_rel);
+    _back                = middle & INDEX;
+    return (middle & FRESH) == 0;
+  }
+
+  // Takes the latest published value if the reader does not hold it yet, returns nullptr otherwise.
+  const T* acquire() {
+    if ((_middle.load(std::memory_order_relaxed) & FRESH) == 0) {
+      return nullptr;
+    }
+    _front = _middle.exchange(_front, std::memory_order_acq_rel) & INDEX;
+    return &_slots[_front];
+  }
+
+  // the value the reader holds, only the reader may touch it
+  const T& front() const {
+    return _slots[_front];
+  }
+
+private:
+  constexpr static uint8_t INDEX = 0x03;
+  constexpr static uint8_t FRESH = 0x04; // published and not acquired yet
+
+  T _slots[3]{};
+  // each index on a cache line of its own, the two threads would fight over a shared one
+  alignas(64) uint8_t              _back{0};
+  alignas(64) uint8_t              _front{1};
+  alignas(64) std::atomic<uint8_t> _middle{2};
+};
+
+} // namespace arabica
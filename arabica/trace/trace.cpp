@@ -0,0 +1,150 @@
+#include <arabica/trace/trace.hpp>
+#include <fmt/format.h>
+#include <chrono>
+#include <cstring>
+#include <memory>
+
+namespace arabica::trace {
+
+namespace {
+
+// every ring ever made, the mutex is only taken when a thread logs for the first time and on drains
+struct Registry {
+  std::mutex                         mutex;
+  std::vector<std::unique_ptr<Ring>> rings;
+};
+
+Registry& registry() {
+  static Registry registry;
+  return registry;
+}
+
+thread_local Ring* t_ring = nullptr;
+
+#define ARABICA_TRACE_EVENT_FORMAT(event, level, format) format,
+constexpr const char* formats[] = {ARABICA_TRACE_EVENT_LIST(ARABICA_TRACE_EVENT_FORMAT)};
+#undef ARABICA_TRACE_EVENT_FORMAT
+
+#define ARABICA_TRACE_EVENT_NAME(event, level, format) #level,
+constexpr const char* levels[] = {ARABICA_TRACE_EVENT_LIST(ARABICA_TRACE_EVENT_NAME)};
+#undef ARABICA_TRACE_EVENT_NAME
+
+} // namespace
+
+std::size_t Ring::pop(std::vector<Record>& records) {
+  const uint64_t tail = _tail.load(std::memory_order_relaxed);
+  const uint64_t head = _head.load(std::memory_order_acquire);
+  for (uint64_t i = tail; i < head; ++i) {
+    records.push_back(_records[i & (CAPACITY - 1)]);
+  }
+  _tail.store(head, std::memory_order_release);
+  return head - tail;
+}
+
+Ring& local_ring() {
+  if (t_ring == nullptr) {
+    Registry&                   registry = trace::registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.rings.push_back(std::make_unique<Ring>(registry.rings.size()));
+    t_ring = registry.rings.back().get();
+  }
+  return *t_ring;
+}
+
+std::size_t drain(std::vector<Record>& records) {
+  Registry&                   registry = trace::registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  std::size_t                 count = 0;
+  for (const auto& ring : registry.rings) {
+    count += ring->pop(records);
+  }
+  return count;
+}
+
+uint64_t dropped() {
+  Registry&                   registry = trace::registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  uint64_t                    count = 0;
+  for (const auto& ring : registry.rings) {
+    count += ring->dropped();
+  }
+  return count;
+}
+
+std::string format(const Record& record) {
+  if (record.event >= EVENT_COUNT) {
+    return fmt::format("[thread {}] unknown event {}", record.thread, record.event);
+  }
+  return fmt::format("[thread {}] [{}] ", record.thread, levels[record.event]) +
+         fmt::vformat(formats[record.event], fmt::make_format_args(record.args[0], record.args[1], record.args[2]));
+}
+
+Writer::Writer(const std::string& path)
+  : _file(std::fopen(path.c_str(), "wb")) {
+  if (_file == nullptr) {
+    return;
+  }
+  std::fwrite(MAGIC, sizeof(MAGIC), 1, _file);
+  std::fwrite(&VERSION, sizeof(VERSION), 1, _file);
+  _dropped = dropped();
+  _thread = std::thread([this] { run(); });
+}
+
+Writer::~Writer() {
+  if (_file == nullptr) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _is_stopping = true;
+  }
+  _wake.notify_all();
+  _thread.join();
+  flush();
+  const uint64_t count = dropped() - _dropped;
+  const Record   trailer{{static_cast<uint32_t>(count), static_cast<uint32_t>(count >> 32), 0}, TRAILER, 0};
+  std::fwrite(&trailer, sizeof(trailer), 1, _file);
+  std::fclose(_file);
+}
+
+void Writer::run() {
+  // a drain every few milliseconds keeps up with a thread tracing every instruction long before its ring fills
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (!_is_stopping) {
+    _wake.wait_for(lock, std::chrono::milliseconds(2));
+    flush();
+  }
+}
+
+void Writer::flush() {
+  _buffer.clear();
+  if (drain(_buffer) > 0) {
+    std::fwrite(_buffer.data(), sizeof(Record), _buffer.size(), _file);
+  }
+}
+
+bool Writer::read(const std::string& path, std::vector<Record>& records, uint64_t* const dropped) {
+  std::FILE* const file = std::fopen(path.c_str(), "rb");
+  if (file == nullptr) {
+    return false;
+  }
+  char     magic[sizeof(MAGIC)];
+  uint32_t version = 0;
+  bool     is_ok   = std::fread(magic, sizeof(magic), 1, file) == 1 && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0 &&
+               std::fread(&version, sizeof(version), 1, file) == 1 && version == VERSION;
+  Record record;
+  if (dropped != nullptr) {
+    *dropped = 0;
+  }
+  while (is_ok && std::fread(&record, sizeof(record), 1, file) == 1) {
+    if (record.event != TRAILER) {
+      records.push_back(record);
+    } else if (dropped != nullptr) {
+      *dropped = record.args[0] | static_cast<uint64_t>(record.args[1]) << 32;
+    }
+  }
+  std::fclose(file);
+  return is_ok;
+}
+
+} // namespace arabica::trace
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// The log level is picked at build time, see `ARABICA_LOG_LEVEL` in CMakeLists.txt: 0 is off, 1 errors,
+// 2 info and 3 every instruction fetched. Anything above it compiles to nothing.
+#if !defined(ARABICA_LOG_LEVEL)
+  #define ARABICA_LOG_LEVEL 0
+#endif
+
+namespace arabica::trace {
+
+enum class Level : uint8_t {
+  OFF   = 0,
+  ERROR = 1,
+  INFO  = 2,
+  TRACE = 3,
+};
+
+constexpr Level LEVEL = static_cast<Level>(ARABICA_LOG_LEVEL);
+
+// X(event, level, format): the arguments of an event are up to three integers, the format is applied
+// to them when the record is read back, never on the thread that logs it
+#define ARABICA_TRACE_EVENT_LIST(X)                                           \
+  X(FRAME, INFO, "frame {} starts at pc 0x{:03X}")                            \
+  X(FRAME_IDLE, INFO, "frame {} ran {} of its {} instructions in idle loops") \
+  X(FETCH, TRACE, "pc 0x{:03X} fetches 0x{:04X}")                             \
+  X(UNKNOWN, ERROR, "unknown opcode 0x{:04X} at pc 0x{:03X}")
+
+#define ARABICA_TRACE_EVENT_ENUM(event, level, format) event,
+enum class Event : uint16_t { ARABICA_TRACE_EVENT_LIST(ARABICA_TRACE_EVENT_ENUM) };
+#undef ARABICA_TRACE_EVENT_ENUM
+
+#define ARABICA_TRACE_EVENT_COUNT(event, level, format) +1
+constexpr std::size_t EVENT_COUNT = 0 ARABICA_TRACE_EVENT_LIST(ARABICA_TRACE_EVENT_COUNT);
+#undef ARABICA_TRACE_EVENT_COUNT
+
+constexpr Level level_of(const Event event) {
+#define ARABICA_TRACE_EVENT_LEVEL(event, level, format) Level::level,
+  constexpr Level levels[] = {ARABICA_TRACE_EVENT_LIST(ARABICA_TRACE_EVENT_LEVEL)};
+#undef ARABICA_TRACE_EVENT_LEVEL
+  return levels[static_cast<std::size_t>(event)];
+}
+
+constexpr bool is_enabled(const Event event) {
+  return level_of(event) <= LEVEL;
+}
+
+// One logged event as it sits in the ring and in a trace file.
+struct Record {
+  uint32_t args[3];
+  uint16_t event;
+  uint16_t thread; // the ring it was written to, one per logging thread
+};
+
+static_assert(sizeof(Record) == 16, "a record is 16 bytes in the ring and in trace files");
+
+// Single producer, single consumer ring of records: the thread that logs pushes, the one that drains
+// pops. A full ring drops the record and counts it rather than make the emulator wait.
+class Ring {
+public:
+  constexpr static std::size_t CAPACITY = 1 << 16;
+
+  explicit Ring(const uint16_t thread)
+    : _thread(thread)
+    , _records(CAPACITY) {
+  }
+
+  bool push(Record record) {
+    const uint64_t head = _head.load(std::memory_order_relaxed);
+    if (head - _tail.load(std::memory_order_acquire) == CAPACITY) {
+      _dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    record.thread                   = _thread;
+    _records[head & (CAPACITY - 1)] = record;
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // moves every record pushed so far to the end of `records`, returns how many
+  std::size_t pop(std::vector<Record>& records);
+
+  uint64_t dropped() const {
+    return _dropped.load(std::memory_order_relaxed);
+  }
+
+private:
+  const uint16_t      _thread;
+  std::vector<Record> _records;
+  // the producer's counters and the consumer's on separate cache lines, as in `SpscQueue`
+  alignas(64) std::atomic<uint64_t> _head{0};
+  std::atomic<uint64_t>             _dropped{0};
+  alignas(64) std::atomic<uint64_t> _tail{0};
+};
+
+// The ring of the calling thread, made on its first record. Rings outlive their threads so that what
+// a finished thread logged can still be drained.
+Ring& local_ring();
+
+// Moves the records of every thread to the end of `records`, returns how many.
+std::size_t drain(std::vector<Record>& records);
+
+// records dropped on full rings, over every thread
+uint64_t dropped();
+
+std::string format(const Record& record);
+
+template<Event event, typename... Args>
+inline void log([[maybe_unused]] const Args... args) {
+  static_assert(sizeof...(Args) <= 3, "an event has at most three arguments");
+  if constexpr (is_enabled(event)) {
+    local_ring().push(Record{{static_cast<uint32_t>(args)...}, static_cast<uint16_t>(event), 0});
+  }
+}
+
+// Drains the rings on a background thread into a trace file, `arabica-trace.out` formats it. The file
+// ends with a trailer record counting the records dropped on full rings while it was written.
+class Writer {
+public:
+  constexpr static char     MAGIC[4] = {'A', 'R', 'T', 'R'};
+  constexpr static uint32_t VERSION  = 2;
+  constexpr static uint16_t TRAILER  = 0xFFFF; // the event of the trailer, its first two arguments the count
+
+  explicit Writer(const std::string& path);
+  ~Writer();
+
+  Writer(const Writer&)            = delete;
+  Writer& operator=(const Writer&) = delete;
+
+  bool is_open() const {
+    return _file != nullptr;
+  }
+
+  // Reads a trace file written by a `Writer`, the trailer into `dropped` rather than `records`. A file
+  // cut short has no trailer and reads as nothing dropped.
+  static bool read(const std::string& path, std::vector<Record>& records, uint64_t* const dropped = nullptr);
+
+private:
+  void run();
+  void flush();
+
+  std::FILE*              _file{nullptr};
+  uint64_t                _dropped{0}; // `dropped()` when the file was opened
+  std::vector<Record>     _buffer;
+  bool                    _is_stopping{false};
+  std::mutex              _mutex;
+  std::condition_variable _wake;
+  std::thread             _thread;
+};
+
+} // namespace arabica::trace
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <arabica/device/sink.hpp>
+#include <SDL2/SDL.h>
+#include <atomic>
+#include <cstdint>
+
+namespace arabica {
+
+// SDL audio device playing the Chip-8 buzzer as a square wave.
+//
+// The device plays from `init` on, silence while the buzzer is off: pausing and resuming it clicked,
+// and the samples it plays are a clock the emulation can be paced by, see `Pacer::follow`.
+class Audio : public AudioSink {
+public:
+  static uint32_t s_sample_index;
+
+  Audio(uint32_t sample_rate = 44100, uint32_t frequency = 440, int16_t volume = 3000)
+    : sample_rate(sample_rate)
+    , frequency(frequency)
+    , volume(volume)
+    , _device(0) {
+  }
+
+  bool init() {
+    SDL_zero(_desired_spec);
+    {
+      _desired_spec.freq     = sample_rate;    // https://en.wikipedia.org/wiki/44,100_Hz
+      _desired_spec.format   = AUDIO_S16LSB;   //
+      _desired_spec.channels = 1;              // mono
+      _desired_spec.samples  = 512;            // Buffer size in samples per channel
+      _desired_spec.callback = audio_callback; //
+      _desired_spec.userdata = this;           //
+    }
+
+    _device = SDL_OpenAudioDevice(nullptr, 0, &_desired_spec, &_spec, 0);
+    if (_device == 0) {
+      SDL_Log("Failed to open audio: %s", SDL_GetError());
+      return false;
+    }
+
+    sample_rate = _spec.freq; // what the device plays at, which is not always what was asked for
+    SDL_PauseAudioDevice(_device, 0);
+    return true;
+  }
+
+  ~Audio() override {
+    if (_device != 0) {
+      SDL_CloseAudioDevice(_device);
+    }
+  }
+
+  void start_beep() override {
+    _is_beeping = true;
+  }
+
+  void stop_beep() override {
+    _is_beeping = false;
+  }
+
+  // samples played since `init`, counted by the audio thread
+  const std::atomic<uint64_t>& played() const {
+    return _played;
+  }
+
+  uint32_t sample_rate;
+  uint32_t frequency;
+  int16_t  volume;
+
+private:
+  SDL_AudioDeviceID _device;
+  SDL_AudioSpec     _spec{};
+  SDL_AudioSpec     _desired_spec{};
+
+  std::atomic<bool>     _is_beeping{false};
+  std::atomic<uint64_t> _played{0};
+
+  // The following implementation source from the function which in the following GitHub repository
+  // link: https://github.com/queso-fuego/chip8_emulator_c/blob/master/chip8.c#L98
+  static void audio_callback(void* const userdata, Uint8* const stream, const int len) {
+    auto* const audio = static_cast<Audio*>(userdata);
+
+    int16_t* const audio_data              = reinterpret_cast<int16_t*>(stream);
+    const int32_t  square_wave_period      = audio->sample_rate / audio->frequency;
+    const int32_t  half_square_wave_period = square_wave_period >> 1;
+    const int16_t  volume                  = audio->_is_beeping ? audio->volume : 0;
+
+    for (int i = 0; i < (len >> 1); i++) {
+      audio_data[i] = ((s_sample_index++ / half_square_wave_period) % 2) ? volume : -volume;
+    }
+    audio->_played.fetch_add(len >> 1, std::memory_order_relaxed);
+  }
+};
+
+inline uint32_t Audio::s_sample_index = 0;
+
+} // namespace arabica
@@ -1,62 +1,79 @@
 #include <arabica/ui/window.hpp>
 #include <fmt/core.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <random>
 
 namespace arabica {
 
-Uint32 _on_tick(const Uint32 interval, void* userdata) {
-  return (static_cast<Window*>(userdata))->on_tick(interval, userdata);
-}
-
-Window::Window(const std::string& title, const int width, const int height, const std::string& rom) {
-  if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER | SDL_INIT_AUDIO) < 0) {
+Window::Window(const std::string& title,
+               const int          width,
+               const int          height,
+               const std::string& rom,
+               const std::string& movie) {
+  if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
     fmt::print("SDL could not initialize! SDL_Error: {}\n", SDL_GetError());
     std::exit(1);
   }
 
-  if (!emulator.init()) {
-    fmt::print("Failed to initialize emulator");
+  if (!audio.init()) {
+    fmt::print("Failed to initialize audio");
     std::exit(1);
   }
+  emulator.sound.set_sink(&audio);
+  emulator.set_video_sink(this);
+  _movie.seed = std::random_device{}(); // a different game every time, unlike the batch runs
+  emulator.random.seed(_movie.seed);
 
   if (!emulator.load(rom)) {
     fmt::print("Failed to load rom");
     std::exit(1);
   }
 
-  emulator.display.init(width, height, 10);
+  emulator.display.init();
+  _screen.init();
+  _pacer = Pacer(emulator.fps);
+
+  _movie_path     = movie;
+  _movie.rom_hash = Movie::hash(emulator.memory);
 
   _width  = width;
   _height = height;
+  _title  = title;
 
-  _window = SDL_CreateWindow(title.c_str(),           //
-                             SDL_WINDOWPOS_UNDEFINED, //
-                             SDL_WINDOWPOS_UNDEFINED, //
-                             width,                   //
-                             height,                  //
-                             SDL_WINDOW_SHOWN);       //
+  _window = SDL_CreateWindow(title.c_str(),                           //
+                             SDL_WINDOWPOS_UNDEFINED,                 //
+                             SDL_WINDOWPOS_UNDEFINED,                 //
+                             width,                                   //
+                             height,                                  //
+                             SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE); //
   if (_window == nullptr) {
     fmt::print("Window could not be created! SDL_Error: {}\n", SDL_GetError());
     std::exit(1);
   }
 
-  _renderer = SDL_CreateRenderer(_window, -1, SDL_RENDERER_ACCELERATED);
+  // presenting waits for the vsync, which also caps fast-forward at one presented frame per refresh
+  _renderer = SDL_CreateRenderer(_window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
   if (_renderer == nullptr) {
     fmt::print("Renderer could not be created! SDL_Error: {}\n", SDL_GetError());
     std::exit(1);
   }
 
+  // The texture is the Chip-8 screen at its own resolution and the renderer scales it to the window,
+  // nearest neighbour and letterboxed, so resizing or going fullscreen costs nothing. It is as large
+  // as the SUPER-CHIP high resolution, the low one uses its top left quarter; both are 2:1.
+  SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "nearest");
+  SDL_RenderSetLogicalSize(_renderer, Display::HIRES_WIDTH, Display::HIRES_HEIGHT);
   _texture = SDL_CreateTexture(_renderer,
                                SDL_PIXELFORMAT_ARGB8888,
-                               SDL_TEXTUREACCESS_STATIC,
-                               emulator.display.window_width,
-                               emulator.display.window_height);
-
-  _timer_id = SDL_AddTimer(emulator.milliseconds_per_frame, //
-                           _on_tick,                        // every `t` milliseonds will execute `_on_tick`
-                           this);                           //
+                               SDL_TEXTUREACCESS_STREAMING,
+                               Display::HIRES_WIDTH,
+                               Display::HIRES_HEIGHT);
 }
 
 Window::~Window() {
+  stop_emulation();
   SDL_DestroyTexture(_texture);
   SDL_DestroyRenderer(_renderer);
   SDL_DestroyWindow(_window);
@@ -64,17 +81,19 @@ Window::~Window() {
 }
 
 void Window::execute() {
-  _running = true;
+  _running      = true;
+  _is_emulating = true;
+  _emulation    = std::thread(&Window::run_emulation, this);
   while (_running) {
     while (SDL_PollEvent(&_event)) {
       switch (_event.type) {
         case SDL_QUIT: _running = false; break;
         case SDL_WINDOWEVENT: {
+          if (_event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED || _event.window.event == SDL_WINDOWEVENT_EXPOSED) {
+            _is_exposed = true;
+          }
           if (_event.window.event == SDL_WINDOWEVENT_CLOSE) {
-            if (SDL_FALSE == SDL_RemoveTimer(_timer_id)) {
-              fmt::print("Failed to remove timer! SDL_Error: {}\n", SDL_GetError());
-              std::exit(1);
-            }
+            stop_emulation();
           }
         } break;
         case SDL_KEYDOWN: on_keyboard(_event.key.keysym.sym, true); break;
@@ -84,9 +103,162 @@ void Window::execute() {
     }
     on_render();
   }
+
+  stop_emulation();
+  if (!_movie_path.empty()) {
+    if (!_movie.save(_movie_path)) {
+      fmt::print("Failed to save the movie to {}\n", _movie_path);
+    }
+  }
+}
+
+void Window::set_fast_forward(const bool is_enable, const int speed) {
+  _speed           = std::max(speed, 0);
+  _is_fast_forward = is_enable;
+
+  const std::string title = is_enable ? _title + (speed > 0 ? fmt::format(" [x{}]", speed) : " [>>]") : _title;
+  SDL_SetWindowTitle(_window, title.c_str());
+}
+
+void Window::set_audio_sync(const bool is_enable) {
+  _pacer.follow(is_enable ? &audio.played() : nullptr, audio.sample_rate);
+}
+
+void Window::set_filter(const simd::FILTER filter) {
+  const int scale = filter == simd::FILTER::EPX ? 2 : 1;
+  SDL_DestroyTexture(_texture);
+  _texture = SDL_CreateTexture(_renderer,
+                               SDL_PIXELFORMAT_ARGB8888,
+                               SDL_TEXTUREACCESS_STREAMING,
+                               Display::HIRES_WIDTH * scale,
+                               Display::HIRES_HEIGHT * scale);
+  _filter     = filter;
+  _is_exposed = true;
+  std::memset(_screen.dirty, 0xFF, sizeof(_screen.dirty));
+}
+
+// The emulation thread: a tick every frame, paced by `_pacer`. An uncapped fast-forward runs flat out
+// instead and the pace starts over once it is done. The emulator belongs to this thread once it runs,
+// so fast-forward is only flagged by the main thread and the sound muted here, between two frames.
+void Window::run_emulation() {
+  _pacer.start();
+  _frame_start = Clock::now();
+  while (_is_emulating) {
+    const bool is_fast_forward = _is_fast_forward;
+    if (emulator.sound.is_muted != is_fast_forward) {
+      emulator.sound.set_mute(is_fast_forward);
+    }
+    if (is_fast_forward && _speed == 0 && _rewind_speed == 0) {
+      run_uncapped();
+      _pacer.start();
+      continue;
+    }
+    tick();
+    _pacer.wait();
+  }
+}
+
+void Window::stop_emulation() {
+  _is_emulating = false;
+  if (_emulation.joinable()) {
+    _emulation.join();
+  }
+}
+
+// With an uncapped fast-forward the frames are run by `run_uncapped` instead.
+void Window::tick() {
+  if (_rewind_speed > 0) {
+    rewind(_rewind_speed);
+    return;
+  }
+  const int frames = _is_fast_forward ? _speed.load() : 1;
+  for (int i = 0; i < frames; ++i) {
+    run_frame();
+  }
+  if (frames > 0) {
+    record();
+  }
+}
+
+// Uncapped fast-forward: the emulation runs for one host frame, of which only the last frame is
+// presented.
+void Window::run_uncapped() {
+  const Uint64 frequency = SDL_GetPerformanceFrequency();
+  const Uint64 deadline  = SDL_GetPerformanceCounter() + frequency / emulator.fps;
+  do {
+    run_frame();
+  } while (SDL_GetPerformanceCounter() < deadline);
+  record();
+}
+
+// The keys pressed since the last frame are applied to this one, at the earliest instructions that
+// keep them in order unless they are spaced, see `set_input_spacing`. They are recorded with where
+// they were applied, so a movie of the session plays back exactly.
+void Window::run_frame() {
+  const Clock::time_point start        = Clock::now();
+  const Clock::duration   period       = _pacer.period();
+  const int               instructions = emulator.cpu.clock_speed / emulator.fps;
+  const auto              frame        = static_cast<uint32_t>(emulator.cycle);
+  InputEvent              input;
+  for (int64_t next = 0; _input.pop(input); ++next) {
+    const Clock::duration since = std::max(input.time - _frame_start, Clock::duration::zero());
+    const int64_t         at    = std::min<int64_t>(_is_input_spaced ? since * instructions / period : next,
+                                                    instructions - 1);
+    _frame_events.push_back(KeyEvent{frame, static_cast<uint16_t>(at), input.key, input.is_pressed});
+  }
+  _frame_start = start;
+
+  if (!_movie_path.empty()) {
+    _movie.events.insert(_movie.events.end(), _frame_events.begin(), _frame_events.end());
+    _movie.frames = frame + 1;
+  }
+  emulator.execute(_frame_events.data(), _frame_events.size());
+  _frame_events.clear();
+}
+
+// One entry per tick, so a fast-forward is rewound at the pace it was presented.
+void Window::record() {
+  emulator.snapshot(_state);
+  _rewind.record(_state);
+}
+
+void Window::rewind(const int frames) {
+  const std::size_t count = std::min<std::size_t>(frames, _rewind.size());
+  if (count == 0) {
+    return;
+  }
+  _rewind.truncate(count);
+  _rewind.seek(0, _state);
+  emulator.restore(_state);
+  if (emulator.display.is_refresh) {
+    on_frame(emulator.display);
+    emulator.display.clean();
+  }
+  if (!_movie_path.empty()) {
+    _movie.truncate(static_cast<uint32_t>(emulator.cycle));
+  }
 }
 
 void Window::on_keyboard(const SDL_Keycode keycode, const bool is_pressed) {
+  if (keycode == SDLK_TAB) {
+    if (is_pressed) {
+      set_fast_forward(!_is_fast_forward, _speed);
+    }
+    return;
+  }
+  if (keycode == SDLK_F11) {
+    if (is_pressed) {
+      const bool is_fullscreen = (SDL_GetWindowFlags(_window) & SDL_WINDOW_FULLSCREEN_DESKTOP) != 0;
+      SDL_SetWindowFullscreen(_window, is_fullscreen ? 0 : SDL_WINDOW_FULLSCREEN_DESKTOP);
+    }
+    return;
+  }
+  // rewinds while held, faster with Shift
+  if (keycode == SDLK_BACKSPACE) {
+    _rewind_speed = is_pressed ? ((SDL_GetModState() & KMOD_SHIFT) != 0 ? SCRUB_SPEED : 1) : 0;
+    return;
+  }
+
   int chip8_keycode = -1;
   switch (keycode) {
     case SDLK_0: chip8_keycode = 0x00; break;
@@ -108,28 +280,69 @@ void Window::on_keyboard(const SDL_Keycode keycode, const bool is_pressed) {
     default: break;
   }
 
+  // a full queue means the emulation thread is stuck, the key is lost either way
   if (chip8_keycode != -1) {
-    if (is_pressed) {
-      emulator.keypad.on_keydown(chip8_keycode);
-    } else {
-      emulator.keypad.on_keyup(chip8_keycode);
-    }
+    _input.push(InputEvent{Clock::now(), static_cast<uint8_t>(chip8_keycode), static_cast<uint8_t>(is_pressed)});
   }
 }
 
+// Only the rectangles changed since the last present are written, straight into the locked texture,
+// and nothing is presented when nothing changed unless the window has to be repainted. A smoothed
+// pixel depends on its neighbours, so with EPX the whole screen is expanded again instead.
 void Window::on_render() {
-  if (emulator.display.is_refresh) {
-    SDL_RenderClear(_renderer);
-    SDL_UpdateTexture(_texture, nullptr, emulator.display.pixels, emulator.display.window_width * sizeof(uint32_t));
-    SDL_RenderCopy(_renderer, _texture, nullptr, nullptr);
-    SDL_RenderPresent(_renderer);
-    emulator.display.is_refresh = false;
+  if (const Display* const frame = _frames.acquire()) {
+    _screen.merge(*frame);
+  }
+  if (!_screen.is_dirty() && !_is_exposed) {
+    return;
+  }
+  if (_filter != simd::FILTER::NONE) {
+    void* pixels = nullptr;
+    int   pitch  = 0;
+    if (SDL_LockTexture(_texture, nullptr, &pixels, &pitch) == 0) {
+      simd::expand(simd::Bitmap{_screen.plane, _screen.words(), _screen.height()},
+                   2,
+                   _filter,
+                   Display::COLOR_ON,
+                   0,
+                   pixels,
+                   pitch);
+      SDL_UnlockTexture(_texture);
+    }
+    _rects.clear();
+  } else {
+    _screen.dirty_rects(_rects);
   }
+  for (const Display::Rect& rect : _rects) {
+    const SDL_Rect area{rect.x, rect.y, rect.width, rect.height};
+    void*          pixels = nullptr;
+    int            pitch  = 0;
+    if (SDL_LockTexture(_texture, &area, &pixels, &pitch) == 0) {
+      _screen.render(pixels, pitch, rect);
+      SDL_UnlockTexture(_texture);
+    }
+  }
+  const int scale = _filter != simd::FILTER::NONE ? 2 : 1;
+  _source         = SDL_Rect{0, 0, _screen.width() * scale, _screen.height() * scale};
+  _screen.clean();
+  _is_exposed = false;
+  SDL_RenderClear(_renderer); // the letterbox around the screen
+  SDL_RenderCopy(_renderer, _texture, &_source, nullptr);
+  SDL_RenderPresent(_renderer);
 }
 
-Uint32 Window::on_tick(const Uint32 interval, void* userdata) {
-  emulator.execute();
-  return interval;
+// Every frame is published whole, with the changes of the frames before it that the main thread never
+// acquired: once it has acquired one, only the changes since are still to be presented.
+void Window::on_frame(const Display& display) {
+  Display& frame = _frames.back();
+  frame          = display;
+  for (int i = 0; i < Display::PLANE_WORDS; ++i) {
+    _unseen[i] |= display.dirty[i];
+    frame.dirty[i] = _unseen[i];
+  }
+  if (_frames.publish()) {
+    std::memcpy(_unseen, display.dirty, sizeof(_unseen));
+  }
 }
 
 } // namespace arabica
@@ -1,36 +1,121 @@
 #pragma once
 
+#include <arabica/device/sink.hpp>
 #include <arabica/emulator/emulator.hpp>
+#include <arabica/emulator/movie.hpp>
+#include <arabica/emulator/pacer.hpp>
+#include <arabica/emulator/rewind.hpp>
+#include <arabica/simd/expand.hpp>
+#include <arabica/thread/spsc_queue.hpp>
+#include <arabica/thread/triple_buffer.hpp>
+#include <arabica/ui/audio.hpp>
 #include <SDL2/SDL.h>
+#include <atomic>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace arabica {
 
-class Window {
+// SDL front end: presents the frames of the emulator, plays its sound and feeds it the keyboard.
+//
+// The emulator runs on a thread of its own and hands every frame it finishes to the main thread,
+// which presents them, through a triple buffer: neither thread ever waits for the other, and the
+// main thread always presents the latest complete frame. The keys go the other way through a queue,
+// stamped with the host time they were pressed at.
+class Window : public VideoSink {
 public:
-  Window(const std::string& title, const int width, const int height, const std::string& rom);
-  ~Window();
+  constexpr static int SCRUB_SPEED = 4; // frames rewound per tick with Shift held
 
+  // With a `movie` path the keys pressed are recorded from the first frame on into a movie saved
+  // there on exit, see `Movie`.
+  Window(const std::string& title,
+         const int          width,
+         const int          height,
+         const std::string& rom,
+         const std::string& movie = "");
+  ~Window() override;
+
+  // Starts the emulation thread and presents its frames until the window is closed.
   void execute();
 
-  void   on_keyboard(const SDL_Keycode keycode, const bool is_pressed);
-  void   on_render();
-  Uint32 on_tick(const Uint32 interval, void* userdata);
+  // Fast-forward runs `speed` frames per tick, or as many as the host allows with a speed of 0.
+  // Frames are still presented once per vsync at most, and the sound is muted meanwhile.
+  void set_fast_forward(const bool is_enable, const int speed);
+
+  // Paces the emulation by the samples the audio device plays rather than by the host clock alone, the
+  // two drift apart. Takes effect when `execute` starts.
+  void set_audio_sync(const bool is_enable);
+
+  // Keys are applied as soon as the next frame starts, one instruction apart. Spaced, they are applied
+  // as far into it as they were pressed into the one before, a frame later but as far apart as they
+  // were, so that a key tapped within a frame is still seen down. Takes effect when `execute` starts.
+  void set_input_spacing(const bool is_enable) {
+    _is_input_spaced = is_enable;
+  }
+
+  // With `FILTER::EPX` the screen is smoothed on the CPU into a texture twice its size, which the
+  // renderer then scales like the native one.
+  void set_filter(const simd::FILTER filter);
+
+  void on_keyboard(const SDL_Keycode keycode, const bool is_pressed);
+  void on_render();
+  void on_frame(const Display& display) override;
 
   Emulator emulator;
+  Audio    audio;
 
 private:
-  bool _running{false};
-  int  _width{100};
-  int  _height{100};
+  using Clock = Pacer::Clock;
+
+  // a key as the main thread saw it
+  struct InputEvent {
+    Clock::time_point time;
+    uint8_t           key{0};
+    uint8_t           is_pressed{0};
+  };
+
+  void run_emulation();
+  void stop_emulation();
+  void tick();
+  void run_uncapped();
+  void run_frame();
+  void record();
+  void rewind(const int frames);
+
+  bool              _running{false};
+  int               _width{100};
+  int               _height{100};
+  std::string       _title;
+  std::atomic<bool> _is_fast_forward{false};
+  std::atomic<int>  _speed{0};
+  std::atomic<int>  _rewind_speed{0};
+  Pacer             _pacer;
+  Rewind            _rewind;
+  MachineState      _state;
+
+  Movie                      _movie;
+  std::string                _movie_path;
+  SpscQueue<InputEvent, 256> _input;
+  std::vector<KeyEvent>      _frame_events;
+  Clock::time_point          _frame_start; // when the last frame was run, on the emulation thread
+  bool                       _is_input_spaced{false};
+
+  std::thread           _emulation;
+  std::atomic<bool>     _is_emulating{false};
+  TripleBuffer<Display> _frames;
+  uint64_t              _unseen[Display::PLANE_WORDS] = {0}; // changes in frames not acquired yet
+
+  Display                    _screen; // the last frame, dirty where it was not presented yet
+  std::vector<Display::Rect> _rects;
+  bool                       _is_exposed{true}; // the window was resized or uncovered and needs a present
+  simd::FILTER               _filter{simd::FILTER::NONE};
 
-  SDL_TimerID   _timer_id;
   SDL_Event     _event{0};
   SDL_Window*   _window{nullptr};
   SDL_Renderer* _renderer{nullptr};
   SDL_Texture*  _texture{nullptr};
-
-  friend Uint32 _on_tick(const Uint32 interval, void* userdata);
+  SDL_Rect      _source{0, 0, Display::PLANE_WIDTH, Display::PLANE_HEIGHT}; // the part of it the screen covers
 };
 
 } // namespace arabica
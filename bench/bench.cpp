@@ -0,0 +1,87 @@
+#include <bench/bench.hpp>
+#include <fmt/core.h>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+
+namespace arabica::bench {
+
+std::vector<Benchmark>& registry() {
+  static std::vector<Benchmark> benchmarks;
+  return benchmarks;
+}
+
+Result run(const Benchmark& benchmark, const double min_time, const int repetitions) {
+  // doubles the iterations until a run lasts long enough for the clock, then scales up to `min_time`
+  uint64_t iterations = 1;
+  while (true) {
+    State state(iterations);
+    benchmark.function(state);
+    const double seconds = state.nanoseconds() / 1e9;
+    if (seconds >= min_time) {
+      break;
+    }
+    if (seconds >= min_time / 10) {
+      iterations = static_cast<uint64_t>(iterations * min_time / seconds) + 1;
+      break;
+    }
+    iterations *= 2;
+  }
+
+  std::vector<double> samples;
+  for (int i = 0; i < repetitions; ++i) {
+    State state(iterations);
+    benchmark.function(state);
+    samples.push_back(state.nanoseconds() / iterations);
+  }
+  std::sort(samples.begin(), samples.end());
+
+  Result result;
+  result.name       = benchmark.name;
+  result.ns_per_op  = samples[samples.size() / 2];
+  result.iterations = iterations;
+  return result;
+}
+
+std::string to_json(const std::vector<Result>& results) {
+  std::string json = "{\"benchmarks\": [\n";
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    const Result& result = results[i];
+    json += fmt::format(R"(  {{"name": "{}", "ns_per_op": {:.3f}, "iterations": {})",
+                        result.name,
+                        result.ns_per_op,
+                        result.iterations);
+    if (result.baseline > 0.0) {
+      json += fmt::format(R"(, "baseline_ns_per_op": {:.3f}, "change_percent": {:.1f})",
+                          result.baseline,
+                          100.0 * (result.ns_per_op - result.baseline) / result.baseline);
+    }
+    json += i + 1 < results.size() ? "},\n" : "}\n";
+  }
+  return json + "]}\n";
+}
+
+bool read_baseline(const std::string& path, std::map<std::string, double>& baseline) {
+  std::ifstream file(path);
+  if (!file) {
+    return false;
+  }
+  constexpr const char* name_key = "\"name\": \"";
+  constexpr const char* time_key = "\"ns_per_op\": ";
+
+  std::string line;
+  while (std::getline(file, line)) {
+    const std::size_t name = line.find(name_key);
+    const std::size_t time = line.find(time_key);
+    if (name == std::string::npos || time == std::string::npos) {
+      continue;
+    }
+    const std::size_t first = name + std::char_traits<char>::length(name_key);
+    const std::size_t last  = line.find('"', first);
+    baseline[line.substr(first, last - first)] =
+      std::strtod(line.c_str() + time + std::char_traits<char>::length(time_key), nullptr);
+  }
+  return true;
+}
+
+} // namespace arabica::bench
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace arabica::bench {
+
+// Handed to every benchmark, which runs the operation it measures `iterations()` times between
+// `start()` and `stop()`; whatever it sets up before `start()` is not measured.
+class State {
+public:
+  explicit State(const uint64_t iterations)
+    : _iterations(iterations) {
+  }
+
+  uint64_t iterations() const {
+    return _iterations;
+  }
+
+  void start() {
+    _start = std::chrono::steady_clock::now();
+  }
+
+  void stop() {
+    _elapsed = std::chrono::steady_clock::now() - _start;
+  }
+
+  double nanoseconds() const {
+    return std::chrono::duration<double, std::nano>(_elapsed).count();
+  }
+
+private:
+  uint64_t                              _iterations{0};
+  std::chrono::steady_clock::time_point _start;
+  std::chrono::steady_clock::duration   _elapsed{0};
+};
+
+struct Benchmark {
+  std::string                 name;
+  std::function<void(State&)> function;
+};
+
+struct Result {
+  std::string name;
+  double      ns_per_op{0.0};
+  uint64_t    iterations{0};
+  double      baseline{0.0}; // ns per op of the baseline, 0 when it has no such benchmark
+};
+
+std::vector<Benchmark>& registry();
+
+inline bool add(const std::string& name, std::function<void(State&)> function) {
+  registry().push_back(Benchmark{name, std::move(function)});
+  return true;
+}
+
+// Keeps the compiler from optimising `value`, and whatever it took to compute it, away.
+template<typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+
+// The median of `repetitions` runs, each of them long enough to last `min_time` seconds.
+Result run(const Benchmark& benchmark, const double min_time, const int repetitions);
+
+// One benchmark per line, so that a saved result is also easy to diff:
+//
+//   {"benchmarks": [
+//     {"name": "...", "ns_per_op": 1.234, "iterations": 1048576},
+//     ...
+//   ]}
+//
+// With a baseline every line also has the baseline and the change in percent.
+std::string to_json(const std::vector<Result>& results);
+
+// ns per op by benchmark name, from a file written by `to_json`
+bool read_baseline(const std::string& path, std::map<std::string, double>& baseline);
+
+} // namespace arabica::bench
+
+// Defines and registers the benchmark `bench_name`, whose body sees its `State` as `state`.
+#define arabica_bench(bench_name, bench_body)                                              \
+  namespace {                                                                              \
+  void bench_##bench_name(arabica::bench::State& state) {                                  \
+    bench_body                                                                             \
+  }                                                                                        \
+  const bool is_added_##bench_name = arabica::bench::add(#bench_name, bench_##bench_name); \
+  }
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <arabica/emulator/emulator.hpp>
+#include <bench/bench.hpp>
+#include <bench/rom/synthetic.hpp>
+#include <fmt/core.h>
+#include <cstdint>
+
+namespace arabica_dispatch_bench {
+
+struct OpCode {
+  const char* name;
+  uint16_t    word;
+};
+
+// one of each kind, with operands that keep it from jumping away or waiting: V0 and V1 are 0 and
+// I points at the fonts; RET has nothing to return to and Fx0A would wait, they are left out
+constexpr OpCode op_codes[] = {
+  {"cls",              0x00E0},
+  {"jp_addr",          0x1200},
+  {"call_addr",        0x2200},
+  {"se_vx_byte",       0x3001},
+  {"sne_vx_byte",      0x4000},
+  {"se_vx_vy",         0x5010},
+  {"ld_vx_byte",       0x6012},
+  {"add_vx_byte",      0x7001},
+  {"ld_vx_vy",         0x8010},
+  {"or_vx_vy",         0x8011},
+  {"and_vx_vy",        0x8012},
+  {"xor_vx_vy",        0x8013},
+  {"add_vx_vy",        0x8014},
+  {"sub_vx_vy",        0x8015},
+  {"shr_vx",           0x8016},
+  {"subn_vx_vy",       0x8017},
+  {"shl_vx",           0x801E},
+  {"sne_vx_vy",        0x9010},
+  {"ld_i_addr",        0xA000},
+  {"jp_v0_addr",       0xB200},
+  {"rnd_vx_byte",      0xC0FF},
+  {"drw_vx_vy_nibble", 0xD015},
+  {"skp_vx",           0xE09E},
+  {"sknp_vx",          0xE0A1},
+  {"ld_vx_dt",         0xF007},
+  {"ld_dt_vx",         0xF015},
+  {"ld_st_vx",         0xF018},
+  {"add_i_vx",         0xF01E},
+  {"ld_f_vx",          0xF029},
+  {"ld_b_vx",          0xF033},
+  {"ld_i_vx",          0xF055},
+  {"ld_vx_i",          0xF065},
+};
+
+// `Emulator::single_step` over the program space filled with `word`, back to its start at the end
+inline void single_step(arabica::bench::State& state, const uint16_t word) {
+  arabica::Emulator emulator;
+  emulator.display.init();
+  for (uint32_t address = arabica::Memory::RESERVED; address < arabica::Memory::SIZE; address += 2) {
+    emulator.memory.write(address, word >> 8);
+    emulator.memory.write(address + 1, word & 0xFF);
+  }
+  state.start();
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    emulator.single_step();
+    if (emulator.cpu.pc >= arabica::Memory::SIZE - 2) {
+      emulator.cpu.pc = arabica::Memory::RESERVED;
+    }
+  }
+  state.stop();
+  arabica::bench::do_not_optimize(emulator.cpu.registers);
+}
+
+const bool is_op_code_added = [] {
+  for (const OpCode& op_code : op_codes) {
+    const uint16_t word = op_code.word;
+    arabica::bench::add(fmt::format("op_{}", op_code.name), [word](arabica::bench::State& state) {
+      single_step(state, word);
+    });
+  }
+  return true;
+}();
+
+} // namespace arabica_dispatch_bench
+
+// clang-format off
+
+// decode and dispatch of a mix of instructions, one at a time
+arabica_bench(single_step_mixed,
+  arabica::Emulator emulator;
+  emulator.display.init();
+  arabica_synthetic_rom::load(emulator, arabica_synthetic_rom::calls);
+  state.start();
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    emulator.single_step();
+  }
+  state.stop();
+  arabica::bench::do_not_optimize(emulator.cpu.registers);
+)
+
+// the same mix through `Emulator::run`, with the decode cache, fusion and idle detection
+arabica_bench(run_mixed,
+  arabica::Emulator emulator;
+  emulator.display.init();
+  arabica_synthetic_rom::load(emulator, arabica_synthetic_rom::calls);
+  state.start();
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    emulator.run(1);
+  }
+  state.stop();
+  arabica::bench::do_not_optimize(emulator.cpu.registers);
+)
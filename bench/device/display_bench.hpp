@@ -0,0 +1,73 @@
+#pragma once
+
+#include <arabica/device/display.hpp>
+#include <bench/bench.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace arabica_display_bench {
+
+constexpr uint8_t sprite[] = {0xF0, 0x90, 0x90, 0x90, 0xF0};
+
+} // namespace arabica_display_bench
+
+// clang-format off
+
+// a 5-row sprite drawn across the screen, every call draws or erases one
+arabica_bench(display_update,
+  arabica::Display display;
+  display.init();
+
+  int collisions = 0;
+  state.start();
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    const int x = static_cast<int>(i * 7) & 63;
+    const int y = static_cast<int>(i * 3) & 31;
+    collisions += display.update(x, y, arabica_display_bench::sprite, 5);
+  }
+  state.stop();
+  arabica::bench::do_not_optimize(collisions);
+)
+
+// a sprite drawn per frame and only the rectangles it dirtied written out at native resolution, what
+// filling the streaming texture costs for a typical frame
+arabica_bench(display_render_dirty,
+  constexpr int                       pitch = arabica::Display::PLANE_WIDTH * sizeof(uint32_t);
+  arabica::Display                    display;
+  std::vector<uint32_t>               pixels(arabica::Display::PLANE_WIDTH * arabica::Display::PLANE_HEIGHT);
+  std::vector<arabica::Display::Rect> rects;
+  display.init();
+
+  state.start();
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    display.update(static_cast<int>(i * 7) & 63, static_cast<int>(i * 3) & 31, arabica_display_bench::sprite, 5);
+    display.dirty_rects(rects);
+    for (const arabica::Display::Rect& rect : rects) {
+      display.render(&pixels[rect.y * arabica::Display::PLANE_WIDTH + rect.x], pitch, rect);
+    }
+    display.clean();
+  }
+  state.stop();
+  arabica::bench::do_not_optimize(pixels[0]);
+)
+
+// SUPER-CHIP scrolling of a full 128x64 screen, what a scroll-heavy game pays every frame
+arabica_bench(display_scroll_hires,
+  arabica::Display display;
+  display.init();
+  display.set_hires(true);
+  for (int i = 0; i < arabica::Display::PLANE_WORDS; ++i) {
+    display.plane[i] = uint64_t{0x0123456789ABCDEF} * (i + 1);
+  }
+
+  state.start();
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    switch (i % 3) {
+      case 0: display.scroll_down(1); break;
+      case 1: display.scroll_right(4); break;
+      default: display.scroll_left(4); break;
+    }
+  }
+  state.stop();
+  arabica::bench::do_not_optimize(display.plane);
+)
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <arabica/device/random.hpp>
+#include <bench/bench.hpp>
+#include <cstdint>
+#include <random>
+
+// clang-format off
+
+arabica_bench(random_next_byte,
+  arabica::Random random;
+  uint8_t         sum = 0;
+  state.start();
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    sum += random.next_byte();
+  }
+  state.stop();
+  arabica::bench::do_not_optimize(sum);
+)
+
+arabica_bench(random_next_byte_recorded,
+  arabica::Random random;
+  random.record();
+  uint8_t sum = 0;
+  state.start();
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    sum += random.next_byte();
+  }
+  state.stop();
+  arabica::bench::do_not_optimize(sum);
+)
+
+// what RND used to do for every draw, kept as the yardstick
+arabica_bench(random_device_mt19937_per_draw,
+  uint8_t sum = 0;
+  state.start();
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    std::random_device                 device;
+    std::mt19937                       generator(device());
+    std::uniform_int_distribution<int> distribution(0, 255);
+    sum += static_cast<uint8_t>(distribution(generator));
+  }
+  state.stop();
+  arabica::bench::do_not_optimize(sum);
+)
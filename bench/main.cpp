@@ -0,0 +1,81 @@
+#include <bench/bench.hpp>
+#include <bench/cpu/dispatch_bench.hpp>
+#include <bench/device/display_bench.hpp>
+#include <bench/device/random_bench.hpp>
+#include <bench/memory/memory_bench.hpp>
+#include <bench/rom/rom_bench.hpp>
+#include <bench/simd/expand_bench.hpp>
+#include <fmt/core.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+// Benchmarks of the emulator hot paths, from single instructions to whole frames of synthetic roms.
+// The results are printed as JSON, save them to compare a change against them later.
+//
+// usage: ./arabica_bench.out [--filter text] [--min-time seconds] [--repetitions count]
+//                            [--baseline result-file [--threshold percent]]
+//
+// With a baseline every result is compared against it, and the exit code is 1 when any of them is
+// slower by more than the threshold, 5% unless given.
+int main(int argc, char* argv[]) {
+  std::string filter;
+  std::string baseline_path;
+  double      min_time    = 0.1;
+  int         repetitions = 5;
+  double      threshold   = 5.0;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--filter" && i + 1 < argc) {
+      filter = argv[++i];
+    } else if (arg == "--min-time" && i + 1 < argc) {
+      min_time = std::atof(argv[++i]);
+    } else if (arg == "--repetitions" && i + 1 < argc) {
+      repetitions = std::max(1, std::atoi(argv[++i]));
+    } else if (arg == "--baseline" && i + 1 < argc) {
+      baseline_path = argv[++i];
+    } else if (arg == "--threshold" && i + 1 < argc) {
+      threshold = std::atof(argv[++i]);
+    } else {
+      fmt::print("Usage: ./arabica_bench.out [--filter text] [--min-time seconds] [--repetitions count]\n"
+                 "                           [--baseline result-file [--threshold percent]]\n");
+      return 1;
+    }
+  }
+
+  std::map<std::string, double> baseline;
+  if (!baseline_path.empty() && !arabica::bench::read_baseline(baseline_path, baseline)) {
+    fmt::print(stderr, "Failed to read {}\n", baseline_path);
+    return 1;
+  }
+
+  std::vector<arabica::bench::Result> results;
+  int                                 regressions = 0;
+  for (const auto& benchmark : arabica::bench::registry()) {
+    if (benchmark.name.find(filter) == std::string::npos) {
+      continue;
+    }
+    arabica::bench::Result result = arabica::bench::run(benchmark, min_time, repetitions);
+    if (const auto found = baseline.find(result.name); found != baseline.end()) {
+      result.baseline = found->second;
+    }
+    // progress and regressions on stderr, the JSON on stdout stays clean
+    const double change =
+      result.baseline > 0.0 ? 100.0 * (result.ns_per_op - result.baseline) / result.baseline : 0.0;
+    const bool is_regression = change > threshold;
+    regressions += is_regression ? 1 : 0;
+    fmt::print(stderr,
+               "{:<32} {:>12.3f} ns{}\n",
+               result.name,
+               result.ns_per_op,
+               result.baseline > 0.0 ? fmt::format(" {:+7.1f}%{}", change, is_regression ? " slower" : "") : "");
+    results.push_back(result);
+  }
+
+  fmt::print("{}", arabica::bench::to_json(results));
+  std::fflush(stdout);
+  return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <arabica/memory/memory.hpp>
+#include <bench/bench.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+// clang-format off
+
+// a rom filling the whole program space, read from the file system cache
+arabica_bench(memory_load,
+  const std::string path = (std::filesystem::temp_directory_path() / "arabica_bench.ch8").string();
+  {
+    std::ofstream file(path, std::ios::binary);
+    for (int i = arabica::Memory::RESERVED; i < arabica::Memory::SIZE; ++i) {
+      file.put(static_cast<char>(i));
+    }
+  }
+  arabica::Memory memory;
+  bool            is_loaded = true;
+  state.start();
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    is_loaded &= memory.load(path);
+  }
+  state.stop();
+  std::filesystem::remove(path);
+  arabica::bench::do_not_optimize(is_loaded);
+)
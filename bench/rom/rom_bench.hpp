@@ -0,0 +1,25 @@
+#pragma once
+
+#include <arabica/emulator/emulator.hpp>
+#include <bench/bench.hpp>
+#include <bench/rom/synthetic.hpp>
+#include <cstdint>
+
+// Whole frames of the synthetic roms, headless: one op is one `Emulator::execute`.
+#define arabica_rom_bench(rom_name)                                         \
+  arabica_bench(frame_##rom_name,                                           \
+    arabica::Emulator emulator;                                             \
+    emulator.display.init();                                                \
+    arabica_synthetic_rom::load(emulator, arabica_synthetic_rom::rom_name); \
+    state.start();                                                          \
+    for (uint64_t i = 0; i < state.iterations(); ++i) {                     \
+      emulator.execute();                                                   \
+    }                                                                       \
+    state.stop();                                                           \
+    arabica::bench::do_not_optimize(emulator.cpu.registers);)
+
+arabica_rom_bench(alu);
+arabica_rom_bench(draw);
+arabica_rom_bench(calls);
+arabica_rom_bench(timer);
+arabica_rom_bench(random);
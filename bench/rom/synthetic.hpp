@@ -0,0 +1,78 @@
+#pragma once
+
+#include <arabica/emulator/emulator.hpp>
+#include <cstdint>
+#include <vector>
+
+// Small roms standing in for the kinds of games the emulator runs, each of them leaning on one
+// part of it. They loop forever, so they can run for any number of frames.
+namespace arabica_synthetic_rom {
+
+// arithmetic and branches only
+//
+// 0x200: LD V[0], 0x00
+// 0x202: ADD V[0], 0x01
+// 0x204: LD V[1], V[0]
+// 0x206: XOR V[1], V[2]
+// 0x208: ADD V[2], V[1]
+// 0x20A: SHR V[2]
+// 0x20C: SE V[0], 0x00
+// 0x20E: JP 0x202
+// 0x210: JP 0x200
+const std::vector<uint8_t> alu{0x60, 0x00, 0x70, 0x01, 0x81, 0x00, 0x81, 0x23, 0x82,
+                               0x14, 0x82, 0x06, 0x30, 0x00, 0x12, 0x02, 0x12, 0x00};
+
+// the digits drawn all over the screen
+//
+// 0x200: LD V[3], 0x0F
+// 0x202: LD F, V[2]
+// 0x204: DRW V[0], V[1], 5
+// 0x206: ADD V[0], 0x05
+// 0x208: ADD V[1], 0x03
+// 0x20A: ADD V[2], 0x01
+// 0x20C: AND V[2], V[3]
+// 0x20E: JP 0x202
+const std::vector<uint8_t> draw{0x63, 0x0F, 0xF2, 0x29, 0xD0, 0x15, 0x70, 0x05,
+                                0x71, 0x03, 0x72, 0x01, 0x82, 0x32, 0x12, 0x02};
+
+// a subroutine working on memory
+//
+// 0x200: CALL 0x20A
+// 0x202: ADD V[0], 0x01
+// 0x204: SNE V[0], 0x40
+// 0x206: LD V[0], 0x00
+// 0x208: JP 0x200
+// 0x20A: LD I, 0x300
+// 0x20C: ADD I, V[0]
+// 0x20E: LD B, V[0]
+// 0x210: LD V[2], [I]
+// 0x212: RET
+const std::vector<uint8_t> calls{0x22, 0x0A, 0x70, 0x01, 0x40, 0x40, 0x60, 0x00, 0x12, 0x00,
+                                 0xA3, 0x00, 0xF0, 0x1E, 0xF0, 0x33, 0xF2, 0x65, 0x00, 0xEE};
+
+// waiting on the delay timer most of the time, like a game pacing itself
+//
+// 0x200: LD V[0], 0x02
+// 0x202: LD DT, V[0]
+// 0x204: LD V[1], DT
+// 0x206: SE V[1], 0x00
+// 0x208: JP 0x204
+// 0x20A: ADD V[2], 0x01
+// 0x20C: JP 0x200
+const std::vector<uint8_t> timer{0x60, 0x02, 0xF0, 0x15, 0xF1, 0x07, 0x31, 0x00, 0x12, 0x04, 0x72, 0x01, 0x12, 0x00};
+
+// pixels at random places
+//
+// 0x200: RND V[0], 0x3F
+// 0x202: RND V[1], 0x1F
+// 0x204: DRW V[0], V[1], 1
+// 0x206: JP 0x200
+const std::vector<uint8_t> random{0xC0, 0x3F, 0xC1, 0x1F, 0xD0, 0x11, 0x12, 0x00};
+
+inline void load(arabica::Emulator& emulator, const std::vector<uint8_t>& rom) {
+  for (std::size_t i = 0; i < rom.size(); ++i) {
+    emulator.memory.write(arabica::Memory::RESERVED + i, rom[i]);
+  }
+}
+
+} // namespace arabica_synthetic_rom
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <arabica/device/display.hpp>
+#include <arabica/simd/expand.hpp>
+#include <bench/bench.hpp>
+#include <fmt/core.h>
+#include <cstdint>
+#include <vector>
+
+namespace arabica_expand_bench {
+
+// from a thumbnail to a 1280x640 window
+constexpr int scales[] = {1, 2, 5, 10, 20};
+
+// a whole screen of sprites expanded at `scale`, what presenting a frame on the CPU costs
+inline void expand(arabica::bench::State&         state,
+                   const int                      scale,
+                   const arabica::simd::FILTER    filter,
+                   const arabica::simd::Expander& expander) {
+  constexpr uint8_t sprite[] = {0xF0, 0x90, 0x90, 0x90, 0xF0};
+  arabica::Display  display;
+  display.init();
+  for (int i = 0; i < 64; ++i) {
+    display.update(i * 7 & 63, i * 3 & 31, sprite, 5);
+  }
+  const int                   width = arabica::Display::PLANE_WIDTH * scale;
+  const arabica::simd::Bitmap bitmap{display.plane, 1, arabica::Display::PLANE_HEIGHT};
+  std::vector<uint32_t>       pixels(static_cast<std::size_t>(width) * arabica::Display::PLANE_HEIGHT * scale);
+
+  state.start();
+  for (uint64_t i = 0; i < state.iterations(); ++i) {
+    arabica::simd::expand(bitmap,
+                          scale,
+                          filter,
+                          arabica::Display::COLOR_ON,
+                          0,
+                          pixels.data(),
+                          width * static_cast<int>(sizeof(uint32_t)),
+                          expander);
+  }
+  state.stop();
+  arabica::bench::do_not_optimize(pixels[0]);
+}
+
+const bool is_expand_added = [] {
+  for (const arabica::simd::Expander* const expander : arabica::simd::supported_expanders()) {
+    for (const int scale : scales) {
+      arabica::bench::add(fmt::format("expand_{}_scale_{}", expander->name, scale),
+                          [scale, expander](arabica::bench::State& state) {
+                            expand(state, scale, arabica::simd::FILTER::NONE, *expander);
+                          });
+    }
+  }
+  for (const int scale : {2, 10}) {
+    arabica::bench::add(fmt::format("expand_epx_scale_{}", scale), [scale](arabica::bench::State& state) {
+      expand(state, scale, arabica::simd::FILTER::EPX, *arabica::simd::supported_expanders().front());
+    });
+  }
+  return true;
+}();
+
+} // namespace arabica_expand_bench
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <arabica/aot/program.hpp>
+#include <arabica/aot/translator.hpp>
+#include <arabica/emulator/emulator.hpp>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// A hand written translation of
+//
+// 0x200: LD V[0], 0x05
+// 0x202: LD V[1], 0x03
+// 0x204: JP 0x204
+//
+// its block also sets V[E], which tells whether the block or the interpreter ran.
+namespace arabica_aot_test {
+
+constexpr uint8_t rom[] = {0x60, 0x05, 0x61, 0x03, 0x12, 0x04};
+
+inline void block_200(arabica::Emulator& emulator) {
+  emulator.cpu.registers[0x0] = 0x05;
+  emulator.cpu.registers[0x1] = 0x03;
+  emulator.cpu.registers[0xE] = 0xAA;
+  emulator.cpu.pc             = 0x204;
+}
+
+constexpr arabica::aot::Block blocks[] = {{0x200, 2, 4, block_200}};
+
+const arabica::aot::Program program{"aot_test", rom, sizeof(rom), blocks, 1};
+
+// `program` is registered for the lifetime of the guard only, no other test picks it up
+struct Registered {
+  explicit Registered(const arabica::aot::Program& program)
+    : program(program) {
+    arabica::aot::Registry::add(program);
+  }
+
+  ~Registered() {
+    arabica::aot::Registry::remove(program);
+  }
+
+  const arabica::aot::Program& program;
+};
+
+// 0x200: LD V[0], 0x05
+// 0x202: ADD V[0], 0x01
+// 0x204: SE V[0], 0x06
+// 0x206: JP 0x200
+// 0x208: CALL 0x20C
+// 0x20A: JP 0x20A
+// 0x20C: LD V[1], 0x02
+// 0x20E: RET
+const std::vector<uint8_t> translated_rom{
+  0x60, 0x05, 0x70, 0x01, 0x30, 0x06, 0x12, 0x00, 0x22, 0x0C, 0x12, 0x0A, 0x61, 0x02, 0x00, 0xEE,
+};
+
+constexpr arabica::aot::Block translated_blocks[] = {
+  {0x200, 3, 6, nullptr},
+  {0x206, 1, 2, nullptr},
+  {0x208, 1, 2, nullptr},
+  {0x20A, 1, 2, nullptr},
+  {0x20C, 2, 4, nullptr},
+};
+
+} // namespace arabica_aot_test
+
+#define arabica_aot_test(test_case_name, test_case_body) \
+  TEST(aot_test_suite, test_case_name) {                 \
+    arabica::Emulator emulator;                          \
+    test_case_body                                       \
+  }
+
+// clang-format off
+
+arabica_aot_test(test_run_block,
+  ASSERT_TRUE(emulator.load(arabica_aot_test::program));
+  emulator.run(2);
+  ASSERT_EQ(emulator.cpu.pc, 0x204);
+  ASSERT_EQ(emulator.cpu.registers[0x1], 0x03);
+  ASSERT_EQ(emulator.cpu.registers[0xE], 0xAA);
+)
+
+arabica_aot_test(test_block_over_budget,
+  ASSERT_TRUE(emulator.load(arabica_aot_test::program));
+  emulator.run(1);
+  ASSERT_EQ(emulator.cpu.pc, 0x202);
+  ASSERT_EQ(emulator.cpu.registers[0x0], 0x05);
+  ASSERT_EQ(emulator.cpu.registers[0xE], 0x00);
+)
+
+arabica_aot_test(test_write_into_block,
+  ASSERT_TRUE(emulator.load(arabica_aot_test::program));
+  // LD V[1], 0x07
+  emulator.memory.write(0x203, 0x07);
+  emulator.run(2);
+  ASSERT_EQ(emulator.cpu.pc, 0x204);
+  ASSERT_EQ(emulator.cpu.registers[0x1], 0x07);
+  ASSERT_EQ(emulator.cpu.registers[0xE], 0x00);
+)
+
+arabica_aot_test(test_registry,
+  for (std::size_t i = 0; i < sizeof(arabica_aot_test::rom); ++i) {
+    emulator.memory.write(0x200 + i, arabica_aot_test::rom[i]);
+  }
+  {
+    const arabica_aot_test::Registered registered(arabica_aot_test::program);
+    ASSERT_EQ(arabica::aot::Registry::find(emulator.memory), &arabica_aot_test::program);
+    ASSERT_EQ(arabica::aot::Registry::find(arabica::Memory()), nullptr);
+  }
+  ASSERT_EQ(arabica::aot::Registry::find(emulator.memory), nullptr);
+)
+
+arabica_aot_test(test_translate_blocks,
+  const arabica::aot::Translator translator(arabica_aot_test::translated_rom);
+  const auto&                    blocks = translator.blocks();
+
+  ASSERT_EQ(blocks.size(), std::size(arabica_aot_test::translated_blocks));
+  for (std::size_t i = 0; i < blocks.size(); ++i) {
+    ASSERT_EQ(blocks[i].address, arabica_aot_test::translated_blocks[i].address);
+    ASSERT_EQ(blocks[i].length, arabica_aot_test::translated_blocks[i].length);
+  }
+
+  const std::string source = translator.emit("test.ch8");
+  ASSERT_NE(source.find("void block_20C(Emulator& emulator)"), std::string::npos);
+  ASSERT_NE(source.find("arabica::aot::Registry::add(program)"), std::string::npos);
+
+  // quotes and backslashes in the name are escaped in its string literal
+  const std::string quoted = translator.emit(R"(say "hi"\test.ch8)");
+  ASSERT_NE(quoted.find(R"(program{"say \"hi\"\\test.ch8", rom)"), std::string::npos);
+)
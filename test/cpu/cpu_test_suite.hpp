@@ -3,6 +3,7 @@
 #include <arabica/emulator/emulator.hpp>
 #include <gtest/gtest.h>
 #include <cstdint>
+#include <cstring>
 #include <algorithm>
 #include <array>
 
@@ -42,6 +43,28 @@ arabica_cpu_test(test_ret,
   ASSERT_EQ(emulator.cpu.stack.size(), 0);
 )
 
+arabica_cpu_test(test_stack_depth,
+  // a call deeper than the stack replaces the innermost return address
+  for (uint16_t i = 0; i <= arabica::Stack::DEPTH; ++i) {
+    emulator.cpu.stack.push(0x300 + 2 * i);
+  }
+  ASSERT_EQ(emulator.cpu.stack.size(), arabica::Stack::DEPTH);
+  ASSERT_EQ(emulator.cpu.stack.top(), 0x300 + 2 * arabica::Stack::DEPTH);
+  emulator.cpu.stack.pop();
+  ASSERT_EQ(emulator.cpu.stack.top(), 0x300 + 2 * (arabica::Stack::DEPTH - 2));
+)
+
+arabica_cpu_test(test_stack_with_a_corrupt_size,
+  // the size is the last member, a corrupt one is taken as a full stack
+  arabica::Stack stack;
+  const uint16_t size = 40;
+  std::memcpy(reinterpret_cast<uint8_t*>(&stack) + sizeof(stack) - sizeof(size), &size, sizeof(size));
+  stack.push(0x300);
+  ASSERT_EQ(stack.size(), arabica::Stack::DEPTH);
+  ASSERT_EQ(stack.top(), 0x300);
+  ASSERT_EQ(arabica::Stack{}.top(), 0);
+)
+
 arabica_cpu_test(test_se_vx_byte, 
   // LD V[0], 0x12
   emulator.memory.write(0x200, 0x60);
@@ -557,3 +580,130 @@ arabica_cpu_test(test_ld_st_vx,
   ASSERT_EQ(emulator.cpu.pc, 0x204);
   ASSERT_EQ(emulator.cpu.reg_sound, 0x1);
 )
+
+arabica_cpu_test(test_high_and_low,
+  emulator.display.init();
+  // HIGH
+  emulator.memory.write(0x200, 0x00);
+  emulator.memory.write(0x201, 0xFF);
+  emulator.single_step();
+  ASSERT_EQ(emulator.cpu.pc, 0x202);
+  ASSERT_TRUE(emulator.display.is_hires);
+  ASSERT_EQ(emulator.display.width(), 128);
+  ASSERT_EQ(emulator.display.height(), 64);
+
+  // LOW
+  emulator.memory.write(0x202, 0x00);
+  emulator.memory.write(0x203, 0xFE);
+  emulator.single_step();
+  ASSERT_EQ(emulator.cpu.pc, 0x204);
+  ASSERT_FALSE(emulator.display.is_hires);
+)
+
+arabica_cpu_test(test_scroll,
+  emulator.display.init();
+  emulator.display.plane[0] = 0x8000000000000001;
+  // SCD 3
+  emulator.memory.write(0x200, 0x00);
+  emulator.memory.write(0x201, 0xC3);
+  emulator.single_step();
+  ASSERT_EQ(emulator.cpu.pc, 0x202);
+  ASSERT_EQ(emulator.display.plane[0], 0);
+  ASSERT_EQ(emulator.display.plane[3], 0x8000000000000001);
+
+  // SCR
+  emulator.memory.write(0x202, 0x00);
+  emulator.memory.write(0x203, 0xFB);
+  emulator.single_step();
+  ASSERT_EQ(emulator.display.plane[3], 0x0800000000000000);
+
+  // SCL
+  emulator.memory.write(0x204, 0x00);
+  emulator.memory.write(0x205, 0xFC);
+  emulator.single_step();
+  ASSERT_EQ(emulator.cpu.pc, 0x206);
+  ASSERT_EQ(emulator.display.plane[3], 0x8000000000000000);
+  ASSERT_TRUE(emulator.display.is_refresh);
+)
+
+arabica_cpu_test(test_drw_16x16,
+  emulator.display.init();
+  for (uint16_t i = 0; i < 32; ++i) {
+    emulator.memory.write(0x300 + i, i % 2 == 0 ? 0xFF : 0x01);
+  }
+  // HIGH
+  emulator.memory.write(0x200, 0x00);
+  emulator.memory.write(0x201, 0xFF);
+  // LD I, 0x300
+  emulator.memory.write(0x202, 0xA3);
+  emulator.memory.write(0x203, 0x00);
+  // LD V[0], 120
+  emulator.memory.write(0x204, 0x60);
+  emulator.memory.write(0x205, 0x78);
+  // DRW V[0], V[0], 0
+  emulator.memory.write(0x206, 0xD0);
+  emulator.memory.write(0x207, 0x00);
+  for (int i = 0; i < 4; ++i) {
+    emulator.single_step();
+  }
+  // 0xFF01 at x = 120 wraps after 8 pixels, on rows 56 to 63 and 0 to 7 as y = 120 wraps too
+  ASSERT_EQ(emulator.display.plane[2 * 56 + 1], 0x00000000000000FF);
+  ASSERT_EQ(emulator.display.plane[2 * 56], 0x0100000000000000);
+  ASSERT_EQ(emulator.display.plane[2 * 7 + 1], 0x00000000000000FF);
+  ASSERT_EQ(emulator.display.plane[2 * 8 + 1], 0);
+  ASSERT_EQ(emulator.cpu.registers[0xF], 0);
+
+  // drawn again, it erases itself
+  emulator.cpu.pc = 0x206;
+  emulator.single_step();
+  ASSERT_EQ(emulator.cpu.registers[0xF], 1);
+  ASSERT_EQ(emulator.display.plane[2 * 56], 0);
+)
+
+arabica_cpu_test(test_ld_hf_vx,
+  // LD V[0], 0x7
+  emulator.memory.write(0x200, 0x60);
+  emulator.memory.write(0x201, 0x07);
+  emulator.single_step();
+
+  // LD HF, V[0]
+  emulator.memory.write(0x202, 0xF0);
+  emulator.memory.write(0x203, 0x30);
+  emulator.single_step();
+  ASSERT_EQ(emulator.cpu.pc, 0x204);
+  ASSERT_EQ(emulator.cpu.reg_I, arabica::Memory::BIG_FONT + 7 * 10);
+  ASSERT_EQ(emulator.memory[emulator.cpu.reg_I], 0xFF);
+)
+
+arabica_cpu_test(test_ld_r_vx_and_ld_vx_r,
+  for (uint8_t i = 0; i < arabica::CPU::REGISTER_COUNT; ++i) {
+    emulator.cpu.registers[i] = 0x10 + i;
+  }
+  // LD R, V[F], only V[0] to V[7] are kept
+  emulator.memory.write(0x200, 0xFF);
+  emulator.memory.write(0x201, 0x75);
+  emulator.single_step();
+  ASSERT_EQ(emulator.cpu.pc, 0x202);
+  ASSERT_EQ(emulator.cpu.rpl[7], 0x17);
+
+  std::fill(emulator.cpu.registers, emulator.cpu.registers + arabica::CPU::REGISTER_COUNT, 0);
+  // LD V[3], R
+  emulator.memory.write(0x202, 0xF3);
+  emulator.memory.write(0x203, 0x85);
+  emulator.single_step();
+  ASSERT_EQ(emulator.cpu.pc, 0x204);
+  ASSERT_EQ(emulator.cpu.registers[0], 0x10);
+  ASSERT_EQ(emulator.cpu.registers[3], 0x13);
+  ASSERT_EQ(emulator.cpu.registers[4], 0x00);
+)
+
+arabica_cpu_test(test_exit,
+  // EXIT, the rest of the frame is spent on it
+  emulator.memory.write(0x200, 0x00);
+  emulator.memory.write(0x201, 0xFD);
+  emulator.single_step();
+  ASSERT_EQ(emulator.cpu.pc, 0x200);
+  emulator.execute();
+  ASSERT_EQ(emulator.cpu.pc, 0x200);
+  ASSERT_EQ(emulator.idle_cycles, emulator.cpu.clock_speed / emulator.fps);
+)
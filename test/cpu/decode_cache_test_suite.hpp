@@ -0,0 +1,66 @@
+#pragma once
+
+#include <arabica/emulator/emulator.hpp>
+#include <gtest/gtest.h>
+#include <cstdint>
+
+#define arabica_decode_cache_test(test_case_name, test_case_body) \
+  TEST(decode_cache_test_suite, test_case_name) {                 \
+    arabica::Emulator emulator;                                   \
+    test_case_body                                                \
+  }
+
+// clang-format off
+
+arabica_decode_cache_test(test_rewrite_cached_instruction,
+  // LD V[0], 0x01
+  emulator.memory.write(0x200, 0x60);
+  emulator.memory.write(0x201, 0x01);
+  emulator.single_step();
+  ASSERT_EQ(emulator.cpu.registers[0], 0x01);
+
+  // LD V[0], 0x02 on the same address
+  emulator.memory.write(0x201, 0x02);
+  emulator.cpu.pc = 0x200;
+  emulator.single_step();
+  ASSERT_EQ(emulator.cpu.registers[0], 0x02);
+
+  // LD V[1], 0x02 through the subscript operator
+  emulator.memory[0x200] = 0x61;
+  emulator.cpu.pc = 0x200;
+  emulator.single_step();
+  ASSERT_EQ(emulator.cpu.registers[1], 0x02);
+)
+
+arabica_decode_cache_test(test_self_modifying_program,
+  // 0x200: LD V[0], 0x70
+  // 0x202: LD V[1], 0x05
+  // 0x204: LD I, 0x20A
+  // 0x206: LD [I], V[1]    overwrite 0x20A with 0x70 0x05 (ADD V[0], 0x05)
+  // 0x208: JP 0x20A
+  // 0x20A: LD V[0], 0x00
+  emulator.memory.write(0x200, 0x60);
+  emulator.memory.write(0x201, 0x70);
+  emulator.memory.write(0x202, 0x61);
+  emulator.memory.write(0x203, 0x05);
+  emulator.memory.write(0x204, 0xA2);
+  emulator.memory.write(0x205, 0x0A);
+  emulator.memory.write(0x206, 0xF1);
+  emulator.memory.write(0x207, 0x55);
+  emulator.memory.write(0x208, 0x12);
+  emulator.memory.write(0x209, 0x0A);
+  emulator.memory.write(0x20A, 0x60);
+  emulator.memory.write(0x20B, 0x00);
+
+  // warm the cache with the original instruction at 0x20A
+  emulator.cpu.pc = 0x20A;
+  emulator.single_step();
+  ASSERT_EQ(emulator.cpu.registers[0], 0x00);
+
+  emulator.cpu.pc = 0x200;
+  for (int i = 0; i < 6; ++i) {
+    emulator.single_step();
+  }
+  ASSERT_EQ(emulator.cpu.pc, 0x20C);
+  ASSERT_EQ(emulator.cpu.registers[0], 0x75);
+)
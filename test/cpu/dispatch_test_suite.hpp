@@ -0,0 +1,58 @@
+#pragma once
+
+#include <arabica/emulator/emulator.hpp>
+#include <gtest/gtest.h>
+#include <cstdint>
+
+#define arabica_dispatch_test(test_case_name, test_case_body) \
+  TEST(dispatch_test_suite, test_case_name) {                 \
+    arabica::Emulator emulator;                               \
+    arabica::Emulator reference;                              \
+    test_case_body                                            \
+  }
+
+// clang-format off
+
+arabica_dispatch_test(test_run_matches_single_step,
+  // 0x200: LD V[0], 0x00
+  // 0x202: ADD V[0], 0x03
+  // 0x204: LD V[1], V[0]
+  // 0x206: SHR V[1]
+  // 0x208: SNE V[0], 0x30
+  // 0x20A: JP 0x20A
+  // 0x20C: JP 0x202
+  emulator.memory.write(0x200, 0x60);
+  emulator.memory.write(0x201, 0x00);
+  emulator.memory.write(0x202, 0x70);
+  emulator.memory.write(0x203, 0x03);
+  emulator.memory.write(0x204, 0x81);
+  emulator.memory.write(0x205, 0x00);
+  emulator.memory.write(0x206, 0x81);
+  emulator.memory.write(0x207, 0x16);
+  emulator.memory.write(0x208, 0x40);
+  emulator.memory.write(0x209, 0x30);
+  emulator.memory.write(0x20A, 0x12);
+  emulator.memory.write(0x20B, 0x0A);
+  emulator.memory.write(0x20C, 0x12);
+  emulator.memory.write(0x20D, 0x02);
+  reference.memory = emulator.memory;
+
+  emulator.run(100);
+  for (int i = 0; i < 100; ++i) {
+    reference.single_step();
+  }
+
+  ASSERT_EQ(emulator.cpu.pc, reference.cpu.pc);
+  ASSERT_EQ(emulator.cpu.pc, 0x20A);
+  for (int i = 0; i < arabica::CPU::REGISTER_COUNT; ++i) {
+    ASSERT_EQ(emulator.cpu.registers[i], reference.cpu.registers[i]);
+  }
+)
+
+arabica_dispatch_test(test_unknown_instruction,
+  emulator.memory.write(0x200, 0xE1);
+  emulator.memory.write(0x201, 0x07);
+  emulator.run(10);
+  ASSERT_EQ(emulator.cpu.pc, 0x200);
+  ASSERT_EQ(emulator.cpu.registers[1], 0x00);
+)
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <arabica/emulator/emulator.hpp>
+#include <gtest/gtest.h>
+#include <cstdint>
+
+// Every program runs fused on `emulator` and one instruction at a time on `reference`,
+// both have to end up in the same state.
+#define arabica_fusion_test(test_case_name, instructions, test_case_body) \
+  TEST(fusion_test_suite, test_case_name) {                               \
+    arabica::Emulator emulator;                                           \
+    arabica::Emulator reference;                                          \
+    emulator.display.init();                                              \
+    reference.display.init();                                             \
+    test_case_body                                                        \
+    reference.memory = emulator.memory;                                   \
+    emulator.run(instructions);                                           \
+    for (int i = 0; i < instructions; ++i) {                              \
+      reference.single_step();                                            \
+    }                                                                     \
+    ASSERT_EQ(emulator.cpu.pc, reference.cpu.pc);                         \
+    ASSERT_EQ(emulator.cpu.reg_I, reference.cpu.reg_I);                   \
+    ASSERT_EQ(emulator.delay.get(), reference.delay.get());               \
+    for (int i = 0; i < arabica::CPU::REGISTER_COUNT; ++i) {              \
+      ASSERT_EQ(emulator.cpu.registers[i], reference.cpu.registers[i]);   \
+    }                                                                     \
+  }
+
+// clang-format off
+
+arabica_fusion_test(test_ld_i_drw, 6,
+  // 0x200: LD I, 0x000     font sprite of 0
+  // 0x202: DRW V[0], V[1], 5
+  // 0x204: DRW V[0], V[1], 5  collision, VF = 1
+  // 0x206: LD I, 0x005
+  // 0x208: DRW V[0], V[1], 5
+  // 0x20A: JP 0x20A
+  emulator.memory.write(0x200, 0xA0);
+  emulator.memory.write(0x201, 0x00);
+  emulator.memory.write(0x202, 0xD0);
+  emulator.memory.write(0x203, 0x15);
+  emulator.memory.write(0x204, 0xD0);
+  emulator.memory.write(0x205, 0x15);
+  emulator.memory.write(0x206, 0xA0);
+  emulator.memory.write(0x207, 0x05);
+  emulator.memory.write(0x208, 0xD0);
+  emulator.memory.write(0x209, 0x15);
+  emulator.memory.write(0x20A, 0x12);
+  emulator.memory.write(0x20B, 0x0A);
+)
+
+arabica_fusion_test(test_ld_vx_dt, 3,
+  // 0x200: LD V[3], 0x20
+  // 0x202: LD DT, V[3]
+  // 0x204: LD V[4], 0x01
+  emulator.memory.write(0x200, 0x63);
+  emulator.memory.write(0x201, 0x20);
+  emulator.memory.write(0x202, 0xF3);
+  emulator.memory.write(0x203, 0x15);
+  emulator.memory.write(0x204, 0x64);
+  emulator.memory.write(0x205, 0x01);
+)
+
+arabica_fusion_test(test_counter_loop, 100,
+  // 0x200: ADD V[2], 0x03
+  // 0x202: SE V[2], 0x1E
+  // 0x204: JP 0x200
+  // 0x206: LD V[5], 0x01
+  // 0x208: JP 0x208
+  emulator.memory.write(0x200, 0x72);
+  emulator.memory.write(0x201, 0x03);
+  emulator.memory.write(0x202, 0x32);
+  emulator.memory.write(0x203, 0x1E);
+  emulator.memory.write(0x204, 0x12);
+  emulator.memory.write(0x205, 0x00);
+  emulator.memory.write(0x206, 0x65);
+  emulator.memory.write(0x207, 0x01);
+  emulator.memory.write(0x208, 0x12);
+  emulator.memory.write(0x209, 0x08);
+)
+
+// 31 instructions stop in the middle of the third iteration, the fused loop must not overrun it
+arabica_fusion_test(test_counter_loop_budget, 8,
+  emulator.memory.write(0x200, 0x72);
+  emulator.memory.write(0x201, 0x03);
+  emulator.memory.write(0x202, 0x32);
+  emulator.memory.write(0x203, 0x1E);
+  emulator.memory.write(0x204, 0x12);
+  emulator.memory.write(0x205, 0x00);
+)
+
+arabica_fusion_test(test_delay_poll, 20,
+  // 0x200: LD V[0], 0x00
+  // 0x202: LD V[0], DT
+  // 0x204: SE V[0], 0x00
+  // 0x206: JP 0x202
+  // 0x208: JP 0x208
+  emulator.delay.set(3);
+  reference.delay.set(3);
+  emulator.memory.write(0x200, 0x60);
+  emulator.memory.write(0x201, 0x00);
+  emulator.memory.write(0x202, 0xF0);
+  emulator.memory.write(0x203, 0x07);
+  emulator.memory.write(0x204, 0x30);
+  emulator.memory.write(0x205, 0x00);
+  emulator.memory.write(0x206, 0x12);
+  emulator.memory.write(0x207, 0x02);
+  emulator.memory.write(0x208, 0x12);
+  emulator.memory.write(0x209, 0x08);
+)
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <arabica/emulator/emulator.hpp>
+#include <gtest/gtest.h>
+#include <cstdint>
+
+#define arabica_idle_test(test_case_name, test_case_body) \
+  TEST(idle_test_suite, test_case_name) {                 \
+    arabica::Emulator emulator;                           \
+    arabica::Emulator reference;                          \
+    test_case_body                                        \
+  }
+
+// clang-format off
+
+arabica_idle_test(test_jump_to_self,
+  // 0x200: LD V[0], 0x01
+  // 0x202: JP 0x202
+  emulator.memory.write(0x200, 0x60);
+  emulator.memory.write(0x201, 0x01);
+  emulator.memory.write(0x202, 0x12);
+  emulator.memory.write(0x203, 0x02);
+
+  emulator.run(10);
+  ASSERT_EQ(emulator.cpu.pc, 0x202);
+  ASSERT_EQ(emulator.cpu.registers[0], 0x01);
+  ASSERT_EQ(emulator.idle_cycles, 9);
+
+  emulator.execute();
+  ASSERT_EQ(emulator.idle_cycles, emulator.cpu.clock_speed / emulator.fps);
+  ASSERT_FLOAT_EQ(emulator.idle_percentage, 100.0f);
+)
+
+arabica_idle_test(test_key_wait,
+  // 0x200: LD V[3], K
+  emulator.memory.write(0x200, 0xF3);
+  emulator.memory.write(0x201, 0x0A);
+
+  emulator.run(10);
+  ASSERT_EQ(emulator.cpu.pc, 0x200);
+  ASSERT_EQ(emulator.idle_cycles, 10);
+
+  emulator.keypad.on_keydown(0x5);
+  emulator.run(1);
+  ASSERT_EQ(emulator.cpu.pc, 0x202);
+  ASSERT_EQ(emulator.cpu.registers[3], 0x05);
+)
+
+arabica_idle_test(test_delay_poll,
+  // 0x200: LD V[2], DT
+  // 0x202: SE V[2], 0x00
+  // 0x204: JP 0x200
+  // 0x206: LD V[1], 0x01
+  // 0x208: JP 0x208
+  emulator.memory.write(0x200, 0xF2);
+  emulator.memory.write(0x201, 0x07);
+  emulator.memory.write(0x202, 0x32);
+  emulator.memory.write(0x203, 0x00);
+  emulator.memory.write(0x204, 0x12);
+  emulator.memory.write(0x205, 0x00);
+  emulator.memory.write(0x206, 0x61);
+  emulator.memory.write(0x207, 0x01);
+  emulator.memory.write(0x208, 0x12);
+  emulator.memory.write(0x209, 0x08);
+  reference.memory = emulator.memory;
+  emulator.delay.set(2);
+  reference.delay.set(2);
+
+  // budgets which are not a multiple of the loop length leave the poll half way
+  for (const int budget : {8, 7, 9}) {
+    emulator.run(budget);
+    for (int i = 0; i < budget; ++i) {
+      reference.single_step();
+    }
+    ASSERT_EQ(emulator.cpu.pc, reference.cpu.pc);
+    for (int i = 0; i < arabica::CPU::REGISTER_COUNT; ++i) {
+      ASSERT_EQ(emulator.cpu.registers[i], reference.cpu.registers[i]);
+    }
+    emulator.delay.tick();
+    reference.delay.tick();
+  }
+  ASSERT_EQ(emulator.cpu.registers[1], 0x01);
+  ASSERT_GT(emulator.idle_cycles, 0);
+)
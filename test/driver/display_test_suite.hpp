@@ -0,0 +1,295 @@
+#pragma once
+
+#include <arabica/device/display.hpp>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+namespace arabica_display_test {
+
+// the screen a pixel at a time, wrapping each pixel on its own
+struct Reference {
+  int  width{arabica::Display::PLANE_WIDTH};
+  int  height{arabica::Display::PLANE_HEIGHT};
+  bool pixels[arabica::Display::HIRES_HEIGHT][arabica::Display::HIRES_WIDTH] = {};
+
+  // `bytes` per sprite row, 2 for the 16x16 sprites
+  int update(const int reg_vx, const int reg_vy, const uint8_t* const sprite, const int rows, const int bytes = 1) {
+    int collision = 0;
+    for (int y = 0; y < rows; ++y) {
+      for (int x = 0; x < 8 * bytes; ++x) {
+        if ((sprite[y * bytes + x / 8] >> (7 - x % 8)) & 1) {
+          const int row    = (reg_vy + y) % height;
+          const int column = (reg_vx + x) % width;
+          collision |= pixels[row][column] ? 1 : 0;
+          pixels[row][column] = !pixels[row][column];
+        }
+      }
+    }
+    return collision;
+  }
+
+  // pixels move by (`dx`, `dy`), what leaves the screen is lost
+  void scroll(const int dx, const int dy) {
+    Reference scrolled = *this;
+    for (int y = 0; y < height; ++y) {
+      for (int x = 0; x < width; ++x) {
+        const int  from_x     = x - dx;
+        const int  from_y     = y - dy;
+        const bool is_inside  = from_x >= 0 && from_x < width && from_y >= 0 && from_y < height;
+        scrolled.pixels[y][x] = is_inside && pixels[from_y][from_x];
+      }
+    }
+    *this = scrolled;
+  }
+
+  void expect_same(const arabica::Display& display) const {
+    ASSERT_EQ(display.width(), width);
+    ASSERT_EQ(display.height(), height);
+    for (int y = 0; y < height; ++y) {
+      for (int x = 0; x < width; ++x) {
+        ASSERT_EQ(display.is_on(x, y), pixels[y][x]) << x << ", " << y;
+      }
+    }
+  }
+};
+
+constexpr arabica::Display::Rect screen{0, 0, arabica::Display::PLANE_WIDTH, arabica::Display::PLANE_HEIGHT};
+
+constexpr uint8_t sprite[] = {0xF0, 0x90, 0x90, 0x90, 0xF0, 0x81, 0xFF, 0x18, 0x3C, 0x7E, 0xC3, 0x99, 0x01, 0x80, 0xAA};
+
+// 16x16, every row different and not symmetric
+constexpr uint8_t large_sprite[] = {
+  0xFF, 0x01, 0x80, 0xFE, 0x3C, 0x42, 0x18, 0x24, 0xAA, 0x55, 0x0F, 0xF0, 0x81, 0x7E, 0xC3, 0x3C,
+  0x99, 0x66, 0x01, 0x00, 0x00, 0x80, 0xF0, 0x0F, 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0,
+};
+
+} // namespace arabica_display_test
+
+#define arabica_display_test(test_case_name, test_case_body) \
+  TEST(display_test_suite, test_case_name) {                 \
+    using namespace arabica_display_test;                    \
+    arabica::Display display;                                \
+    display.init();                                          \
+    test_case_body                                           \
+  }
+
+// clang-format off
+
+arabica_display_test(test_draw_matches_pixel_by_pixel,
+  // every position, the edges and the registers past them included, drawn twice to erase it again
+  Reference reference;
+  for (int pass = 0; pass < 2; ++pass) {
+    for (int y = 0; y < 40; ++y) {
+      for (int x = 0; x < 72; x += 3) {
+        const int rows = 1 + (x + y) % 15;
+        ASSERT_EQ(display.update(x, y, sprite, rows), reference.update(x, y, sprite, rows)) << x << ", " << y;
+      }
+    }
+    reference.expect_same(display);
+  }
+)
+
+arabica_display_test(test_hires_draw_matches_pixel_by_pixel,
+  // 8x15 and 16x16 sprites over the 128x64 screen, the edges and the registers past them included
+  Reference reference;
+  reference.width  = arabica::Display::HIRES_WIDTH;
+  reference.height = arabica::Display::HIRES_HEIGHT;
+  display.set_hires(true);
+  for (int pass = 0; pass < 2; ++pass) {
+    for (int y = 0; y < 72; y += 5) {
+      for (int x = 0; x < 140; x += 3) {
+        if ((x + y) % 2 == 0) {
+          const int collision = reference.update(x, y, large_sprite, 16, 2);
+          ASSERT_EQ(display.update_large(x, y, large_sprite), collision) << x << ", " << y;
+        } else {
+          ASSERT_EQ(display.update(x, y, sprite, 15), reference.update(x, y, sprite, 15)) << x << ", " << y;
+        }
+      }
+    }
+    reference.expect_same(display);
+  }
+)
+
+arabica_display_test(test_scroll_matches_pixel_by_pixel,
+  for (const bool is_hires : {false, true}) {
+    Reference reference;
+    display.set_hires(is_hires);
+    reference.width  = display.width();
+    reference.height = display.height();
+    for (int i = 0; i < 40; ++i) {
+      display.update_large(i * 11, i * 7, large_sprite);
+      reference.update(i * 11, i * 7, large_sprite, 16, 2);
+    }
+    display.scroll_down(5);
+    reference.scroll(0, 5);
+    reference.expect_same(display);
+    display.scroll_right(4);
+    reference.scroll(4, 0);
+    reference.expect_same(display);
+    display.scroll_left(4);
+    display.scroll_left(4);
+    reference.scroll(-8, 0);
+    reference.expect_same(display);
+  }
+)
+
+arabica_display_test(test_scroll_dirties_what_changed,
+  display.update(0, 0, sprite + 6, 1); // 0xFF on the first row
+  display.clean();
+  display.scroll_down(2);
+  std::vector<arabica::Display::Rect> rects;
+  display.dirty_rects(rects);
+  ASSERT_EQ(rects.size(), 2);
+  ASSERT_EQ(rects[0].y, 0);
+  ASSERT_EQ(rects[1].y, 2);
+  ASSERT_EQ(rects[1].width, 8);
+
+  display.clean();
+  display.scroll_right(4);
+  display.dirty_rects(rects);
+  ASSERT_EQ(rects.size(), 1);
+  ASSERT_EQ(rects[0].x, 0);
+  ASSERT_EQ(rects[0].width, 12); // the first 4 pixels go off, 4 more come on past the end
+)
+
+arabica_display_test(test_switching_resolution_clears_the_screen,
+  display.update(0, 0, sprite, 5);
+  display.clean();
+  display.set_hires(true);
+  std::vector<arabica::Display::Rect> rects;
+  display.dirty_rects(rects);
+  ASSERT_EQ(rects.size(), 1);
+  ASSERT_EQ(rects[0].width * rects[0].height, arabica::Display::HIRES_WIDTH * arabica::Display::HIRES_HEIGHT);
+  for (int y = 0; y < display.height(); ++y) {
+    for (int x = 0; x < display.width(); ++x) {
+      ASSERT_FALSE(display.is_on(x, y));
+    }
+  }
+  display.clean();
+  display.set_hires(true); // already there, nothing changes
+  ASSERT_FALSE(display.is_dirty());
+)
+
+arabica_display_test(test_hires_dirty_rects_cross_words,
+  std::vector<arabica::Display::Rect> rects;
+  display.set_hires(true);
+  display.clean();
+  // 0xFF at x = 60 straddles the two words of the row
+  display.update(60, 40, sprite + 6, 1);
+  display.update(124, 63, sprite + 6, 1); // wraps past the right edge
+  display.dirty_rects(rects);
+  ASSERT_EQ(rects.size(), 3);
+  ASSERT_EQ(rects[0].x, 60);
+  ASSERT_EQ(rects[0].y, 40);
+  ASSERT_EQ(rects[0].width, 8);
+  ASSERT_EQ(rects[1].x, 0);
+  ASSERT_EQ(rects[1].width, 4);
+  ASSERT_EQ(rects[2].x, 124);
+  ASSERT_EQ(rects[2].width, 4);
+)
+
+arabica_display_test(test_draw_wraps_around,
+  // a byte at x = 60 is split between the last four and the first four columns
+  ASSERT_EQ(display.update(60, 31, sprite + 6, 2), 0);
+  ASSERT_EQ(display.plane[31], 0xF00000000000000F);
+  ASSERT_EQ(display.plane[0], 0x8000000000000001);
+  ASSERT_EQ(display.update(63, 0, sprite + 6, 1), 1);
+)
+
+arabica_display_test(test_hash_follows_the_plane,
+  arabica::Display other;
+  other.init();
+  display.update(10, 20, sprite, 15);
+  other.update(10, 20, sprite, 15);
+  ASSERT_EQ(display.hash(), other.hash());
+  display.reset();
+  ASSERT_NE(display.hash(), other.hash());
+)
+
+arabica_display_test(test_dirty_rects,
+  std::vector<arabica::Display::Rect> rects;
+  display.dirty_rects(rects);
+  ASSERT_EQ(rects.size(), 1); // a fresh display has everything to paint
+  ASSERT_EQ(rects[0].width * rects[0].height, arabica::Display::PLANE_WIDTH * arabica::Display::PLANE_HEIGHT);
+
+  display.clean();
+  ASSERT_FALSE(display.is_dirty());
+  display.dirty_rects(rects);
+  ASSERT_TRUE(rects.empty());
+
+  // 0xF0 0x90 ... covers columns 10 to 13, the hole in the middle rows stays in the rectangle
+  display.update(10, 5, sprite, 5);
+  display.update(20, 6, sprite, 1); // 6 columns away, merged
+  display.update(40, 6, sprite, 1); // far away, a rectangle of its own
+  display.dirty_rects(rects);
+  ASSERT_EQ(rects.size(), 2);
+  ASSERT_EQ(rects[0].x, 10);
+  ASSERT_EQ(rects[0].y, 5);
+  ASSERT_EQ(rects[0].width, 14);
+  ASSERT_EQ(rects[0].height, 5);
+  ASSERT_EQ(rects[1].x, 40);
+  ASSERT_EQ(rects[1].width, 4);
+)
+
+arabica_display_test(test_dirty_rects_wrap_around,
+  std::vector<arabica::Display::Rect> rects;
+  display.clean();
+  // 0xFF split over both edges, on the last and the first row
+  display.update(62, 31, sprite + 6, 1);
+  display.update(62, 0, sprite + 6, 1);
+  display.dirty_rects(rects);
+  ASSERT_EQ(rects.size(), 4);
+  for (const arabica::Display::Rect& rect : rects) {
+    ASSERT_EQ(rect.height, 1);
+    ASSERT_TRUE(rect.y == 0 || rect.y == 31);
+    ASSERT_EQ(rect.width, rect.x == 0 ? 6 : 2);
+  }
+)
+
+arabica_display_test(test_clear_only_dirties_what_was_on,
+  display.update(0, 3, sprite, 2);
+  display.clean();
+  display.reset();
+  for (int y = 0; y < arabica::Display::PLANE_HEIGHT; ++y) {
+    const uint64_t on = y == 3 ? 0xF000000000000000 : y == 4 ? 0x9000000000000000 : 0;
+    ASSERT_EQ(display.dirty[y], on) << y;
+  }
+)
+
+arabica_display_test(test_partial_render_matches_full_render,
+  constexpr int                       pitch = arabica::Display::PLANE_WIDTH * sizeof(uint32_t);
+  std::vector<arabica::Display::Rect> rects;
+  std::vector<uint32_t>               partial(arabica::Display::PLANE_WIDTH * arabica::Display::PLANE_HEIGHT);
+  std::vector<uint32_t>               full(partial.size());
+  display.render(partial.data(), pitch, screen);
+  display.clean();
+  for (int i = 0; i < 50; ++i) {
+    display.update(i * 13 % 70, i * 7 % 40, sprite + i % 10, 1 + i % 5);
+    if (i % 10 == 9) {
+      display.dirty_rects(rects);
+      for (const arabica::Display::Rect& rect : rects) {
+        display.render(&partial[rect.y * arabica::Display::PLANE_WIDTH + rect.x], pitch, rect);
+      }
+      display.clean();
+      display.render(full.data(), pitch, screen);
+      ASSERT_EQ(partial, full) << i;
+    }
+  }
+)
+
+arabica_display_test(test_native_render_with_pitch,
+  // a rectangle written into a buffer with lines wider than it, like a locked texture
+  constexpr int         pitch = 16 * sizeof(uint32_t);
+  std::vector<uint32_t> pixels(16 * 4, 0xDEADBEEF);
+  display.update(58, 10, sprite + 6, 3);
+  display.render(pixels.data(), pitch, arabica::Display::Rect{54, 10, 10, 3});
+  for (int y = 0; y < 4; ++y) {
+    for (int x = 0; x < 16; ++x) {
+      const uint32_t color = display.is_on(54 + x, 10 + y) ? arabica::Display::COLOR_ON : 0;
+      ASSERT_EQ(pixels[y * 16 + x], x >= 10 || y >= 3 ? 0xDEADBEEF : color) << x << ", " << y;
+    }
+  }
+  ASSERT_EQ(pixels[4], arabica::Display::COLOR_ON);
+  ASSERT_EQ(pixels[3], 0);
+)
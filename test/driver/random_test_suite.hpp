@@ -0,0 +1,102 @@
+#pragma once
+
+#include <arabica/device/random.hpp>
+#include <arabica/emulator/emulator.hpp>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace arabica_random_test {
+
+// RND V[0], 0xFF in a loop
+// 0x200: RND V[0], 0xFF
+// 0x202: JP 0x200
+const std::vector<uint8_t> rom{0xC0, 0xFF, 0x12, 0x00};
+
+// the first outputs of xoshiro128** from the state {1, 2, 3, 4}
+constexpr arabica::Xoshiro128 reference_state{{1, 2, 3, 4}};
+constexpr uint32_t            reference[] = {11520, 0, 5927040, 70819200, 2031721883, 1637235492};
+
+// the values of RND V[0], 0xFF over `count` loop iterations
+inline std::vector<uint8_t> draw(arabica::Emulator& emulator, const int count) {
+  std::vector<uint8_t> bytes;
+  for (int i = 0; i < count; ++i) {
+    emulator.single_step();
+    bytes.push_back(emulator.cpu.registers[0]);
+    emulator.single_step();
+  }
+  return bytes;
+}
+
+} // namespace arabica_random_test
+
+#define arabica_random_test(test_case_name, test_case_body) \
+  TEST(random_test_suite, test_case_name) {                 \
+    using namespace arabica_random_test;                    \
+    arabica::Emulator emulator;                             \
+    emulator.load(rom);                                     \
+    test_case_body                                          \
+  }
+
+// clang-format off
+
+arabica_random_test(test_reference_sequence,
+  arabica::Xoshiro128 generator = reference_state;
+  for (const uint32_t value : reference) {
+    ASSERT_EQ(generator.next(), value);
+  }
+)
+
+arabica_random_test(test_same_seed_same_run,
+  emulator.random.seed(42);
+  const std::vector<uint8_t> first = draw(emulator, 64);
+
+  arabica::Emulator other;
+  other.load(rom);
+  other.random.seed(42);
+  ASSERT_EQ(draw(other, 64), first);
+
+  emulator.random.seed(43);
+  ASSERT_NE(draw(emulator, 64), first);
+)
+
+arabica_random_test(test_replay_a_recorded_stream,
+  emulator.random.seed(7);
+  emulator.random.record();
+  const std::vector<uint8_t> recorded = draw(emulator, 32);
+  ASSERT_EQ(emulator.random.stream(), recorded);
+
+  // another seed, the stream wins until it runs out
+  emulator.random.seed(8);
+  emulator.random.replay(recorded);
+  ASSERT_EQ(draw(emulator, 32), recorded);
+  ASSERT_EQ(emulator.random.remaining(), 0);
+  ASSERT_NE(draw(emulator, 32), recorded);
+)
+
+arabica_random_test(test_restore_rewinds_the_generator,
+  emulator.random.seed(99);
+  draw(emulator, 10);
+  const arabica::MachineState saved = emulator.snapshot();
+  const std::vector<uint8_t>  ahead = draw(emulator, 16);
+
+  emulator.restore(saved);
+  ASSERT_EQ(draw(emulator, 16), ahead);
+)
+
+arabica_random_test(test_replay_a_saved_stream,
+  const std::string path = (std::filesystem::temp_directory_path() / "arabica_random_test.rng").string();
+  emulator.random.record();
+  const std::vector<uint8_t> recorded = draw(emulator, 32);
+  ASSERT_TRUE(emulator.random.save(path));
+
+  arabica::Emulator other;
+  other.load(rom);
+  other.random.seed(1);
+  ASSERT_TRUE(other.random.load(path));
+  std::filesystem::remove(path);
+  ASSERT_EQ(draw(other, 32), recorded);
+  ASSERT_FALSE(other.random.load(path));
+)
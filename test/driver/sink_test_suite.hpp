@@ -0,0 +1,91 @@
+#pragma once
+
+#include <arabica/device/sink.hpp>
+#include <arabica/emulator/emulator.hpp>
+#include <gtest/gtest.h>
+
+namespace arabica_sink_test {
+
+class Recorder
+  : public arabica::AudioSink
+  , public arabica::VideoSink {
+public:
+  void start_beep() override {
+    is_beeping = true;
+  }
+
+  void stop_beep() override {
+    is_beeping = false;
+  }
+
+  void on_frame(const arabica::Display&) override {
+    ++frames;
+  }
+
+  bool is_beeping{false};
+  int  frames{0};
+};
+
+} // namespace arabica_sink_test
+
+#define arabica_sink_test(test_case_name, test_case_body) \
+  TEST(sink_test_suite, test_case_name) {                 \
+    arabica::Emulator           emulator;                 \
+    arabica_sink_test::Recorder recorder;                 \
+    emulator.display.init();                              \
+    emulator.sound.set_sink(&recorder);                   \
+    emulator.set_video_sink(&recorder);                   \
+    test_case_body                                        \
+  }
+
+// clang-format off
+
+arabica_sink_test(test_beep,
+  // 0x200: LD V[0], 0x02
+  // 0x202: LD ST, V[0]
+  // 0x204: JP 0x204
+  emulator.memory.write(0x200, 0x60);
+  emulator.memory.write(0x201, 0x02);
+  emulator.memory.write(0x202, 0xF0);
+  emulator.memory.write(0x203, 0x18);
+  emulator.memory.write(0x204, 0x12);
+  emulator.memory.write(0x205, 0x04);
+
+  emulator.run(2);
+  ASSERT_TRUE(recorder.is_beeping);
+  emulator.execute();
+  ASSERT_TRUE(recorder.is_beeping);
+  emulator.execute();
+  ASSERT_FALSE(recorder.is_beeping);
+)
+
+arabica_sink_test(test_muted_beep,
+  // 0x200: LD V[0], 0x02
+  // 0x202: LD ST, V[0]
+  emulator.memory.write(0x200, 0x60);
+  emulator.memory.write(0x201, 0x02);
+  emulator.memory.write(0x202, 0xF0);
+  emulator.memory.write(0x203, 0x18);
+
+  emulator.sound.set_mute(true);
+  emulator.run(2);
+  ASSERT_FALSE(recorder.is_beeping);
+  ASSERT_EQ(emulator.sound.frequency, 0x02);
+)
+
+arabica_sink_test(test_frame,
+  // 0x200: DRW V[0], V[0], 5
+  // 0x202: JP 0x202
+  emulator.memory.write(0x200, 0xD0);
+  emulator.memory.write(0x201, 0x05);
+  emulator.memory.write(0x202, 0x12);
+  emulator.memory.write(0x203, 0x02);
+
+  emulator.execute();
+  ASSERT_EQ(recorder.frames, 1);
+  ASSERT_FALSE(emulator.display.is_refresh);
+
+  // nothing is drawn any more
+  emulator.execute();
+  ASSERT_EQ(recorder.frames, 1);
+)
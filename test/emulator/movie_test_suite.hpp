@@ -0,0 +1,159 @@
+#pragma once
+
+#include <arabica/emulator/emulator.hpp>
+#include <arabica/emulator/movie.hpp>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace arabica_movie_test {
+
+// every instruction counts, so a key applied one instruction off gives different registers
+//
+// 0x200: ADD V[1], 0x01
+// 0x202: SKNP V[2]        key 0
+// 0x204: ADD V[3], V[1]
+// 0x206: RND V[4], 0xFF
+// 0x208: ADD V[5], V[4]
+// 0x20A: JP 0x200
+const std::vector<uint8_t> rom{0x71, 0x01, 0xE2, 0xA1, 0x83, 0x14, 0xC4, 0xFF, 0x85, 0x44, 0x12, 0x00};
+
+// key 0 down and up at odd points of a few frames, several in the same frame
+const std::vector<arabica::KeyEvent> session{
+  {0, 3, 0x0, 1},
+  {0, 4, 0x0, 0},
+  {2, 0, 0x0, 1},
+  {5, 7, 0x0, 0},
+  {5, 7, 0x0, 1},
+  {5, 8, 0x0, 0},
+  {9, 100, 0x0, 1},
+};
+
+inline arabica::Movie record(const uint64_t seed, const uint32_t frames) {
+  arabica::Emulator emulator;
+  emulator.load(rom);
+
+  arabica::Movie movie;
+  movie.seed     = seed;
+  movie.rom_hash = arabica::Movie::hash(emulator.memory);
+  movie.frames   = frames;
+  movie.events   = session;
+  return movie;
+}
+
+inline bool is_same(const arabica::MachineState& lhs, const arabica::MachineState& rhs) {
+  return std::memcmp(&lhs, &rhs, sizeof(arabica::MachineState)) == 0;
+}
+
+} // namespace arabica_movie_test
+
+#define arabica_movie_test(test_case_name, test_case_body) \
+  TEST(movie_test_suite, test_case_name) {                 \
+    using namespace arabica_movie_test;                    \
+    arabica::Emulator emulator;                            \
+    emulator.load(rom);                                    \
+    test_case_body                                         \
+  }
+
+// clang-format off
+
+arabica_movie_test(test_events_land_on_their_instruction,
+  const arabica::Movie movie = record(11, 12);
+  arabica::MoviePlayer player(movie);
+  ASSERT_TRUE(player.start(emulator));
+  while (player.execute(emulator)) {
+  }
+  ASSERT_TRUE(player.is_done());
+
+  // the same session one instruction at a time
+  arabica::Emulator reference;
+  reference.load(rom);
+  reference.random.seed(11);
+  const int   per_frame = reference.cpu.clock_speed / reference.fps;
+  std::size_t next      = 0;
+  for (uint32_t frame = 0; frame < movie.frames; ++frame) {
+    for (int instruction = 0; instruction <= per_frame; ++instruction) {
+      // past the end of the frame is the end of the frame
+      for (; next < session.size() && session[next].frame == frame &&
+             std::min<int>(session[next].instruction, per_frame) <= instruction;
+           ++next) {
+        reference.keypad.apply(session[next]);
+      }
+      if (instruction < per_frame) {
+        reference.single_step();
+      }
+    }
+    reference.cycle++;
+    reference.delay.tick();
+    reference.sound.tick();
+  }
+  ASSERT_TRUE(is_same(emulator.snapshot(), reference.snapshot()));
+)
+
+arabica_movie_test(test_replay_is_deterministic,
+  const arabica::Movie movie = record(3, 30);
+  arabica::MoviePlayer player(movie);
+  ASSERT_TRUE(player.start(emulator));
+  while (player.execute(emulator)) {
+  }
+
+  arabica::Emulator other;
+  other.load(rom);
+  arabica::MoviePlayer again(movie);
+  ASSERT_TRUE(again.start(other));
+  while (again.execute(other)) {
+  }
+  ASSERT_TRUE(is_same(emulator.snapshot(), other.snapshot()));
+  ASSERT_EQ(other.cycle, 30);
+)
+
+arabica_movie_test(test_movie_file,
+  const arabica::Movie movie = record(42, 20);
+  const std::string    path  = (std::filesystem::temp_directory_path() / "arabica_movie_test.movie").string();
+  ASSERT_TRUE(movie.save(path));
+
+  arabica::Movie loaded;
+  ASSERT_TRUE(loaded.load(path));
+  std::filesystem::remove(path);
+  ASSERT_EQ(loaded.seed, movie.seed);
+  ASSERT_EQ(loaded.rom_hash, movie.rom_hash);
+  ASSERT_EQ(loaded.frames, movie.frames);
+  ASSERT_EQ(loaded.events.size(), movie.events.size());
+  ASSERT_EQ(std::memcmp(loaded.events.data(), movie.events.data(), movie.events.size() * sizeof(arabica::KeyEvent)), 0);
+)
+
+arabica_movie_test(test_movie_file_with_a_corrupt_count,
+  const arabica::Movie movie = record(42, 20);
+  const std::string    path  = (std::filesystem::temp_directory_path() / "arabica_movie_test.movie").string();
+  ASSERT_TRUE(movie.save(path));
+
+  // a count of events, the last field of the 32-byte header, far beyond what the file holds
+  {
+    std::fstream   file(path, std::ios::binary | std::ios::in | std::ios::out);
+    const uint32_t count = 0xFFFFFFFF;
+    file.seekp(28);
+    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+  }
+  arabica::Movie loaded;
+  ASSERT_FALSE(loaded.load(path));
+  std::filesystem::remove(path);
+  ASSERT_TRUE(loaded.events.empty());
+)
+
+arabica_movie_test(test_movie_needs_its_rom,
+  const arabica::Movie movie = record(1, 10);
+  emulator.memory.write(arabica::Memory::RESERVED, 0x72);
+  arabica::MoviePlayer player(movie);
+  ASSERT_FALSE(player.start(emulator));
+)
+
+arabica_movie_test(test_truncate,
+  arabica::Movie movie = record(1, 10);
+  movie.truncate(5);
+  ASSERT_EQ(movie.frames, 5);
+  ASSERT_EQ(movie.events.size(), 3);
+)
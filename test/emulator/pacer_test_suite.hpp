@@ -0,0 +1,124 @@
+#pragma once
+
+#include <arabica/emulator/pacer.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace arabica_pacer_test {
+
+using Clock = arabica::Pacer::Clock;
+
+// an arbitrary but fixed start, the schedule only ever looks at the time it is given
+const Clock::time_point T0 = Clock::time_point{} + std::chrono::hours(1);
+
+inline std::chrono::nanoseconds since_t0(const Clock::time_point time) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time - T0);
+}
+
+struct Followed {
+  double rate{1.0};   // the rate the pacer settled on
+  double played{0.0}; // the frames the samples played stand for
+};
+
+// Runs `frames` frames on time against a sample clock running `ratio` times as fast as the host one,
+// e.g. a sound card at 48 kHz and a bit.
+inline Followed follow(const double ratio, const int frames) {
+  constexpr uint32_t    sample_rate = 48000;
+  std::atomic<uint64_t> samples{0};
+  arabica::Pacer        pacer;
+  pacer.follow(&samples, sample_rate);
+  pacer.start(T0);
+  Clock::time_point due = T0;
+  for (int i = 0; i < frames; ++i) {
+    samples = static_cast<uint64_t>(since_t0(due).count() * 1e-9 * sample_rate * ratio);
+    due     = pacer.next(due);
+  }
+  return Followed{pacer.rate(), static_cast<double>(samples) * 60 / sample_rate};
+}
+
+} // namespace arabica_pacer_test
+
+#define arabica_pacer_test(test_case_name, test_case_body) \
+  TEST(pacer_test_suite, test_case_name) {                 \
+    using namespace arabica_pacer_test;                    \
+    test_case_body                                         \
+  }
+
+// clang-format off
+
+arabica_pacer_test(test_60_frames_take_exactly_a_second,
+  // 1000 / 60 rounded to 16 ms was 62.5 Hz, rounding every period to the nanosecond would still drift
+  arabica::Pacer pacer(60);
+  pacer.start(T0);
+  Clock::time_point due = T0;
+  for (int i = 1; i <= 600; ++i) {
+    due = pacer.next(due);
+    ASSERT_EQ(since_t0(due).count(), i * 1'000'000'000LL / 60 + (i * 1'000'000'000LL % 60 >= 30 ? 1 : 0));
+  }
+  ASSERT_EQ(since_t0(due), std::chrono::seconds(10));
+  ASSERT_EQ(pacer.restarts(), 0);
+)
+
+arabica_pacer_test(test_a_late_frame_does_not_move_the_next_ones,
+  arabica::Pacer pacer(60);
+  pacer.start(T0);
+  const Clock::time_point first = pacer.next(T0 + std::chrono::milliseconds(30)); // woke up 13 ms late
+  ASSERT_EQ(since_t0(first).count(), 16'666'667);
+  const Clock::time_point second = pacer.next(T0 + std::chrono::milliseconds(30));
+  ASSERT_EQ(since_t0(second).count(), 33'333'333);
+)
+
+arabica_pacer_test(test_a_few_late_frames_are_caught_up,
+  // 3 frames late: they are all due already and run back to back
+  arabica::Pacer          pacer(60);
+  const Clock::time_point now = T0 + std::chrono::milliseconds(50);
+  pacer.start(T0);
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_LE(pacer.next(now), now);
+  }
+  ASSERT_GT(pacer.next(now), now);
+  ASSERT_EQ(pacer.restarts(), 0);
+)
+
+arabica_pacer_test(test_too_late_starts_over,
+  arabica::Pacer          pacer(60);
+  const Clock::time_point now = T0 + std::chrono::seconds(1);
+  pacer.start(T0);
+  ASSERT_EQ(pacer.next(now), now);
+  ASSERT_EQ(pacer.restarts(), 1);
+  ASSERT_EQ(since_t0(pacer.next(now)).count(), 1'016'666'667);
+)
+
+arabica_pacer_test(test_sleep_until_never_returns_early,
+  for (const auto wait : {std::chrono::microseconds(100), std::chrono::microseconds(2000)}) {
+    const Clock::time_point deadline = Clock::now() + wait;
+    arabica::Pacer::sleep_until(deadline);
+    ASSERT_GE(Clock::now(), deadline);
+  }
+)
+
+arabica_pacer_test(test_without_a_sample_clock_the_rate_is_1,
+  arabica::Pacer pacer;
+  pacer.start(T0);
+  pacer.next(T0);
+  ASSERT_EQ(pacer.rate(), 1.0);
+)
+
+arabica_pacer_test(test_frames_speed_up_for_a_fast_sample_clock,
+  ASSERT_GT(follow(1.002, 600).rate, 1.0);
+  ASSERT_LT(follow(0.998, 600).rate, 1.0);
+)
+
+arabica_pacer_test(test_the_rate_stays_within_bounds,
+  // a sample clock 5% off is a broken one, the frames never follow it all the way
+  ASSERT_DOUBLE_EQ(follow(1.05, 600).rate, 1.0 + arabica::Pacer::MAX_RATE_ADJUST);
+  ASSERT_DOUBLE_EQ(follow(0.95, 600).rate, 1.0 - arabica::Pacer::MAX_RATE_ADJUST);
+)
+
+arabica_pacer_test(test_frames_keep_up_with_the_sample_clock,
+  // after a minute 0.2% apart the frames run are within a few of the ones the samples stand for
+  ASSERT_NEAR(follow(1.002, 3600).played, 3600, 3);
+  ASSERT_NEAR(follow(0.998, 3600).played, 3600, 3);
+)
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <arabica/cpu/disassembler.hpp>
+#include <arabica/emulator/emulator.hpp>
+#include <arabica/emulator/profiler.hpp>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace arabica_profiler_test {
+
+// 0x200: LD V[0], 0x05
+// 0x202: LD F, V[0]
+// 0x204: DRW V[1], V[1], 5
+// 0x206: ADD V[1], 0x01
+// 0x208: JP 0x204
+const std::vector<uint8_t> rom{0x60, 0x05, 0xF0, 0x29, 0xD1, 0x15, 0x71, 0x01, 0x12, 0x04};
+
+inline void load(arabica::Emulator& emulator) {
+  emulator.display.init();
+  emulator.load(rom);
+}
+
+} // namespace arabica_profiler_test
+
+#define arabica_profiler_test(test_case_name, test_case_body) \
+  TEST(profiler_test_suite, test_case_name) {                 \
+    using namespace arabica_profiler_test;                    \
+    test_case_body                                            \
+  }
+
+// clang-format off
+
+arabica_profiler_test(test_disassemble,
+  ASSERT_EQ(arabica::disassemble(arabica::decode(0x00E0)), "CLS");
+  ASSERT_EQ(arabica::disassemble(arabica::decode(0x1204)), "JP 0x204");
+  ASSERT_EQ(arabica::disassemble(arabica::decode(0x7101)), "ADD V[1], 0x01");
+  ASSERT_EQ(arabica::disassemble(arabica::decode(0x8AB4)), "ADD V[10], V[11]");
+  ASSERT_EQ(arabica::disassemble(arabica::decode(0xD115)), "DRW V[1], V[1], 5");
+  ASSERT_EQ(arabica::disassemble(arabica::decode(0xF265)), "LD V[2], [I]");
+  ASSERT_EQ(arabica::disassemble(arabica::decode(0xF0FF)), "DW 0xF0FF");
+)
+
+arabica_profiler_test(test_report,
+  arabica::Profiler profiler;
+  profiler.record(0x204, arabica::decode(0xD115), 900);
+  profiler.record(0x204, arabica::decode(0xD115), 700);
+  profiler.record(0x206, arabica::decode(0x7101), 10);
+
+  ASSERT_EQ(profiler.op_code(arabica::OP_CODE::DRW_Vx_Vy_nibble).count, 2);
+  ASSERT_EQ(profiler.op_code(arabica::OP_CODE::DRW_Vx_Vy_nibble).nanoseconds, 1600);
+  ASSERT_EQ(profiler.address(0x206).count, 1);
+
+  // the op codes by time, DRW first, and the listing in address order
+  const std::string report = profiler.report();
+  ASSERT_LT(report.find("DRW_Vx_Vy_nibble"), report.find("ADD_Vx_byte"));
+  const std::size_t listing = report.find("listing");
+  ASSERT_NE(listing, std::string::npos);
+  const std::size_t drw = report.find("0x204  D115  DRW V[1], V[1], 5", listing);
+  ASSERT_NE(drw, std::string::npos);
+  ASSERT_LT(drw, report.find("0x206  7101  ADD V[1], 0x01", listing));
+
+  arabica::Profiler other;
+  other.record(0x206, arabica::decode(0x7101), 10);
+  profiler.merge(other);
+  ASSERT_EQ(profiler.address(0x206).count, 2);
+)
+
+#if defined(ARABICA_PROFILE)
+arabica_profiler_test(test_every_instruction_is_counted,
+  arabica::Emulator emulator;
+  load(emulator);
+  arabica::Profiler profiler;
+  emulator.set_profiler(&profiler);
+  emulator.run(2 + 3 * 100);
+
+  ASSERT_EQ(profiler.address(0x200).count, 1);
+  ASSERT_EQ(profiler.address(0x204).count, 100);
+  ASSERT_EQ(profiler.op_code(arabica::OP_CODE::JP_addr).count, 100);
+
+  // the profiled run ends up where the plain one does
+  arabica::Emulator plain;
+  load(plain);
+  plain.run(2 + 3 * 100);
+  const arabica::MachineState lhs = emulator.snapshot();
+  const arabica::MachineState rhs = plain.snapshot();
+  ASSERT_EQ(std::memcmp(&lhs, &rhs, sizeof(lhs)), 0);
+)
+#endif
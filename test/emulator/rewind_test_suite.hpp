@@ -0,0 +1,112 @@
+#pragma once
+
+#include <arabica/emulator/emulator.hpp>
+#include <arabica/emulator/rewind.hpp>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace arabica_rewind_test {
+
+// a digit bouncing across the screen, redrawn every 3 frames
+//
+// 0x200: LD V[0], 0x00
+// 0x202: LD V[1], 0x00
+// 0x204: LD V[2], 0x05
+// 0x206: LD F, V[2]
+// 0x208: DRW V[0], V[1], 5
+// 0x20A: LD V[3], 0x03
+// 0x20C: LD DT, V[3]
+// 0x20E: LD V[3], DT
+// 0x210: SE V[3], 0x00
+// 0x212: JP 0x20E
+// 0x214: DRW V[0], V[1], 5
+// 0x216: ADD V[0], 0x01
+// 0x218: ADD V[1], 0x01
+// 0x21A: JP 0x208
+const std::vector<uint8_t> rom{0x60, 0x00, 0x61, 0x00, 0x62, 0x05, 0xF2, 0x29, 0xD0, 0x15, 0x63, 0x03, 0xF3, 0x15,
+                               0xF3, 0x07, 0x33, 0x00, 0x12, 0x0E, 0xD0, 0x15, 0x70, 0x01, 0x71, 0x01, 0x12, 0x08};
+
+inline bool is_same(const arabica::MachineState& lhs, const arabica::MachineState& rhs) {
+  return std::memcmp(&lhs, &rhs, sizeof(arabica::MachineState)) == 0;
+}
+
+// runs `frames` frames, recording each of them, and returns the states as they were recorded
+inline std::vector<arabica::MachineState> record(arabica::Emulator& emulator,
+                                                 arabica::Rewind&   rewind,
+                                                 const int          frames) {
+  std::vector<arabica::MachineState> states(frames);
+  for (int i = 0; i < frames; ++i) {
+    emulator.execute();
+    emulator.snapshot(states[i]);
+    rewind.record(states[i]);
+  }
+  return states;
+}
+
+} // namespace arabica_rewind_test
+
+#define arabica_rewind_test(test_case_name, test_case_body) \
+  TEST(rewind_test_suite, test_case_name) {                 \
+    using namespace arabica_rewind_test;                    \
+    arabica::Emulator emulator;                             \
+    emulator.display.init();                                \
+    emulator.load(rom);                                     \
+    test_case_body                                          \
+  }
+
+// clang-format off
+
+arabica_rewind_test(test_step_back,
+  arabica::Rewind rewind;
+  const auto      states = record(emulator, rewind, 100);
+  ASSERT_EQ(rewind.size(), 99);
+
+  arabica::MachineState state;
+  for (int i = 98; i >= 0; --i) {
+    ASSERT_TRUE(rewind.step_back(state));
+    ASSERT_TRUE(is_same(state, states[i])) << "frame " << i;
+  }
+  ASSERT_FALSE(rewind.step_back(state));
+)
+
+arabica_rewind_test(test_seek_across_keyframes,
+  arabica::Rewind rewind;
+  const auto      states = record(emulator, rewind, 3 * arabica::Rewind::KEYFRAME_INTERVAL + 17);
+
+  arabica::MachineState state;
+  for (std::size_t frames = 0; frames <= rewind.size(); frames += 97) {
+    rewind.seek(frames, state);
+    ASSERT_TRUE(is_same(state, states[states.size() - 1 - frames])) << frames << " frames back";
+  }
+)
+
+arabica_rewind_test(test_oldest_frames_are_dropped,
+  arabica::Rewind rewind(64 * 1024);
+  const auto      states = record(emulator, rewind, 5000);
+  ASSERT_LT(rewind.size(), states.size() - 1);
+  ASSERT_LE(rewind.bytes(), 64 * 1024);
+
+  arabica::MachineState state;
+  rewind.seek(rewind.size(), state);
+  ASSERT_TRUE(is_same(state, states[states.size() - 1 - rewind.size()]));
+)
+
+arabica_rewind_test(test_resume_after_rewinding,
+  arabica::Rewind rewind;
+  const auto      states = record(emulator, rewind, 200);
+
+  // back 50 frames and run again from there, the same frames are recorded once more
+  arabica::MachineState state;
+  rewind.truncate(50);
+  rewind.seek(0, state);
+  ASSERT_TRUE(is_same(state, states[149]));
+  emulator.restore(state);
+  record(emulator, rewind, 50);
+
+  for (std::size_t frames = 0; frames < 200; frames += 13) {
+    rewind.seek(frames, state);
+    ASSERT_TRUE(is_same(state, states[199 - frames])) << frames << " frames back";
+  }
+)
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <arabica/emulator/emulator.hpp>
+#include <arabica/emulator/machine_state.hpp>
+#include <arabica/emulator/save_state.hpp>
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace arabica_state_test {
+
+// 0x200: LD V[0], 0x05
+// 0x202: LD F, V[0]
+// 0x204: CALL 0x20A
+// 0x206: ADD V[1], 0x03
+// 0x208: JP 0x200
+// 0x20A: DRW V[1], V[1], 5
+// 0x20C: RET
+const std::vector<uint8_t> rom{0x60, 0x05, 0xF0, 0x29, 0x22, 0x0A, 0x71, 0x03, 0x12, 0x00, 0xD1, 0x15, 0x00, 0xEE};
+
+inline bool is_same(const arabica::MachineState& lhs, const arabica::MachineState& rhs) {
+  return std::memcmp(&lhs, &rhs, sizeof(arabica::MachineState)) == 0;
+}
+
+// a save-state image of `state` as `save_state` writes it
+struct Image {
+  alignas(arabica::MachineState) char bytes[sizeof(arabica::SaveStateHeader) + sizeof(arabica::MachineState)];
+};
+
+inline Image image_of(const arabica::MachineState& state, const uint32_t version = arabica::SaveStateHeader::VERSION) {
+  arabica::SaveStateHeader header;
+  std::memcpy(header.magic, arabica::SaveStateHeader::MAGIC, sizeof(header.magic));
+  header.version = version;
+  header.size    = sizeof(arabica::MachineState);
+  header.offset  = sizeof(arabica::SaveStateHeader);
+  Image image;
+  std::memcpy(image.bytes, &header, sizeof(header));
+  std::memcpy(image.bytes + sizeof(header), &state, sizeof(state));
+  return image;
+}
+
+// the image of `state` with `byte` at `offset` into the state
+inline Image corrupt(const arabica::MachineState& state, const std::size_t offset, const uint8_t byte) {
+  Image image                                            = image_of(state);
+  image.bytes[sizeof(arabica::SaveStateHeader) + offset] = static_cast<char>(byte);
+  return image;
+}
+
+inline bool is_viewable(const Image& image) {
+  return arabica::view_state(image.bytes, sizeof(image.bytes)) != nullptr;
+}
+
+// the size of the stack is its last member, its low byte first on the hosts the tests run on
+constexpr std::size_t STACK_SIZE = offsetof(arabica::MachineState, stack) + sizeof(arabica::Stack) - sizeof(uint16_t);
+
+} // namespace arabica_state_test
+
+#define arabica_state_test(test_case_name, test_case_body) \
+  TEST(state_test_suite, test_case_name) {                 \
+    using namespace arabica_state_test;                    \
+    arabica::Emulator emulator;                            \
+    emulator.display.init();                               \
+    emulator.load(rom);                                    \
+    test_case_body                                         \
+  }
+
+// clang-format off
+
+arabica_state_test(test_restore_rewinds_the_machine,
+  emulator.keypad.on_keydown(0x3);
+  for (int i = 0; i < 50; ++i) {
+    emulator.single_step();
+  }
+  const arabica::MachineState saved = emulator.snapshot();
+  const uint64_t              hash  = emulator.display.hash();
+
+  for (int i = 0; i < 37; ++i) {
+    emulator.single_step();
+  }
+  emulator.keypad.on_keyup(0x3);
+  ASSERT_FALSE(is_same(emulator.snapshot(), saved));
+
+  emulator.restore(saved);
+  ASSERT_TRUE(is_same(emulator.snapshot(), saved));
+  ASSERT_EQ(emulator.display.hash(), hash);
+  ASSERT_TRUE(emulator.keypad.is_keypressed(0x3));
+  ASSERT_EQ(emulator.keypad.get_last_keypressed_code(), 0x3);
+)
+
+arabica_state_test(test_restore_drops_stale_instructions,
+  const arabica::MachineState saved = emulator.snapshot();
+  emulator.single_step();
+  ASSERT_EQ(emulator.cpu.registers[0], 0x05);
+
+  // LD V[0], 0x07 over the first instruction, decoded once, then the original is restored
+  emulator.restore(saved);
+  emulator.memory.write(0x201, 0x07);
+  emulator.single_step();
+  ASSERT_EQ(emulator.cpu.registers[0], 0x07);
+
+  emulator.restore(saved);
+  emulator.single_step();
+  ASSERT_EQ(emulator.cpu.registers[0], 0x05);
+)
+
+arabica_state_test(test_restored_machine_runs_the_same,
+  for (int i = 0; i < 20; ++i) {
+    emulator.single_step();
+  }
+  const arabica::MachineState saved = emulator.snapshot();
+  for (int i = 0; i < 100; ++i) {
+    emulator.single_step();
+  }
+  const arabica::MachineState expected = emulator.snapshot();
+
+  emulator.restore(saved);
+  for (int i = 0; i < 100; ++i) {
+    emulator.single_step();
+  }
+  ASSERT_TRUE(is_same(emulator.snapshot(), expected));
+)
+
+arabica_state_test(test_save_state_file,
+  for (int i = 0; i < 30; ++i) {
+    emulator.single_step();
+  }
+  const arabica::MachineState saved = emulator.snapshot();
+  const std::string           path  = (std::filesystem::temp_directory_path() / "arabica_state_test.state").string();
+  ASSERT_TRUE(arabica::save_state(path, saved));
+
+  arabica::MachineState loaded;
+  ASSERT_TRUE(arabica::load_state(path, loaded));
+  ASSERT_TRUE(is_same(loaded, saved));
+  std::filesystem::remove(path);
+)
+
+arabica_state_test(test_view_state,
+  const arabica::MachineState saved = emulator.snapshot();
+  const Image                 image = image_of(saved);
+
+  const arabica::MachineState* const view = arabica::view_state(image.bytes, sizeof(image.bytes));
+  ASSERT_NE(view, nullptr);
+  ASSERT_TRUE(is_same(*view, saved));
+  ASSERT_EQ(arabica::view_state(image.bytes, sizeof(image.bytes) - 1), nullptr);
+
+  const Image newer = image_of(saved, arabica::SaveStateHeader::VERSION + 1);
+  ASSERT_EQ(arabica::view_state(newer.bytes, sizeof(newer.bytes)), nullptr);
+)
+
+arabica_state_test(test_invalid_states_are_refused,
+  const arabica::MachineState saved = emulator.snapshot();
+  const std::size_t           keys  = offsetof(arabica::MachineState, keys);
+  const std::size_t           last  = offsetof(arabica::MachineState, last_key);
+  const std::size_t           hires = offsetof(arabica::MachineState, hires);
+  ASSERT_TRUE(is_viewable(corrupt(saved, last, 0xFF)));
+  ASSERT_TRUE(is_viewable(corrupt(saved, STACK_SIZE, arabica::Stack::DEPTH)));
+
+  ASSERT_FALSE(is_viewable(corrupt(saved, STACK_SIZE, arabica::Stack::DEPTH + 1)));
+  ASSERT_FALSE(is_viewable(corrupt(saved, keys + 3, 2)));
+  ASSERT_FALSE(is_viewable(corrupt(saved, hires, 2)));
+  ASSERT_FALSE(is_viewable(corrupt(saved, last, 16)));
+
+  // a file is checked the same way
+  const Image       image = corrupt(saved, STACK_SIZE, 0xFF);
+  const std::string path  = (std::filesystem::temp_directory_path() / "arabica_state_test_corrupt.state").string();
+  std::ofstream(path, std::ios::binary).write(image.bytes, sizeof(image.bytes));
+  arabica::MachineState loaded;
+  ASSERT_FALSE(arabica::load_state(path, loaded));
+  std::filesystem::remove(path);
+)
+
+arabica_state_test(test_restore_switches_the_resolution,
+  for (int i = 0; i < 20; ++i) {
+    emulator.single_step();
+  }
+  const arabica::MachineState low  = emulator.snapshot();
+  const uint64_t              hash = emulator.display.hash();
+
+  emulator.display.set_hires(true);
+  emulator.display.update_large(100, 50, emulator.memory.data());
+  emulator.cpu.rpl[2] = 0x42;
+  const arabica::MachineState high = emulator.snapshot();
+  ASSERT_TRUE(high.hires);
+
+  emulator.restore(low);
+  ASSERT_FALSE(emulator.display.is_hires);
+  ASSERT_EQ(emulator.display.hash(), hash);
+  ASSERT_EQ(emulator.cpu.rpl[2], 0);
+  emulator.restore(high);
+  ASSERT_TRUE(emulator.display.is_hires);
+  ASSERT_TRUE(emulator.display.is_on(100, 50));
+  ASSERT_TRUE(is_same(emulator.snapshot(), high));
+)
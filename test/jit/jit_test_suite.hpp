@@ -0,0 +1,81 @@
+#pragma once
+
+#if defined(ARABICA_JIT)
+
+#include <arabica/emulator/emulator.hpp>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+
+#define arabica_jit_test(test_case_name, test_case_body) \
+  TEST(jit_test_suite, test_case_name) {                 \
+    arabica::Emulator emulator;                          \
+    arabica::Emulator reference;                         \
+    test_case_body                                       \
+  }
+
+inline uint16_t arabica_jit_random_instruction(std::mt19937& generator) {
+  const uint16_t templates[] = {
+    0x6000, 0x7000, 0x8000, 0x8001, 0x8002, 0x8003, 0x8004, 0x8005, 0x8006, 0x8007, 0x800E, 0xA000, 0xF01E, 0xF029, 0x3000};
+
+  const uint16_t op_code = templates[generator() % std::size(templates)];
+  const uint16_t x       = (generator() & 0xF) << 8;
+  const uint16_t y       = (generator() & 0xF) << 4;
+  switch (op_code & 0xF000) {
+    case 0x8000: return op_code | x | y;
+    case 0xA000: return op_code | (generator() & 0x0FFF);
+    case 0xF000: return op_code | x;
+    default: return op_code | x | (generator() & 0xFF);
+  }
+}
+
+// clang-format off
+
+// Random register-only programs, sprinkled with skips, which end with a jump back to the start.
+// The blocks run natively on `emulator` and every instruction is interpreted on `reference`.
+arabica_jit_test(test_random_blocks_match_interpreter,
+  std::mt19937 generator(0xC0FFEE);
+
+  for (int round = 0; round < 16; ++round) {
+    uint16_t address = 0x200;
+    for (int i = 0; i < 120; ++i, address += 2) {
+      const uint16_t instruction = arabica_jit_random_instruction(generator);
+      emulator.memory.write(address, instruction >> 8);
+      emulator.memory.write(address + 1, instruction & 0xFF);
+    }
+    emulator.memory.write(address, 0x12);
+    emulator.memory.write(address + 1, 0x00);
+    reference.memory = emulator.memory;
+
+    emulator.run(1000);
+    for (int i = 0; i < 1000; ++i) {
+      reference.single_step();
+    }
+
+    ASSERT_EQ(emulator.cpu.pc, reference.cpu.pc);
+    ASSERT_EQ(emulator.cpu.reg_I, reference.cpu.reg_I);
+    for (int i = 0; i < arabica::CPU::REGISTER_COUNT; ++i) {
+      ASSERT_EQ(emulator.cpu.registers[i], reference.cpu.registers[i]);
+    }
+  }
+)
+
+arabica_jit_test(test_rewrite_compiled_block,
+  // LD V[0], 0x01; ADD V[0], 0x01; JP 0x200
+  emulator.memory.write(0x200, 0x60);
+  emulator.memory.write(0x201, 0x01);
+  emulator.memory.write(0x202, 0x70);
+  emulator.memory.write(0x203, 0x01);
+  emulator.memory.write(0x204, 0x12);
+  emulator.memory.write(0x205, 0x00);
+  emulator.run(3);
+  ASSERT_EQ(emulator.cpu.registers[0], 0x02);
+
+  // ADD V[0], 0x05 in place of ADD V[0], 0x01
+  emulator.memory.write(0x203, 0x05);
+  emulator.run(3);
+  ASSERT_EQ(emulator.cpu.pc, 0x200);
+  ASSERT_EQ(emulator.cpu.registers[0], 0x06);
+)
+
+#endif
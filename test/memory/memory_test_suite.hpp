@@ -2,6 +2,9 @@
 
 #include <arabica/emulator/emulator.hpp>
 #include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
 
 #define arabica_memory_test(test_case, address, value) \
   TEST(memory_test_suite, test_case) {                 \
@@ -13,4 +16,20 @@
 arabica_memory_test(pc_write_001, emulator.cpu.pc, 0x61);
 arabica_memory_test(pc_write_002, emulator.cpu.pc, 0x00);
 
-arabica_memory_test(memory_write_001, 0x300, 0x11);
\ No newline at end of file
+arabica_memory_test(memory_write_001, 0x300, 0x11);
+TEST(memory_test_suite, load_bytes) {
+  arabica::Memory memory;
+  ASSERT_TRUE(memory.load(std::vector<uint8_t>{0x12, 0x34}));
+  ASSERT_EQ(memory.read(arabica::Memory::RESERVED), 0x12);
+  ASSERT_EQ(memory.read(arabica::Memory::RESERVED + 1), 0x34);
+  ASSERT_FALSE(memory.load(std::vector<uint8_t>(arabica::Memory::SIZE - arabica::Memory::RESERVED + 1)));
+}
+
+TEST(memory_test_suite, load_oversized_file) {
+  const std::string path = (std::filesystem::temp_directory_path() / "arabica_memory_test.ch8").string();
+  std::ofstream(path, std::ios::binary) << std::string(arabica::Memory::SIZE - arabica::Memory::RESERVED + 1, '\x12');
+  arabica::Memory memory;
+  ASSERT_FALSE(memory.load(path));
+  std::filesystem::remove(path);
+  ASSERT_EQ(memory.read(arabica::Memory::RESERVED), 0x00);
+}
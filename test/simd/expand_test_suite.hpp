@@ -0,0 +1,167 @@
+#pragma once
+
+#include <arabica/simd/expand.hpp>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+namespace arabica_expand_test {
+
+constexpr uint32_t ON  = 0xFF0000FF;
+constexpr uint32_t OFF = 0xFF101010;
+
+inline std::vector<uint64_t> random_rows(uint64_t seed, const std::size_t count) {
+  std::vector<uint64_t> rows(count);
+  for (uint64_t& row : rows) {
+    seed = seed * 6364136223846793005 + 1442695040888963407;
+    row  = seed ^ seed >> 29;
+  }
+  return rows;
+}
+
+// lengths of expanded lines, not all of them a multiple of 64
+constexpr std::size_t counts[] = {8, 64, 200, 512};
+
+// a staircase going down to the right
+const std::vector<uint64_t> staircase{uint64_t{1} << 63, uint64_t{1} << 62, uint64_t{1} << 61};
+
+inline arabica::simd::Bitmap bitmap_of(const std::vector<uint64_t>& rows, const int words) {
+  return arabica::simd::Bitmap{rows.data(), words, static_cast<int>(rows.size()) / words};
+}
+
+inline bool is_on(const arabica::simd::Bitmap& bitmap, const int x, const int y) {
+  return (bitmap.rows[y * bitmap.words + x / 64] >> (63 - x % 64)) & 1;
+}
+
+// Scale2x one pixel at a time, the edges clamped
+inline bool scale2x(const arabica::simd::Bitmap& bitmap, const int x, const int y) {
+  const int  width = 64 * bitmap.words;
+  const auto pixel = [&](const int px, const int py) {
+    return is_on(bitmap,
+                 px < 0 ? 0 : (px >= width ? width - 1 : px),
+                 py < 0 ? 0 : (py >= bitmap.height ? bitmap.height - 1 : py));
+  };
+  const int  sx = x / 2;
+  const int  sy = y / 2;
+  const bool p  = pixel(sx, sy);
+  const bool a  = pixel(sx, sy - 1);
+  const bool b  = pixel(sx + 1, sy);
+  const bool c  = pixel(sx - 1, sy);
+  const bool d  = pixel(sx, sy + 1);
+  switch ((y % 2) * 2 + x % 2) {
+    case 0: return c == a && c != d && a != b ? a : p;
+    case 1: return a == b && a != c && b != d ? b : p;
+    case 2: return d == c && d != b && c != a ? c : p;
+    default: return b == d && b != a && d != c ? d : p;
+  }
+}
+
+} // namespace arabica_expand_test
+
+#define arabica_expand_test(test_case_name, test_case_body) \
+  TEST(expand_test_suite, test_case_name) {                 \
+    using namespace arabica_expand_test;                    \
+    test_case_body                                          \
+  }
+
+// clang-format off
+
+arabica_expand_test(test_every_expander_matches_the_generic_one,
+  const std::vector<uint64_t>    bits    = random_rows(1, 8);
+  const arabica::simd::Expander& generic = *arabica::simd::supported_expanders().back();
+  for (const std::size_t count : counts) {
+    std::vector<uint32_t> expected(count);
+    generic.line(bits.data(), count, ON, OFF, expected.data());
+    for (const arabica::simd::Expander* const expander : arabica::simd::supported_expanders()) {
+      std::vector<uint32_t> pixels(count);
+      expander->line(bits.data(), count, ON, OFF, pixels.data());
+      ASSERT_EQ(pixels, expected) << expander->name << " " << count;
+    }
+  }
+)
+
+arabica_expand_test(test_expand_scales_every_pixel,
+  constexpr int               scale  = 3;
+  constexpr int               width  = 64 * 2 * scale;
+  constexpr int               stride = width + 5;
+  const std::vector<uint64_t> rows   = random_rows(2, 2 * 8);
+  const arabica::simd::Bitmap bitmap = bitmap_of(rows, 2);
+  for (const arabica::simd::Expander* const expander : arabica::simd::supported_expanders()) {
+    // the padding at the end of each line belongs to whoever owns the pixels
+    std::vector<uint32_t> pixels(stride * 8 * scale, 0xDEADBEEF);
+    arabica::simd::expand(bitmap,
+                          scale,
+                          arabica::simd::FILTER::NONE,
+                          ON,
+                          OFF,
+                          pixels.data(),
+                          stride * sizeof(uint32_t),
+                          *expander);
+    for (int y = 0; y < 8 * scale; ++y) {
+      for (int x = 0; x < stride; ++x) {
+        const uint32_t expected = x >= width ? 0xDEADBEEF : (is_on(bitmap, x / scale, y / scale) ? ON : OFF);
+        ASSERT_EQ(pixels[y * stride + x], expected) << expander->name << " " << x << "," << y;
+      }
+    }
+  }
+)
+
+arabica_expand_test(test_epx_matches_scale2x,
+  for (uint64_t seed = 1; seed <= 10; ++seed) {
+    // sparse enough to have diagonals and not only noise
+    std::vector<uint64_t>       rows = random_rows(seed, 2 * 16);
+    const std::vector<uint64_t> mask = random_rows(seed + 100, rows.size());
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+      rows[i] &= mask[i];
+    }
+    const arabica::simd::Bitmap bitmap = bitmap_of(rows, 2);
+
+    std::vector<uint64_t> smoothed;
+    arabica::simd::epx(bitmap, smoothed);
+    const arabica::simd::Bitmap result = bitmap_of(smoothed, 4);
+    for (int y = 0; y < 32; ++y) {
+      for (int x = 0; x < 256; ++x) {
+        ASSERT_EQ(is_on(result, x, y), scale2x(bitmap, x, y)) << seed << ": " << x << "," << y;
+      }
+    }
+  }
+)
+
+arabica_expand_test(test_epx_smooths_a_diagonal,
+  // Scale2x fills in the inner corners of the steps
+  std::vector<uint64_t> smoothed;
+  arabica::simd::epx(bitmap_of(staircase, 1), smoothed);
+  ASSERT_EQ(smoothed.size(), 2 * 6);
+  ASSERT_EQ(smoothed[2 * 0], uint64_t{0xC} << 60);
+  ASSERT_EQ(smoothed[2 * 1], uint64_t{0xA} << 60);
+  ASSERT_EQ(smoothed[2 * 2], uint64_t{0x7} << 60);
+  ASSERT_EQ(smoothed[2 * 3], uint64_t{0x38} << 56);
+)
+
+arabica_expand_test(test_epx_at_an_odd_scale_is_plain,
+  const std::vector<uint64_t> rows = random_rows(3, 32);
+  const arabica::simd::Bitmap bitmap = bitmap_of(rows, 1);
+  std::vector<uint32_t>       plain(64 * 3 * 32 * 3);
+  std::vector<uint32_t>       smooth(plain.size());
+  arabica::simd::expand(bitmap, 3, arabica::simd::FILTER::NONE, ON, OFF, plain.data(), 64 * 3 * sizeof(uint32_t));
+  arabica::simd::expand(bitmap, 3, arabica::simd::FILTER::EPX, ON, OFF, smooth.data(), 64 * 3 * sizeof(uint32_t));
+  ASSERT_EQ(smooth, plain);
+)
+
+arabica_expand_test(test_epx_at_scale_4_is_scale2x_doubled,
+  const std::vector<uint64_t> rows = random_rows(4, 32);
+  const arabica::simd::Bitmap bitmap = bitmap_of(rows, 1);
+  std::vector<uint64_t>       smoothed;
+  arabica::simd::epx(bitmap, smoothed);
+  std::vector<uint32_t>       expected(64 * 4 * 32 * 4);
+  std::vector<uint32_t>       pixels(expected.size());
+  arabica::simd::expand(bitmap_of(smoothed, 2),
+                        2,
+                        arabica::simd::FILTER::NONE,
+                        ON,
+                        OFF,
+                        expected.data(),
+                        64 * 4 * sizeof(uint32_t));
+  arabica::simd::expand(bitmap, 4, arabica::simd::FILTER::EPX, ON, OFF, pixels.data(), 64 * 4 * sizeof(uint32_t));
+  ASSERT_EQ(pixels, expected);
+)
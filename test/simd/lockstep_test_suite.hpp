@@ -0,0 +1,238 @@
+#pragma once
+
+#include <arabica/emulator/emulator.hpp>
+#include <arabica/simd/lockstep.hpp>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace arabica_lockstep_test {
+
+// not a multiple of `Lanes::LANE_ALIGN`, so the padding lanes are exercised as well
+constexpr std::size_t LANES = 70;
+
+// a random program without RND, whose values differ, and CALL, whose stack depth is unbounded in
+// the emulator; the keys pressed on each lane are what makes the lanes diverge
+inline std::vector<uint8_t> random_rom(uint32_t seed) {
+  constexpr uint16_t templates[] = {
+    0x00E0, 0x00EE, 0x1000, 0x3000, 0x4000, 0x5000, 0x6000, 0x7000, 0x8000, 0x8001, 0x8002, 0x8003,
+    0x8004, 0x8005, 0x8006, 0x8007, 0x800E, 0x9000, 0xA000, 0xB000, 0xD000, 0xE09E, 0xE0A1, 0xF007,
+    0xF00A, 0xF015, 0xF018, 0xF029, 0xF033, 0xF055, 0xF065, 0x6000, 0x7000, 0x8004, 0xE09E, 0xD000,
+  };
+  constexpr uint16_t length = 64;
+
+  const auto next = [&seed] {
+    seed = seed * 1103515245 + 12345;
+    return static_cast<uint16_t>(seed >> 16);
+  };
+  std::vector<uint8_t> rom;
+  for (uint16_t i = 0; i < length; ++i) {
+    const uint16_t base   = templates[next() % (sizeof(templates) / sizeof(templates[0]))];
+    const uint16_t target = arabica::CPU::PC_START + 2 * (next() % length);
+    uint16_t       word   = base;
+    switch (base & 0xF000) {
+      case 0x1000:
+      case 0xB000: word |= target; break;
+      case 0xA000: word |= 0x300 + (next() & 0xFF); break;
+      case 0x3000:
+      case 0x4000:
+      case 0x6000:
+      case 0x7000:
+      case 0xD000: word |= next() & 0x0FFF; break;
+      case 0x5000:
+      case 0x8000:
+      case 0x9000: word |= next() & 0x0FF0; break;
+      case 0xE000:
+      case 0xF000: word |= next() & 0x0F00; break;
+      default: break;
+    }
+    rom.push_back(word >> 8);
+    rom.push_back(word & 0xFF);
+  }
+  return rom;
+}
+
+inline void press_keys(const std::size_t lane, arabica::simd::Lockstep& lockstep, arabica::Emulator& emulator) {
+  if (lane % 3 != 0) {
+    lockstep.set_key(lane, (lane * 7) % 16, true);
+    emulator.keypad.on_keydown((lane * 7) % 16);
+  }
+  if (lane % 5 == 0) {
+    lockstep.set_key(lane, 0x2, true);
+    emulator.keypad.on_keydown(0x2);
+  }
+}
+
+inline std::unique_ptr<arabica::Emulator> make_emulator(const std::vector<uint8_t>& rom) {
+  auto emulator = std::make_unique<arabica::Emulator>();
+  emulator->display.init();
+  emulator->load(rom);
+  return emulator;
+}
+
+inline void expect_same_state(const arabica::simd::Lockstep& lockstep,
+                              const std::size_t              lane,
+                              const arabica::Emulator&       emulator) {
+  const arabica::simd::Lanes& lanes = lockstep.lanes();
+  EXPECT_EQ(lanes.pc[lane], emulator.cpu.pc) << "lane " << lane;
+  EXPECT_EQ(lanes.reg_I[lane], emulator.cpu.reg_I) << "lane " << lane;
+  EXPECT_EQ(lanes.reg_delay[lane], emulator.delay.get()) << "lane " << lane;
+  for (int i = 0; i < arabica::CPU::REGISTER_COUNT; ++i) {
+    EXPECT_EQ(lanes.registers[i][lane], emulator.cpu.registers[i]) << "lane " << lane << " V" << i;
+  }
+  EXPECT_EQ(lockstep.hash(lane), emulator.display.hash()) << "lane " << lane;
+}
+
+// 0x200: CALL 0x206
+// 0x202: CALL 0x206
+// 0x204: JP 0x204
+// 0x206: ADD V[0], 0x01
+// 0x208: RET
+const std::vector<uint8_t> call_rom{0x22, 0x06, 0x22, 0x06, 0x12, 0x04, 0x70, 0x01, 0x00, 0xEE};
+
+// 0x200: LD V[0], K
+// 0x202: LD I, 0x20B
+// 0x204: LD [I], V[0]    patches the byte of the next LD
+// 0x206: LD V[3], 0x00
+// 0x208: LD V[4], 0x00
+// 0x20A: LD V[5], 0x00   the byte written by each lane is its own key
+// 0x20C: JP 0x20C
+const std::vector<uint8_t> patch_rom{0xF0, 0x0A, 0xA2, 0x0B, 0xF0, 0x55, 0x63, 0x00, 0x64, 0x00, 0x65, 0x00, 0x12, 0x0C};
+
+// 0x200: LD V[0], K
+// 0x202: LD V[1], 0x01
+const std::vector<uint8_t> key_wait_rom{0xF0, 0x0A, 0x61, 0x01};
+
+// 0x200: RND V[0], 0xFF
+// 0x202: RND V[1], 0x0F
+// 0x204: ADD V[2], V[0]
+// 0x206: SE V[1], 0x03   the lanes branch on their random numbers
+// 0x208: JP 0x200
+// 0x20A: JP 0x20A
+const std::vector<uint8_t> random_branch_rom{0xC0, 0xFF, 0xC1, 0x0F, 0x82, 0x04, 0x31, 0x03, 0x12, 0x00, 0x12, 0x0A};
+
+// 0x200: LD V[0], 0x05
+// 0x202: LD HF, V[0]
+// 0x204: DRW V[0], V[0], 0   16x16
+// 0x206: SCD 3
+// 0x208: SCR
+// 0x20A: DRW V[0], V[0], 5
+// 0x20C: SCL
+// 0x20E: ADD V[0], 0x07
+// 0x210: JP 0x202
+const std::vector<uint8_t> super_chip_rom{
+  0x60, 0x05, 0xF0, 0x30, 0xD0, 0x00, 0x00, 0xC3, 0x00, 0xFB, 0xD0, 0x05, 0x00, 0xFC, 0x70, 0x07, 0x12, 0x02};
+
+} // namespace arabica_lockstep_test
+
+#define arabica_lockstep_test(test_case_name, test_case_body) \
+  TEST(lockstep_test_suite, test_case_name) {                 \
+    using namespace arabica_lockstep_test;                    \
+    test_case_body                                            \
+  }
+
+// clang-format off
+
+arabica_lockstep_test(test_every_lane_matches_the_emulator,
+  for (const arabica::simd::Kernel* const kernel : arabica::simd::supported_kernels()) {
+    for (uint32_t seed = 1; seed <= 20; ++seed) {
+      const std::vector<uint8_t> rom = random_rom(seed);
+
+      arabica::simd::Lockstep lockstep(LANES, *kernel);
+      ASSERT_TRUE(lockstep.load(rom));
+      std::vector<std::unique_ptr<arabica::Emulator>> emulators;
+      for (std::size_t lane = 0; lane < LANES; ++lane) {
+        emulators.push_back(make_emulator(rom));
+        press_keys(lane, lockstep, *emulators.back());
+      }
+
+      for (int frame = 0; frame < 20; ++frame) {
+        lockstep.execute();
+        for (auto& emulator : emulators) {
+          emulator->execute();
+        }
+      }
+      for (std::size_t lane = 0; lane < LANES; ++lane) {
+        SCOPED_TRACE(kernel->name);
+        expect_same_state(lockstep, lane, *emulators[lane]);
+      }
+    }
+  }
+)
+
+arabica_lockstep_test(test_call_and_return,
+  arabica::simd::Lockstep lockstep(LANES);
+  ASSERT_TRUE(lockstep.load(call_rom));
+  lockstep.run(100);
+  for (std::size_t lane = 0; lane < LANES; ++lane) {
+    ASSERT_EQ(lockstep.lanes().pc[lane], 0x204);
+    ASSERT_EQ(lockstep.lanes().registers[0][lane], 0x02);
+    ASSERT_EQ(lockstep.lanes().sp[lane], 0);
+  }
+)
+
+arabica_lockstep_test(test_lanes_diverge_on_self_modifying_code,
+  for (const arabica::simd::Kernel* const kernel : arabica::simd::supported_kernels()) {
+    arabica::simd::Lockstep lockstep(LANES, *kernel);
+    ASSERT_TRUE(lockstep.load(patch_rom));
+    for (std::size_t lane = 0; lane < LANES; ++lane) {
+      lockstep.set_key(lane, lane % 16, true);
+    }
+    lockstep.run(10);
+    for (std::size_t lane = 0; lane < LANES; ++lane) {
+      ASSERT_EQ(lockstep.lanes().pc[lane], 0x20C);
+      ASSERT_EQ(lockstep.lanes().registers[5][lane], lane % 16);
+    }
+  }
+)
+
+arabica_lockstep_test(test_lanes_wait_for_a_key,
+  arabica::simd::Lockstep lockstep(LANES);
+  ASSERT_TRUE(lockstep.load(key_wait_rom));
+  lockstep.set_key(3, 0xA, true);
+  lockstep.run(2);
+  for (std::size_t lane = 0; lane < LANES; ++lane) {
+    ASSERT_EQ(lockstep.lanes().pc[lane], lane == 3 ? 0x204 : 0x200);
+    ASSERT_EQ(lockstep.lanes().registers[0][lane], lane == 3 ? 0xA : 0x0);
+  }
+)
+
+arabica_lockstep_test(test_seeded_lanes_match_the_emulator,
+  arabica::simd::Lockstep lockstep(LANES);
+  ASSERT_TRUE(lockstep.load(random_branch_rom));
+  std::vector<std::unique_ptr<arabica::Emulator>> emulators;
+  for (std::size_t lane = 0; lane < LANES; ++lane) {
+    emulators.push_back(make_emulator(random_branch_rom));
+    if (lane % 2 == 0) {
+      lockstep.seed(lane, lane * 1000);
+      emulators.back()->random.seed(lane * 1000);
+    } else {
+      emulators.back()->random.seed(arabica::Random::DEFAULT_SEED + lane);
+    }
+  }
+
+  for (int frame = 0; frame < 5; ++frame) {
+    lockstep.execute();
+    for (auto& emulator : emulators) {
+      emulator->execute();
+    }
+  }
+  for (std::size_t lane = 0; lane < LANES; ++lane) {
+    expect_same_state(lockstep, lane, *emulators[lane]);
+  }
+)
+
+arabica_lockstep_test(test_super_chip_low_resolution,
+  // scrolling and 16x16 sprites run on the lanes like on the emulator
+  arabica::simd::Lockstep lockstep(LANES);
+  ASSERT_TRUE(lockstep.load(super_chip_rom));
+  const std::unique_ptr<arabica::Emulator> emulator = make_emulator(super_chip_rom);
+  for (int frame = 0; frame < 10; ++frame) {
+    lockstep.execute();
+    emulator->execute();
+  }
+  for (std::size_t lane = 0; lane < LANES; ++lane) {
+    expect_same_state(lockstep, lane, *emulator);
+  }
+)
@@ -1,6 +1,26 @@
 #include <test/cpu/cpu_test_suite.hpp>
 #include <test/memory/memory_test_suite.hpp>
 #include <test/driver/keypad_test_suite.hpp>
+#include <test/driver/sink_test_suite.hpp>
+#include <test/driver/random_test_suite.hpp>
+#include <test/driver/display_test_suite.hpp>
+#include <test/cpu/decode_cache_test_suite.hpp>
+#include <test/cpu/dispatch_test_suite.hpp>
+#include <test/cpu/fusion_test_suite.hpp>
+#include <test/cpu/idle_test_suite.hpp>
+#include <test/jit/jit_test_suite.hpp>
+#include <test/aot/aot_test_suite.hpp>
+#include <test/thread/pool_test_suite.hpp>
+#include <test/thread/triple_buffer_test_suite.hpp>
+#include <test/thread/spsc_queue_test_suite.hpp>
+#include <test/simd/lockstep_test_suite.hpp>
+#include <test/simd/expand_test_suite.hpp>
+#include <test/emulator/state_test_suite.hpp>
+#include <test/emulator/rewind_test_suite.hpp>
+#include <test/emulator/movie_test_suite.hpp>
+#include <test/emulator/profiler_test_suite.hpp>
+#include <test/emulator/pacer_test_suite.hpp>
+#include <test/trace/trace_test_suite.hpp>
 
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <arabica/thread/pool.hpp>
+#include <gtest/gtest.h>
+#include <atomic>
+
+#define arabica_pool_test(test_case_name, test_case_body) \
+  TEST(pool_test_suite, test_case_name) {                 \
+    arabica::ThreadPool pool(4);                          \
+    test_case_body                                        \
+  }
+
+// clang-format off
+
+arabica_pool_test(test_run_every_task,
+  std::atomic<int> sum{0};
+  for (int i = 1; i <= 1000; ++i) {
+    pool.submit([&sum, i] { sum += i; });
+  }
+  pool.wait();
+  ASSERT_EQ(sum, 500500);
+)
+
+arabica_pool_test(test_submit_from_task,
+  // every task spawns two more until the depth runs out, 2^10 - 1 tasks in total
+  std::atomic<int>          count{0};
+  std::function<void(int)> spawn = [&](const int depth) {
+    ++count;
+    if (depth > 1) {
+      pool.submit([&spawn, depth] { spawn(depth - 1); });
+      pool.submit([&spawn, depth] { spawn(depth - 1); });
+    }
+  };
+  pool.submit([&spawn] { spawn(10); });
+  pool.wait();
+  ASSERT_EQ(count, 1023);
+)
+
+arabica_pool_test(test_wait_twice,
+  std::atomic<int> count{0};
+  pool.submit([&count] { ++count; });
+  pool.wait();
+  pool.submit([&count] { ++count; });
+  pool.wait();
+  ASSERT_EQ(count, 2);
+  ASSERT_EQ(pool.size(), 4);
+)
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <arabica/thread/spsc_queue.hpp>
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <thread>
+
+namespace arabica_spsc_queue_test {
+
+// the comma of the template arguments would split the arguments of the test macro
+template<std::size_t CAPACITY>
+using Queue = arabica::SpscQueue<int, CAPACITY>;
+
+} // namespace arabica_spsc_queue_test
+
+#define arabica_spsc_queue_test(test_case_name, test_case_body) \
+  TEST(spsc_queue_test_suite, test_case_name) {                 \
+    using namespace arabica_spsc_queue_test;                    \
+    test_case_body                                              \
+  }
+
+// clang-format off
+
+arabica_spsc_queue_test(test_pop_in_push_order,
+  Queue<8> queue;
+  int      value = 0;
+  ASSERT_TRUE(queue.is_empty());
+  ASSERT_FALSE(queue.pop(value));
+  for (int i = 1; i <= 3; ++i) {
+    ASSERT_TRUE(queue.push(i));
+  }
+  ASSERT_FALSE(queue.is_empty());
+  for (int i = 1; i <= 3; ++i) {
+    ASSERT_TRUE(queue.pop(value));
+    ASSERT_EQ(value, i);
+  }
+  ASSERT_TRUE(queue.is_empty());
+)
+
+arabica_spsc_queue_test(test_push_onto_a_full_queue_fails,
+  Queue<4> queue;
+  int      value = 0;
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(queue.push(i));
+  }
+  ASSERT_FALSE(queue.push(4));
+  ASSERT_TRUE(queue.pop(value));
+  ASSERT_EQ(value, 0);
+  ASSERT_TRUE(queue.push(4)); // wraps around the ring
+  for (int i = 1; i <= 4; ++i) {
+    ASSERT_TRUE(queue.pop(value));
+    ASSERT_EQ(value, i);
+  }
+)
+
+arabica_spsc_queue_test(test_every_value_crosses_threads_in_order,
+  // the producer retries on a full queue and the consumer on an empty one, it checks once both are done
+  constexpr int count = 100000;
+  Queue<64>     queue;
+  std::thread producer([&queue] {
+    for (int i = 1; i <= count; ++i) {
+      while (!queue.push(i)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  int  last        = 0;
+  bool is_in_order = true;
+  while (last < count) {
+    int value = 0;
+    if (!queue.pop(value)) {
+      std::this_thread::yield();
+      continue;
+    }
+    is_in_order = is_in_order && value == last + 1;
+    last        = value;
+  }
+  producer.join();
+  ASSERT_TRUE(is_in_order);
+  ASSERT_TRUE(queue.is_empty());
+)
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <arabica/thread/triple_buffer.hpp>
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace arabica_triple_buffer_test {
+
+// large enough for a torn copy to show, every word holds the same value
+struct Frame {
+  int words[256];
+};
+
+} // namespace arabica_triple_buffer_test
+
+#define arabica_triple_buffer_test(test_case_name, test_case_body) \
+  TEST(triple_buffer_test_suite, test_case_name) {                 \
+    using namespace arabica_triple_buffer_test;                    \
+    test_case_body                                                 \
+  }
+
+// clang-format off
+
+arabica_triple_buffer_test(test_acquire_takes_each_value_once,
+  arabica::TripleBuffer<int> buffer;
+  ASSERT_EQ(buffer.acquire(), nullptr);
+  buffer.back() = 42;
+  buffer.publish();
+  const int* const value = buffer.acquire();
+  ASSERT_NE(value, nullptr);
+  ASSERT_EQ(*value, 42);
+  ASSERT_EQ(buffer.front(), 42);
+  ASSERT_EQ(buffer.acquire(), nullptr);
+)
+
+arabica_triple_buffer_test(test_acquire_takes_the_latest_value,
+  arabica::TripleBuffer<int> buffer;
+  for (int i = 1; i <= 3; ++i) {
+    buffer.back() = i;
+    buffer.publish();
+  }
+  ASSERT_EQ(*buffer.acquire(), 3);
+)
+
+arabica_triple_buffer_test(test_publish_tells_if_the_value_before_was_seen,
+  arabica::TripleBuffer<int> buffer;
+  buffer.back() = 1;
+  ASSERT_TRUE(buffer.publish()); // nothing was published before
+  buffer.back() = 2;
+  ASSERT_FALSE(buffer.publish()); // 1 was never acquired
+  buffer.acquire();
+  buffer.back() = 3;
+  ASSERT_TRUE(buffer.publish());
+)
+
+arabica_triple_buffer_test(test_the_reader_never_sees_a_torn_value,
+  // the writer is checked once it has finished, an assert on the way would leave it running
+  constexpr int                 count = 20000;
+  arabica::TripleBuffer<Frame> buffer;
+  std::thread writer([&buffer] {
+    for (int i = 1; i <= count; ++i) {
+      for (int& word : buffer.back().words) {
+        word = i;
+      }
+      buffer.publish();
+    }
+  });
+  int  last        = 0;
+  bool is_in_order = true;
+  bool is_whole    = true;
+  while (last < count) {
+    const Frame* const frame = buffer.acquire();
+    if (frame == nullptr) {
+      std::this_thread::yield();
+      continue;
+    }
+    for (const int word : frame->words) {
+      is_whole = is_whole && word == frame->words[0];
+    }
+    is_in_order = is_in_order && frame->words[0] > last;
+    last        = frame->words[0];
+  }
+  writer.join();
+  ASSERT_TRUE(is_whole);
+  ASSERT_TRUE(is_in_order);
+)
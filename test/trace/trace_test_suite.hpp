@@ -0,0 +1,137 @@
+#pragma once
+
+#include <arabica/emulator/emulator.hpp>
+#include <arabica/trace/trace.hpp>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace arabica_trace_test {
+
+using arabica::trace::Event;
+using arabica::trace::Record;
+
+inline Record record(const Event event, const uint32_t a, const uint32_t b = 0, const uint32_t c = 0) {
+  return Record{{a, b, c}, static_cast<uint16_t>(event), 0};
+}
+
+inline std::size_t count(const std::vector<Record>& records, const Event event) {
+  std::size_t count = 0;
+  for (const Record& record : records) {
+    count += record.event == static_cast<uint16_t>(event);
+  }
+  return count;
+}
+
+} // namespace arabica_trace_test
+
+#define arabica_trace_test(test_case_name, test_case_body) \
+  TEST(trace_test_suite, test_case_name) {                 \
+    using namespace arabica_trace_test;                    \
+    std::vector<Record> records;                           \
+    arabica::trace::drain(records);                        \
+    records.clear();                                       \
+    test_case_body                                         \
+  }
+
+// clang-format off
+
+arabica_trace_test(test_format,
+  Record fetch = record(Event::FETCH, 0x204, 0xD115);
+  fetch.thread = 2;
+  ASSERT_EQ(arabica::trace::format(fetch), "[thread 2] [TRACE] pc 0x204 fetches 0xD115");
+  ASSERT_EQ(arabica::trace::format(record(Event::FRAME_IDLE, 7, 3, 8)),
+            "[thread 0] [INFO] frame 7 ran 3 of its 8 instructions in idle loops");
+)
+
+arabica_trace_test(test_full_ring_drops,
+  arabica::trace::Ring ring(0);
+  for (std::size_t i = 0; i < arabica::trace::Ring::CAPACITY + 3; ++i) {
+    ring.push(record(Event::FETCH, i));
+  }
+  ASSERT_EQ(ring.dropped(), 3);
+  ASSERT_EQ(ring.pop(records), arabica::trace::Ring::CAPACITY);
+  ASSERT_EQ(records.back().args[0], arabica::trace::Ring::CAPACITY - 1);
+  ASSERT_TRUE(ring.push(record(Event::FETCH, 0)));
+)
+
+arabica_trace_test(test_ring_between_threads,
+  // one thread pushes as fast as it can while this one pops, nothing is lost or reordered
+  constexpr uint32_t   total = 1 << 20;
+  arabica::trace::Ring ring(1);
+  std::thread          producer([&ring] {
+    for (uint32_t i = 0; i < total; ++i) {
+      while (!ring.push(record(Event::FETCH, i))) {
+      }
+    }
+  });
+  while (records.size() < total) {
+    ring.pop(records);
+  }
+  producer.join();
+  for (uint32_t i = 0; i < total; ++i) {
+    ASSERT_EQ(records[i].args[0], i);
+    ASSERT_EQ(records[i].thread, 1);
+  }
+)
+
+arabica_trace_test(test_emulator_logs_its_level,
+  // 0x200: unknown opcode, which leaves the pc where it is
+  arabica::Emulator emulator;
+  emulator.display.init();
+  emulator.memory.write(0x200, 0xF0);
+  emulator.memory.write(0x201, 0xFF);
+  emulator.single_step();
+  emulator.single_step();
+
+  // only the statements at or below the level built with leave anything
+  arabica::trace::drain(records);
+  ASSERT_EQ(count(records, Event::UNKNOWN), arabica::trace::is_enabled(Event::UNKNOWN) ? 2 : 0);
+  ASSERT_EQ(count(records, Event::FETCH), arabica::trace::is_enabled(Event::FETCH) ? 2 : 0);
+  ASSERT_EQ(count(records, Event::FRAME), 0);
+)
+
+arabica_trace_test(test_writer_round_trip,
+  const std::string path = (std::filesystem::temp_directory_path() / "arabica_trace_test.trace").string();
+  {
+    arabica::trace::Writer writer(path);
+    ASSERT_TRUE(writer.is_open());
+    std::thread([] {
+      arabica::trace::local_ring().push(record(Event::UNKNOWN, 0x0F0F, 0x200));
+    }).join();
+    arabica::trace::local_ring().push(record(Event::FRAME, 1, 0x300));
+  }
+  ASSERT_TRUE(arabica::trace::Writer::read(path, records));
+  std::filesystem::remove(path);
+
+  // one ring per thread, each record tagged with its own
+  ASSERT_EQ(records.size(), 2);
+  ASSERT_EQ(count(records, Event::UNKNOWN), 1);
+  ASSERT_EQ(count(records, Event::FRAME), 1);
+  ASSERT_NE(records[0].thread, records[1].thread);
+)
+
+arabica_trace_test(test_writer_counts_dropped_records,
+  const std::string path   = (std::filesystem::temp_directory_path() / "arabica_trace_dropped.trace").string();
+  const uint64_t    before = arabica::trace::dropped();
+  const std::size_t pushed = 4 * arabica::trace::Ring::CAPACITY;
+  {
+    arabica::trace::Writer writer(path);
+    ASSERT_TRUE(writer.is_open());
+    std::thread([pushed] {
+      for (std::size_t i = 0; i < pushed; ++i) {
+        arabica::trace::local_ring().push(record(Event::FRAME_IDLE, i));
+      }
+    }).join();
+  }
+  uint64_t dropped = 0;
+  ASSERT_TRUE(arabica::trace::Writer::read(path, records, &dropped));
+  std::filesystem::remove(path);
+
+  // whatever did not make it into the file is counted in its trailer
+  ASSERT_EQ(dropped, arabica::trace::dropped() - before);
+  ASSERT_EQ(count(records, Event::FRAME_IDLE) + dropped, pushed);
+)
@@ -0,0 +1,57 @@
+#include <arabica/aot/translator.hpp>
+#include <arabica/memory/memory.hpp>
+#include <fmt/core.h>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Ahead-of-time recompiler: translates a rom into C++ source. Linking the output into a program that
+// uses `arabica::Emulator` makes the emulator run the native blocks whenever that rom is loaded,
+// see `arabica_aot` in CMakeLists.txt.
+//
+// usage: ./arabica-aot.out rom-file [-o output-file]
+
+int main(int argc, char* argv[]) {
+  std::string rom;
+  std::string output;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "-o" && i + 1 < argc) {
+      output = argv[++i];
+    } else {
+      rom = arg;
+    }
+  }
+  if (rom.empty()) {
+    fmt::print("Usage: ./arabica-aot.out rom-file [-o output-file]\n");
+    return 1;
+  }
+
+  std::ifstream file(rom, std::ios::binary);
+  if (!file) {
+    fmt::print("Failed to open {}\n", rom);
+    return 1;
+  }
+  const std::vector<uint8_t> bytes{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+  if (bytes.empty() || bytes.size() > arabica::Memory::SIZE - arabica::Memory::RESERVED) {
+    fmt::print("{} is not a rom of 1 to {} bytes\n", rom, arabica::Memory::SIZE - arabica::Memory::RESERVED);
+    return 1;
+  }
+
+  const arabica::aot::Translator translator(bytes);
+  const std::string              source = translator.emit(std::filesystem::path(rom).filename().string());
+  if (output.empty()) {
+    fmt::print("{}", source);
+    return 0;
+  }
+
+  std::ofstream out(output, std::ios::binary);
+  out << source;
+  if (!out) {
+    fmt::print("Failed to write {}\n", output);
+    return 1;
+  }
+  return 0;
+}
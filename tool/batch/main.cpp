@@ -0,0 +1,278 @@
+#include <arabica/emulator/emulator.hpp>
+#include <arabica/thread/pool.hpp>
+#include <arabica/trace/trace.hpp>
+#include <fmt/core.h>
+#include <charconv>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Batch runner: runs many headless emulators on every core and streams one JSON line per job as
+// soon as it finishes, with the framebuffer hash, the final registers and the time it took.
+//
+// usage: ./arabica-batch.out [-j threads] [-f frames] [-s seed] [--profile report-file] [--trace trace-file]
+//                            [--record-rng stream-file | --replay-rng stream-file] (rom-file | --jobs job-file)...
+//
+// A job file has one job per line, `#` starts a comment:
+//
+//   rom-file frames [seed [input-file]]
+//
+// and an input file one key event per line, applied before the frame it names:
+//
+//   frame key(hex) down|up
+//
+// The seed drives RND, so a job with the same seed and inputs always gives the same results.
+//
+// `--profile` writes the execution profile of every job to `report-file`, in a build with
+// `ARABICA_PROFILER`. `--trace` writes what every job logs to `trace-file`, in a build with
+// `ARABICA_LOG_LEVEL`, `arabica-trace.out` prints it.
+//
+// `--record-rng` writes the bytes RND handed out in job n to `stream-file.n`, `--replay-rng` hands
+// them out again instead of the generator, e.g. to reproduce the jobs of another build.
+
+namespace {
+
+struct Input {
+  int  frame{0};
+  int  key{0};
+  bool is_pressed{false};
+};
+
+// where the RND bytes of the jobs are recorded to or replayed from, see `Random`
+struct Streams {
+  std::string record;
+  std::string replay;
+};
+
+struct Job {
+  std::string        rom;
+  int                frames{600};
+  uint64_t           seed{0};
+  std::vector<Input> inputs;
+};
+
+bool read_inputs(const std::string& path, std::vector<Input>& inputs) {
+  std::ifstream file(path);
+  if (!file) {
+    return false;
+  }
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream fields(line.substr(0, line.find('#')));
+    Input              input;
+    std::string        key;
+    std::string        state;
+    if (!(fields >> input.frame >> key >> state)) {
+      continue;
+    }
+    // one hex digit and down or up, anything else makes the whole file unreadable
+    const char* const last  = key.data() + key.size();
+    const auto        parse = std::from_chars(key.data(), last, input.key, 16);
+    if (parse.ec != std::errc() || parse.ptr != last || input.key < 0 || input.key > 0xF ||
+        (state != "down" && state != "up")) {
+      fmt::print(stderr, "Invalid input in {}: {}\n", path, line);
+      return false;
+    }
+    input.is_pressed = state == "down";
+    inputs.push_back(input);
+  }
+  return true;
+}
+
+bool read_jobs(const std::string& path, std::vector<Job>& jobs) {
+  std::ifstream file(path);
+  if (!file) {
+    return false;
+  }
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream fields(line.substr(0, line.find('#')));
+    Job                job;
+    std::string        input;
+    if (!(fields >> job.rom >> job.frames)) {
+      continue;
+    }
+    fields >> job.seed >> input;
+    if (!input.empty() && !read_inputs(input, job.inputs)) {
+      fmt::print(stderr, "Failed to read {}\n", input);
+      return false;
+    }
+    jobs.push_back(std::move(job));
+  }
+  return true;
+}
+
+// Paths go into the JSON through fmt's debug format, which quotes them and escapes quotes and backslashes.
+std::string error(const std::size_t index, const Job& job, const char* const message) {
+  return fmt::format(R"({{"job": {}, "rom": {:?}, "error": "{}"}})", index, job.rom, message);
+}
+
+// a whole decimal number from 1 up, 0 for anything else
+int positive(const char* const arg) {
+  char*      end   = nullptr;
+  const long value = std::strtol(arg, &end, 10);
+  return end != arg && *end == '\0' && value > 0 && value <= INT_MAX ? static_cast<int>(value) : 0;
+}
+
+std::string run(const std::size_t index, const Job& job, const Streams& streams, arabica::Profiler* const profiler) {
+  const auto start = std::chrono::steady_clock::now();
+
+  arabica::Emulator emulator;
+  emulator.display.init();
+  emulator.set_profiler(profiler);
+  emulator.random.seed(job.seed);
+  if (!streams.record.empty()) {
+    emulator.random.record();
+  } else if (!streams.replay.empty() && !emulator.random.load(fmt::format("{}.{}", streams.replay, index))) {
+    return error(index, job, "failed to read the random stream");
+  }
+  if (!emulator.load(job.rom)) {
+    return error(index, job, "failed to load");
+  }
+
+  std::size_t next = 0;
+  for (int frame = 0; frame < job.frames; ++frame) {
+    for (; next < job.inputs.size() && job.inputs[next].frame <= frame; ++next) {
+      const Input& input = job.inputs[next];
+      if (input.is_pressed) {
+        emulator.keypad.on_keydown(input.key);
+      } else {
+        emulator.keypad.on_keyup(input.key);
+      }
+    }
+    emulator.execute();
+  }
+  if (!streams.record.empty() && !emulator.random.save(fmt::format("{}.{}", streams.record, index))) {
+    return error(index, job, "failed to write the random stream");
+  }
+
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  const auto us      = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+
+  std::string registers;
+  for (int i = 0; i < arabica::CPU::REGISTER_COUNT; ++i) {
+    registers += fmt::format("{}{}", i == 0 ? "" : ", ", emulator.cpu.registers[i]);
+  }
+  return fmt::format(R"({{"job": {}, "rom": {:?}, "frames": {}, "seed": {}, "hash": "{:016x}", )"
+                     R"("pc": {}, "I": {}, "V": [{}], "microseconds": {}}})",
+                     index,
+                     job.rom,
+                     job.frames,
+                     job.seed,
+                     emulator.display.hash(),
+                     emulator.cpu.pc,
+                     emulator.cpu.reg_I,
+                     registers,
+                     us);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t      threads = std::thread::hardware_concurrency();
+  int              frames  = 600;
+  uint64_t         seed    = 0;
+  std::string      profile;
+  std::string      trace;
+  Streams          streams;
+  std::vector<Job> jobs;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "-j" && i + 1 < argc) {
+      threads = positive(argv[++i]);
+      if (threads == 0) {
+        fmt::print(stderr, "Invalid thread count {}\n", argv[i]);
+        return 1;
+      }
+    } else if (arg == "-f" && i + 1 < argc) {
+      frames = positive(argv[++i]);
+      if (frames == 0) {
+        fmt::print(stderr, "Invalid frame count {}\n", argv[i]);
+        return 1;
+      }
+    } else if (arg == "-s" && i + 1 < argc) {
+      seed = std::strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--profile" && i + 1 < argc) {
+      profile = argv[++i];
+    } else if (arg == "--trace" && i + 1 < argc) {
+      trace = argv[++i];
+    } else if (arg == "--record-rng" && i + 1 < argc) {
+      streams.record = argv[++i];
+    } else if (arg == "--replay-rng" && i + 1 < argc) {
+      streams.replay = argv[++i];
+    } else if (arg == "--jobs" && i + 1 < argc) {
+      if (!read_jobs(argv[++i], jobs)) {
+        fmt::print(stderr, "Failed to read {}\n", argv[i]);
+        return 1;
+      }
+    } else {
+      jobs.push_back(Job{arg, frames, seed, {}});
+    }
+  }
+  if (jobs.empty() || (!streams.record.empty() && !streams.replay.empty())) {
+    fmt::print("Usage: ./arabica-batch.out [-j threads] [-f frames] [-s seed] [--profile report-file] "
+               "[--trace trace-file]\n"
+               "                           [--record-rng stream-file | --replay-rng stream-file] "
+               "(rom-file | --jobs job-file)...\n");
+    return 1;
+  }
+
+  // one profiler per job, so that the jobs share nothing while they run
+  std::vector<std::unique_ptr<arabica::Profiler>> profilers;
+  if (!profile.empty()) {
+    if (!arabica::Profiler::IS_COMPILED_IN) {
+      fmt::print(stderr, "The profiler is compiled out, build with ARABICA_PROFILER=ON\n");
+    }
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+      profilers.push_back(std::make_unique<arabica::Profiler>());
+    }
+  }
+
+  // every worker logs to its own ring, the writer drains them all until the pool is done
+  std::unique_ptr<arabica::trace::Writer> writer;
+  if (!trace.empty()) {
+    if (arabica::trace::LEVEL == arabica::trace::Level::OFF) {
+      fmt::print(stderr, "Logging is compiled out, build with ARABICA_LOG_LEVEL\n");
+    }
+    writer = std::make_unique<arabica::trace::Writer>(trace);
+    if (!writer->is_open()) {
+      fmt::print(stderr, "Failed to write {}\n", trace);
+      return 1;
+    }
+  }
+
+  std::mutex output;
+  {
+    arabica::ThreadPool pool(threads);
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+      pool.submit([&, i] {
+        const std::string           result = run(i, jobs[i], streams, profilers.empty() ? nullptr : profilers[i].get());
+        std::lock_guard<std::mutex> lock(output);
+        fmt::print("{}\n", result);
+        std::fflush(stdout);
+      });
+    }
+    pool.wait();
+  }
+  writer.reset();
+
+  if (!profilers.empty()) {
+    std::ofstream file(profile);
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+      file << fmt::format("job {}: {}\n", i, jobs[i].rom) << profilers[i]->report() << "\n";
+    }
+    if (!file) {
+      fmt::print(stderr, "Failed to write {}\n", profile);
+      return 1;
+    }
+  }
+  return 0;
+}
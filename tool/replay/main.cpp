@@ -0,0 +1,126 @@
+#include <arabica/emulator/emulator.hpp>
+#include <arabica/emulator/movie.hpp>
+#include <fmt/core.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+// Movie replay: plays an input movie back headless and as fast as the host allows, then prints one
+// JSON line with the framebuffer hash, the final registers and the time it took. A recorded
+// session becomes a benchmark and a regression test: the same movie gives the same hash every time.
+//
+// usage: ./arabica-replay.out [-n repeat] [--profile report-file]
+//                             [--record-rng stream-file | --replay-rng stream-file] movie-file rom-file
+//
+// `--profile` writes the execution profile of all the runs to `report-file`, in a build with
+// `ARABICA_PROFILER`. `--record-rng` writes the bytes RND handed out to `stream-file`, `--replay-rng`
+// hands them out again instead of the generator seeded by the movie, e.g. to reproduce the run of
+// another build.
+
+namespace {
+
+// where the RND bytes are recorded to or replayed from, see `Random`
+struct Streams {
+  std::string record;
+  std::string replay;
+};
+
+// Paths go into the JSON through fmt's debug format, which quotes them and escapes quotes and backslashes.
+std::string error(const std::string& rom, const char* const message) {
+  return fmt::format(R"({{"rom": {:?}, "error": "{}"}})", rom, message);
+}
+
+std::string replay(const arabica::Movie&    movie,
+                   const std::string&       rom,
+                   const Streams&           streams,
+                   arabica::Profiler* const profiler) {
+  const auto start = std::chrono::steady_clock::now();
+
+  arabica::Emulator emulator;
+  emulator.display.init();
+  emulator.set_profiler(profiler);
+  if (!emulator.load(rom)) {
+    return error(rom, "failed to load");
+  }
+  arabica::MoviePlayer player(movie);
+  if (!player.start(emulator)) {
+    return error(rom, "not the rom the movie was recorded with");
+  }
+  if (!streams.record.empty()) {
+    emulator.random.record();
+  } else if (!streams.replay.empty() && !emulator.random.load(streams.replay)) {
+    return error(rom, "failed to read the random stream");
+  }
+  while (player.execute(emulator)) {
+  }
+  if (!streams.record.empty() && !emulator.random.save(streams.record)) {
+    return error(rom, "failed to write the random stream");
+  }
+
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  const auto us      = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+
+  std::string registers;
+  for (int i = 0; i < arabica::CPU::REGISTER_COUNT; ++i) {
+    registers += fmt::format("{}{}", i == 0 ? "" : ", ", emulator.cpu.registers[i]);
+  }
+  return fmt::format(R"({{"rom": {:?}, "frames": {}, "events": {}, "hash": "{:016x}", )"
+                     R"("pc": {}, "I": {}, "V": [{}], "microseconds": {}}})",
+                     rom,
+                     movie.frames,
+                     movie.events.size(),
+                     emulator.display.hash(),
+                     emulator.cpu.pc,
+                     emulator.cpu.reg_I,
+                     registers,
+                     us);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  int         repeat = 1;
+  std::string profile;
+  Streams     streams;
+  std::string paths[2];
+  int         count  = 0;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "-n" && i + 1 < argc) {
+      repeat = std::max(1, std::atoi(argv[++i]));
+    } else if (arg == "--profile" && i + 1 < argc) {
+      profile = argv[++i];
+    } else if (arg == "--record-rng" && i + 1 < argc) {
+      streams.record = argv[++i];
+    } else if (arg == "--replay-rng" && i + 1 < argc) {
+      streams.replay = argv[++i];
+    } else if (count < 2) {
+      paths[count++] = arg;
+    }
+  }
+  if (count < 2 || (!streams.record.empty() && !streams.replay.empty())) {
+    fmt::print("Usage: ./arabica-replay.out [-n repeat] [--profile report-file]\n"
+               "                            [--record-rng stream-file | --replay-rng stream-file] "
+               "movie-file rom-file\n");
+    return 1;
+  }
+
+  arabica::Movie movie;
+  if (!movie.load(paths[0])) {
+    fmt::print(stderr, "Failed to read {}\n", paths[0]);
+    return 1;
+  }
+  arabica::Profiler profiler;
+  if (!profile.empty() && !arabica::Profiler::IS_COMPILED_IN) {
+    fmt::print(stderr, "The profiler is compiled out, build with ARABICA_PROFILER=ON\n");
+  }
+  for (int i = 0; i < repeat; ++i) {
+    fmt::print("{}\n", replay(movie, paths[1], streams, profile.empty() ? nullptr : &profiler));
+  }
+  if (!profile.empty() && !profiler.save(profile)) {
+    fmt::print(stderr, "Failed to write {}\n", profile);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,126 @@
+#include <arabica/cpu/control_flow.hpp>
+#include <arabica/cpu/fusion.hpp>
+#include <arabica/memory/memory.hpp>
+#include <fmt/core.h>
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Corpus scan: counts the op code n-grams of every reachable instruction sequence in a set of roms,
+// to find out which sequences are worth a superinstruction.
+//
+// usage: ./arabica-scan.out [-n max-length] [-k top-count] [rom-file | rom-directory]...
+
+namespace {
+
+struct Options {
+  int                      max_length{3};
+  int                      top_count{20};
+  std::vector<std::string> paths;
+};
+
+Options parse(const int argc, char* argv[]) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "-n" && i + 1 < argc) {
+      options.max_length = std::max(2, std::atoi(argv[++i]));
+    } else if (arg == "-k" && i + 1 < argc) {
+      options.top_count = std::max(1, std::atoi(argv[++i]));
+    } else {
+      options.paths.push_back(arg);
+    }
+  }
+  if (options.paths.empty()) {
+    options.paths.push_back("rom");
+  }
+  return options;
+}
+
+std::vector<std::string> collect(const std::vector<std::string>& paths) {
+  std::vector<std::string> roms;
+  for (const auto& path : paths) {
+    if (std::filesystem::is_directory(path)) {
+      for (const auto& entry : std::filesystem::recursive_directory_iterator(path)) {
+        const auto extension = entry.path().extension();
+        if (entry.is_regular_file() && (extension == ".ch8" || extension == ".c8")) {
+          roms.push_back(entry.path().string());
+        }
+      }
+    } else {
+      roms.push_back(path);
+    }
+  }
+  std::sort(roms.begin(), roms.end());
+  return roms;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  const Options options = parse(argc, argv);
+  const auto    roms    = collect(options.paths);
+  if (roms.empty()) {
+    fmt::print("No rom found\n");
+    return 1;
+  }
+
+  std::vector<std::map<std::string, int>> ngrams(options.max_length + 1);
+  std::vector<int>                        totals(options.max_length + 1, 0);
+  int                                     instructions = 0;
+  int                                     fused        = 0;
+
+  for (const auto& rom : roms) {
+    arabica::Memory memory;
+    if (!memory.load(rom)) {
+      fmt::print("Failed to load {}\n", rom);
+      continue;
+    }
+
+    // straight from the cells, the observers of memory have no business with a scan; past the end reads
+    // as 0, which nothing fuses with
+    const arabica::ControlFlow            flow(memory);
+    const arabica::Memory::value_t* const cells = memory.data();
+    const auto                            word  = [cells](const uint32_t address) -> uint16_t {
+      return address + 1 < arabica::Memory::SIZE ? cells[address] << 8 | cells[address + 1] : 0;
+    };
+
+    for (const auto address : flow.addresses()) {
+      ++instructions;
+      if (arabica::fuse(word(address), word(address + 2), word(address + 4)).kind != arabica::FUSION::NONE) {
+        ++fused;
+      }
+
+      std::string sequence = arabica::op_code_name(arabica::decode(word(address)).opcode);
+      for (int length = 2; length <= options.max_length; ++length) {
+        const uint16_t next = address + 2 * (length - 1);
+        if (!flow.is_reachable(next)) {
+          break;
+        }
+        sequence += " ";
+        sequence += arabica::op_code_name(arabica::decode(word(next)).opcode);
+        ngrams[length][sequence]++;
+        totals[length]++;
+      }
+    }
+  }
+
+  fmt::print("{} roms, {} reachable instructions, {} start a fused sequence\n", roms.size(), instructions, fused);
+  for (int length = 2; length <= options.max_length; ++length) {
+    std::vector<std::pair<std::string, int>> ranking(ngrams[length].begin(), ngrams[length].end());
+    std::sort(ranking.begin(), ranking.end(), [](const auto& lhs, const auto& rhs) {
+      return lhs.second != rhs.second ? lhs.second > rhs.second : lhs.first < rhs.first;
+    });
+
+    fmt::print("\n{}-grams ({} in total)\n", length, totals[length]);
+    for (int i = 0; i < std::min<int>(options.top_count, ranking.size()); ++i) {
+      const auto& [sequence, count] = ranking[i];
+      fmt::print("{:>4} {:>8} {:>6.2f}%  {}\n", i + 1, count, 100.0 * count / totals[length], sequence);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,44 @@
+#include <arabica/trace/trace.hpp>
+#include <fmt/core.h>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Trace printer: formats a binary trace written with `--trace` by `arabica.out` or `arabica-batch.out`,
+// one line per record, in the order each thread logged them.
+//
+// usage: ./arabica-trace.out [-t thread] trace-file
+//
+// `-t` only prints the records of one thread. Records dropped on full rings are counted on stderr.
+int main(int argc, char* argv[]) {
+  std::string path;
+  int         thread = -1;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "-t" && i + 1 < argc) {
+      thread = std::atoi(argv[++i]);
+    } else {
+      path = arg;
+    }
+  }
+  if (path.empty()) {
+    fmt::print("Usage: ./arabica-trace.out [-t thread] trace-file\n");
+    return 1;
+  }
+
+  std::vector<arabica::trace::Record> records;
+  uint64_t                            dropped = 0;
+  if (!arabica::trace::Writer::read(path, records, &dropped)) {
+    fmt::print(stderr, "Failed to read {}\n", path);
+    return 1;
+  }
+  for (const arabica::trace::Record& record : records) {
+    if (thread < 0 || record.thread == thread) {
+      fmt::print("{}\n", arabica::trace::format(record));
+    }
+  }
+  if (dropped > 0) {
+    fmt::print(stderr, "{} records were dropped on full rings, the trace is incomplete\n", dropped);
+  }
+  return 0;
+}